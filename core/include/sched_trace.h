@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_sched_trace Scheduler tracing
+ * @ingroup     core
+ * @brief       Context switch tracing and per-thread latency statistics
+ *
+ * With the `sched_trace` module, the scheduler records every context switch
+ * into a fixed size ring buffer that is overwritten when full. Additionally,
+ * it keeps for every thread
+ *
+ * - a histogram of how long the thread ran before it was switched out, and
+ * - the worst case wakeup latency, i.e. the longest time the thread spent on
+ *   a runqueue before it was scheduled.
+ *
+ * All times are in xtimer ticks. Recording only writes to the ring buffer
+ * and never waits for a reader: readers copy the entries and discard those
+ * that were overwritten meanwhile.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler tracing API
+ */
+
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SCHED_TRACE_SIZE
+/**
+ * @brief   Number of context switches kept in the ring buffer
+ *
+ * @note    Must be a power of two
+ */
+#define SCHED_TRACE_SIZE        (32U)
+#endif
+
+#ifndef SCHED_TRACE_HIST_BUCKETS
+/**
+ * @brief   Number of run length histogram buckets per thread
+ *
+ * Bucket i counts run lengths from 4^i to 4^(i + 1) - 1 ticks, the last
+ * bucket also counts all longer run lengths.
+ */
+#define SCHED_TRACE_HIST_BUCKETS    (8U)
+#endif
+
+/**
+ * @brief   Traced context switch
+ */
+typedef struct {
+    uint32_t time;          /**< time of the switch in ticks */
+    kernel_pid_t from;      /**< thread switched out, KERNEL_PID_UNDEF if
+                                 none */
+    kernel_pid_t to;        /**< thread switched in */
+    uint8_t reason;         /**< status of sched_trace_entry_t::from after
+                                 the switch, e.g. STATUS_PENDING if it was
+                                 preempted */
+} sched_trace_entry_t;
+
+/**
+ * @brief   Per-thread tracing statistics
+ */
+typedef struct {
+    uint32_t ready_since;   /**< time the thread was put on a runqueue */
+    uint32_t max_latency;   /**< worst case time from being put on a
+                                 runqueue to being scheduled */
+    uint16_t hist[SCHED_TRACE_HIST_BUCKETS];    /**< run length histogram,
+                                                     saturating */
+} sched_trace_stat_t;
+
+/**
+ * @brief   Tracing statistics of all threads
+ */
+extern sched_trace_stat_t sched_trace_stats[KERNEL_PID_LAST + 1];
+
+/**
+ * @brief   Record a context switch
+ *
+ * Called by the scheduler only.
+ *
+ * @param[in] from      thread switched out, may be NULL
+ * @param[in] to        thread switched in
+ */
+void sched_trace_switch(thread_t *from, thread_t *to);
+
+/**
+ * @brief   Record a thread being put on a runqueue
+ *
+ * Called by the scheduler only.
+ *
+ * @param[in] pid       the thread
+ */
+void sched_trace_ready(kernel_pid_t pid);
+
+/**
+ * @brief   Copy the most recent context switches
+ *
+ * May be called from any context, while context switches are recorded.
+ *
+ * @param[out] entries  storage for the context switches, oldest first
+ * @param[in] max       number of entries @p entries can hold
+ *
+ * @return  number of context switches copied
+ */
+unsigned sched_trace_read(sched_trace_entry_t *entries, unsigned max);
+
+/**
+ * @brief   Reset all statistics and the ring buffer
+ */
+void sched_trace_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_TRACE_H */
+/** @} */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_spsc_chan Single-producer/single-consumer channels
+ * @ingroup     core
+ * @brief       Lock-free message channel from one producer to one thread
+ *
+ * A channel is a @ref cib_t based queue of @ref msg_t owned by exactly one
+ * reading thread. Exactly one producer (usually an ISR) may put messages
+ * into it. Neither side disables interrupts to access the queue: the
+ * producer only ever advances the write counter, the reader only ever
+ * advances the read counter.
+ *
+ * The reader is woken up with a thread flag of its choice. The flag is only
+ * set when the producer finds the channel drained by the reader, so a
+ * reader that does not keep up is not woken up for every message and a
+ * batch put with spsc_chan_put_many() wakes it up at most once.
+ *
+ * @note    Both counters are only synchronized against each other with
+ *          compiler barriers. This is sufficient for a producer and a
+ *          reader that run on the same core, e.g. an ISR and a thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Single-producer/single-consumer channel API
+ */
+
+#ifndef SPSC_CHAN_H
+#define SPSC_CHAN_H
+
+#include "cib.h"
+#include "msg.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Channel struct definition
+ */
+typedef struct {
+    cib_t cib;              /**< cib for msg array                      */
+    msg_t *msg_array;       /**< ptr to array of msg queue              */
+    thread_t *reader;       /**< the only thread reading the channel    */
+    thread_flags_t flag;    /**< flag to wake up spsc_chan_t::reader    */
+} spsc_chan_t;
+
+/**
+ * @brief Initialize channel object for the calling thread
+ *
+ * @note The message queue size must be a power of two!
+ *
+ * @param[in]   chan        ptr to channel to initialize
+ * @param[in]   queue       array of msg_t used as queue
+ * @param[in]   queue_size  number of msg_t objects in queue
+ * @param[in]   flag        thread flag used to wake up the calling thread,
+ *                          must not be one of the reserved thread flags
+ */
+void spsc_chan_init(spsc_chan_t *chan, msg_t *queue, unsigned int queue_size,
+                    thread_flags_t flag);
+
+/**
+ * @brief Add message to channel
+ *
+ * Must only be called by the single producer of @p chan. If the channel is
+ * full, this function will return right away.
+ *
+ * @param[in] chan  ptr to channel to operate on
+ * @param[in] msg   ptr to message that will be copied into channel
+ *
+ * @return  1   if msg could be delivered
+ * @return  0   otherwise
+ */
+int spsc_chan_put(spsc_chan_t *chan, const msg_t *msg);
+
+/**
+ * @brief Add several messages to channel at once
+ *
+ * Must only be called by the single producer of @p chan. The reader is
+ * woken up at most once for all messages.
+ *
+ * @param[in] chan  ptr to channel to operate on
+ * @param[in] msgs  array of messages that will be copied into channel
+ * @param[in] num   number of messages in @p msgs
+ *
+ * @return  number of messages delivered, less than @p num if the channel
+ *          is full
+ */
+unsigned spsc_chan_put_many(spsc_chan_t *chan, const msg_t *msgs,
+                            unsigned num);
+
+/**
+ * @brief Get message from channel
+ *
+ * Must only be called by the reading thread of @p chan. If the channel is
+ * empty, this function will return right away.
+ *
+ * @param[in] chan  ptr to channel to operate on
+ * @param[out] msg  ptr to storage for retrieved message
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   otherwise
+ */
+int spsc_chan_try_get(spsc_chan_t *chan, msg_t *msg);
+
+/**
+ * @brief Get several messages from channel at once
+ *
+ * Must only be called by the reading thread of @p chan. If the channel is
+ * empty, this function will return right away.
+ *
+ * @param[in] chan  ptr to channel to operate on
+ * @param[out] msgs storage for retrieved messages
+ * @param[in] num   maximum number of messages to retrieve
+ *
+ * @return  number of messages retrieved
+ */
+unsigned spsc_chan_get_many(spsc_chan_t *chan, msg_t *msgs, unsigned num);
+
+/**
+ * @brief Get message from channel
+ *
+ * Must only be called by the reading thread of @p chan. If the channel is
+ * empty, this function will block until a message becomes available.
+ *
+ * @param[in] chan  ptr to channel to operate on
+ * @param[out] msg  ptr to storage for retrieved message
+ */
+void spsc_chan_get(spsc_chan_t *chan, msg_t *msg);
+
+/**
+ * @brief Get number of messages available in channel
+ *
+ * @param[in] chan  ptr to channel to operate on
+ *
+ * @return  number of messages in channel
+ */
+static inline unsigned spsc_chan_avail(spsc_chan_t *chan)
+{
+    return cib_avail(&chan->cib);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSC_CHAN_H */
+/** @} */
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_sched_trace
+ * @{
+ *
+ * @file
+ * @brief       Scheduler tracing implementation
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "irq.h"
+#include "sched_trace.h"
+
+#ifdef MODULE_SCHED_TRACE
+#include "xtimer.h"
+
+#if (SCHED_TRACE_SIZE & (SCHED_TRACE_SIZE - 1))
+#error "SCHED_TRACE_SIZE must be a power of two"
+#endif
+
+sched_trace_stat_t sched_trace_stats[KERNEL_PID_LAST + 1];
+
+static sched_trace_entry_t _ring[SCHED_TRACE_SIZE];
+/* number of context switches recorded so far, wraps around */
+static volatile unsigned _count;
+/* time of the last context switch, i.e. when the active thread started */
+static uint32_t _last_switch;
+
+static unsigned _bucket(uint32_t ticks)
+{
+    unsigned bucket = 0;
+
+    while ((ticks >>= 2) && (bucket < (SCHED_TRACE_HIST_BUCKETS - 1))) {
+        bucket++;
+    }
+    return bucket;
+}
+
+void sched_trace_switch(thread_t *from, thread_t *to)
+{
+    uint32_t now = _xtimer_now();
+    unsigned idx = _count;
+    sched_trace_entry_t *entry = &_ring[idx & (SCHED_TRACE_SIZE - 1)];
+
+    entry->time = now;
+    entry->to = to->pid;
+    if (from) {
+        sched_trace_stat_t *stat = &sched_trace_stats[from->pid];
+        uint16_t *cnt = &stat->hist[_bucket(now - _last_switch)];
+
+        if (*cnt < UINT16_MAX) {
+            (*cnt)++;
+        }
+        /* a preempted thread waits on its runqueue from now on */
+        if (from->status >= STATUS_ON_RUNQUEUE) {
+            stat->ready_since = now;
+        }
+        entry->from = from->pid;
+        entry->reason = from->status;
+    }
+    else {
+        entry->from = KERNEL_PID_UNDEF;
+        entry->reason = STATUS_STOPPED;
+    }
+    atomic_signal_fence(memory_order_release);
+    _count = idx + 1;
+
+    sched_trace_stat_t *stat = &sched_trace_stats[to->pid];
+    if ((now - stat->ready_since) > stat->max_latency) {
+        stat->max_latency = now - stat->ready_since;
+    }
+    _last_switch = now;
+}
+
+void sched_trace_ready(kernel_pid_t pid)
+{
+    sched_trace_stats[pid].ready_since = _xtimer_now();
+}
+
+unsigned sched_trace_read(sched_trace_entry_t *entries, unsigned max)
+{
+    unsigned end = _count;
+    unsigned num = (end < SCHED_TRACE_SIZE) ? end : SCHED_TRACE_SIZE;
+
+    if (num > max) {
+        num = max;
+    }
+
+    atomic_signal_fence(memory_order_acquire);
+    for (unsigned i = 0; i < num; i++) {
+        entries[i] = _ring[(end - num + i) & (SCHED_TRACE_SIZE - 1)];
+    }
+    atomic_signal_fence(memory_order_acquire);
+
+    /* drop the oldest entries if the scheduler overwrote them meanwhile,
+     * including the one it might have been writing to */
+    unsigned written = (_count - end) + 1;
+    if (num + written > SCHED_TRACE_SIZE) {
+        unsigned lost = num + written - SCHED_TRACE_SIZE;
+        if (lost >= num) {
+            return 0;
+        }
+        num -= lost;
+        memmove(entries, &entries[lost], num * sizeof(sched_trace_entry_t));
+    }
+    return num;
+}
+
+void sched_trace_reset(void)
+{
+    unsigned state = irq_disable();
+
+    /* keep sched_trace_stat_t::ready_since of threads waiting right now */
+    for (unsigned i = 0; i <= KERNEL_PID_LAST; i++) {
+        sched_trace_stats[i].max_latency = 0;
+        memset(sched_trace_stats[i].hist, 0, sizeof(sched_trace_stats[i].hist));
+    }
+    _count = 0;
+    irq_restore(state);
+}
+
+#endif /* MODULE_SCHED_TRACE */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_spsc_chan
+ * @{
+ *
+ * @file
+ * @brief       single-producer/single-consumer channel implementation
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+
+#include "assert.h"
+#include "sched.h"
+#include "spsc_chan.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifdef MODULE_CORE_SPSC_CHAN
+
+void spsc_chan_init(spsc_chan_t *chan, msg_t *queue, unsigned int queue_size,
+                    thread_flags_t flag)
+{
+    cib_init(&chan->cib, queue_size);
+    chan->msg_array = queue;
+    chan->reader = (thread_t *)sched_active_thread;
+    chan->flag = flag;
+}
+
+unsigned spsc_chan_put_many(spsc_chan_t *chan, const msg_t *msgs,
+                            unsigned num)
+{
+    cib_t *cib = &chan->cib;
+    unsigned space = (cib->mask + 1) - cib_avail(cib);
+
+    if (num > space) {
+        num = space;
+    }
+    if (num == 0) {
+        return 0;
+    }
+
+    for (unsigned i = 0; i < num; i++) {
+        chan->msg_array[(cib->write_count + i) & cib->mask] = msgs[i];
+    }
+    /* publish the messages only after they were copied */
+    atomic_signal_fence(memory_order_release);
+    cib->write_count += num;
+    atomic_signal_fence(memory_order_seq_cst);
+
+    /* if only our messages are pending, the reader may have drained the
+     * channel and be waiting for the flag. Otherwise it still has older
+     * messages to read and will find ours when it reads again. */
+    if (cib_avail(cib) == num) {
+        DEBUG("spsc_chan: waking up %" PRIkernel_pid "\n", chan->reader->pid);
+        thread_flags_set(chan->reader, chan->flag);
+    }
+
+    return num;
+}
+
+int spsc_chan_put(spsc_chan_t *chan, const msg_t *msg)
+{
+    return spsc_chan_put_many(chan, msg, 1);
+}
+
+unsigned spsc_chan_get_many(spsc_chan_t *chan, msg_t *msgs, unsigned num)
+{
+    cib_t *cib = &chan->cib;
+
+    atomic_signal_fence(memory_order_acquire);
+    unsigned avail = cib_avail(cib);
+
+    if (num > avail) {
+        num = avail;
+    }
+
+    for (unsigned i = 0; i < num; i++) {
+        msgs[i] = chan->msg_array[(cib->read_count + i) & cib->mask];
+    }
+    /* free the slots only after they were copied */
+    atomic_signal_fence(memory_order_release);
+    cib->read_count += num;
+    atomic_signal_fence(memory_order_seq_cst);
+
+    return num;
+}
+
+int spsc_chan_try_get(spsc_chan_t *chan, msg_t *msg)
+{
+    return spsc_chan_get_many(chan, msg, 1);
+}
+
+void spsc_chan_get(spsc_chan_t *chan, msg_t *msg)
+{
+    assert(chan->reader == sched_active_thread);
+
+    while (!spsc_chan_try_get(chan, msg)) {
+        thread_flags_wait_any(chan->flag);
+    }
+}
+
+#endif /* MODULE_CORE_SPSC_CHAN */
@@ -27,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +36,18 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+#if defined(MODULE_NETDEV_TAP_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Maximum number of frames drained from the host per interrupt
+ *
+ * @note    Only available with the `netdev_tap_batch` module. Every slot
+ *          holds a full Ethernet frame.
+ */
+#ifndef NETDEV_TAP_BATCH_SIZE
+#define NETDEV_TAP_BATCH_SIZE   (8U)
+#endif
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +57,16 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+#if defined(MODULE_NETDEV_TAP_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief   ring of frames read from the host but not yet fetched by
+     *          the upper layer
+     */
+    uint8_t rx_buf[NETDEV_TAP_BATCH_SIZE][ETHERNET_FRAME_LEN];
+    uint16_t rx_len[NETDEV_TAP_BATCH_SIZE]; /**< lengths of frames in rx_buf */
+    uint8_t rx_head;                    /**< oldest frame in rx_buf */
+    uint8_t rx_num;                     /**< number of frames in rx_buf */
+#endif
 } netdev_tap_t;
 
 /**
@@ -64,6 +64,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static void _isr(netdev_t *netdev);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -90,18 +91,6 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
-static inline void _isr(netdev_t *netdev)
-{
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
-#if DEVELHELP
-    else {
-        puts("netdev_tap: _isr(): no event_callback set.");
-    }
-#endif
-}
-
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
 {
     int res = 0;
@@ -170,6 +159,20 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
+static inline bool _is_for_me(netdev_tap_t *dev, ethernet_hdr_t *hdr)
+{
+    if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
+        !_is_addr_broadcast(hdr->dst) &&
+        (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+              "That's not me => Dropped\n",
+              hdr->dst[0], hdr->dst[1], hdr->dst[2],
+              hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+        return false;
+    }
+    return true;
+}
+
 static void _continue_reading(netdev_tap_t *dev)
 {
     /* work around lost signals */
@@ -197,6 +200,137 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+#ifdef MODULE_NETDEV_TAP_BATCH
+static inline void _pop(netdev_tap_t *dev)
+{
+    dev->rx_head = (dev->rx_head + 1) % NETDEV_TAP_BATCH_SIZE;
+    dev->rx_num--;
+}
+
+/**
+ * @brief   reads frames from the host into the ring until the host has no
+ *          more frames pending or the ring is full
+ *
+ * @return  number of frames added to the ring
+ */
+static unsigned _drain(netdev_tap_t *dev)
+{
+    unsigned num = 0;
+
+    while (dev->rx_num < NETDEV_TAP_BATCH_SIZE) {
+        unsigned slot = (dev->rx_head + dev->rx_num) % NETDEV_TAP_BATCH_SIZE;
+        int nread = real_read(dev->tap_fd, dev->rx_buf[slot],
+                              ETHERNET_FRAME_LEN);
+
+        if (nread == -1) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev_tap: read");
+            }
+            break;
+        }
+        else if (nread == 0) {
+            DEBUG("netdev_tap: ignoring null-event\n");
+            break;
+        }
+        DEBUG("netdev_tap: read %d bytes\n", nread);
+
+        if ((nread < (int)sizeof(ethernet_hdr_t)) ||
+            !_is_for_me(dev, (ethernet_hdr_t *)dev->rx_buf[slot])) {
+            continue;
+        }
+        dev->rx_len[slot] = nread;
+        dev->rx_num++;
+        num++;
+    }
+
+    return num;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    unsigned num = _drain(dev);
+
+    /* hand the whole batch to the upper layer within this single event */
+    while (dev->rx_num > 0) {
+        unsigned pending = dev->rx_num;
+
+        if (netdev->event_callback) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        }
+#if DEVELHELP
+        else {
+            puts("netdev_tap: _isr(): no event_callback set.");
+        }
+#endif
+        if (dev->rx_num == pending) {
+            /* frame was not fetched, drop it so the ring does not stall */
+            _pop(dev);
+        }
+    }
+
+#ifdef MODULE_NETSTATS_L2
+    if (num > 0) {
+        netdev->stats.rx_batch_count++;
+        if (num > netdev->stats.rx_batch_max) {
+            netdev->stats.rx_batch_max = num;
+        }
+    }
+#else
+    (void)num;
+#endif
+
+    /* a full ring may have left frames behind, check once per batch */
+    _continue_reading(dev);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
+
+    if (dev->rx_num == 0) {
+        return 0;
+    }
+
+    size_t size = dev->rx_len[dev->rx_head];
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev_tap: discarding the frame\n");
+            _pop(dev);
+        }
+
+        /* the frame is already buffered, so its exact size is known */
+        return size;
+    }
+
+    if (size > len) {
+        size = len;
+    }
+    memcpy(buf, dev->rx_buf[dev->rx_head], size);
+    _pop(dev);
+
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += size;
+#endif
+    return size;
+}
+#else
+static void _isr(netdev_t *netdev)
+{
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    }
+#if DEVELHELP
+    else {
+        puts("netdev_tap: _isr(): no event_callback set.");
+    }
+#endif
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -231,15 +365,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
     if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
+        if (!_is_for_me(dev, (ethernet_hdr_t *)buf)) {
             native_async_read_continue(dev->tap_fd);
 
             return 0;
@@ -269,6 +395,7 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
     return -1;
 }
+#endif /* MODULE_NETDEV_TAP_BATCH */
 
 static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n)
 {
@@ -330,6 +457,10 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+#ifdef MODULE_NETDEV_TAP_BATCH
+    dev->rx_head = 0;
+    dev->rx_num = 0;
+#endif
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
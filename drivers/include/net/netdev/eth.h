@@ -28,6 +28,22 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Flag for netdev_eth_rx_info_t::flags: the UDP, TCP or ICMPv6
+ *          checksum of the frame was verified by the device and is valid
+ */
+#define NETDEV_ETH_RX_INFO_CSUM_VALID   (0x01)
+
+/**
+ * @brief   Received frame information for ethernet devices
+ *
+ * Passed as `info` to netdev_driver_t::recv() by @ref net_gnrc_netdev.
+ * Drivers that do not support it leave it untouched.
+ */
+typedef struct {
+    uint8_t flags;      /**< flags, see NETDEV_ETH_RX_INFO_CSUM_VALID */
+} netdev_eth_rx_info_t;
+
 /**
  * @brief   Fallback function for netdev ethernet devices' _get function
  *
@@ -66,22 +66,15 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
                                0)) ? -ENOTCONN : 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+static int _recv(sock_udp_t *sock, struct netbuf **buf_out,
+                 uint32_t timeout, sock_udp_ep_t *remote)
 {
-    uint8_t *data_ptr = data;
     struct netbuf *buf;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if ((res = lwip_sock_recv(sock->conn, timeout, &buf)) < 0) {
         return res;
     }
-    res = buf->p->tot_len;
-    if ((unsigned)res > max_len) {
-        netbuf_delete(buf);
-        return -ENOBUFS;
-    }
     if (remote != NULL) {
         /* convert remote */
         size_t addr_len;
@@ -111,6 +104,26 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         memcpy(&remote->addr, &buf->addr, addr_len);
         remote->port = buf->port;
     }
+    *buf_out = buf;
+    return 0;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    uint8_t *data_ptr = data;
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    if ((res = _recv(sock, &buf, timeout, remote)) < 0) {
+        return res;
+    }
+    res = buf->p->tot_len;
+    if ((unsigned)res > max_len) {
+        netbuf_delete(buf);
+        return -ENOBUFS;
+    }
     /* copy data */
     for (struct pbuf *q = buf->p; q != NULL; q = q->next) {
         memcpy(data_ptr, q->payload, q->len);
@@ -120,6 +133,54 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     return (ssize_t)res;
 }
 
+ssize_t sock_udp_recv_many(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                           unsigned num, uint32_t timeout)
+{
+    unsigned i;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    for (i = 0; i < num; i++) {
+        /* only wait for the first message */
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].len,
+                                    (i == 0) ? timeout : 0, msgs[i].remote);
+
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+        msgs[i].len = (size_t)res;
+    }
+    return (ssize_t)i;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    struct netbuf *buf;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if ((res = _recv(sock, &buf, timeout, remote)) < 0) {
+        return res;
+    }
+    if (buf->p->next != NULL) {
+        /* data is spread over a pbuf chain */
+        netbuf_delete(buf);
+        return -ENOBUFS;
+    }
+    *data = buf->p->payload;
+    *buf_ctx = buf;
+    return (ssize_t)buf->p->len;
+}
+
+void sock_udp_recv_buf_free(void *buf_ctx)
+{
+    assert(buf_ctx != NULL);
+    netbuf_delete(buf_ctx);
+}
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
@@ -133,4 +194,24 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                           NETCONN_UDP);
 }
 
+ssize_t sock_udp_send_many(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                           unsigned num)
+{
+    unsigned i;
+
+    assert(msgs != NULL);
+    for (i = 0; i < num; i++) {
+        ssize_t res = sock_udp_send(sock, msgs[i].data, msgs[i].len,
+                                    msgs[i].remote);
+
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+    }
+    return (ssize_t)i;
+}
+
 /** @} */
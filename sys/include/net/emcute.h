@@ -40,6 +40,20 @@
  *   nodes.
  *
  *
+ * # Asynchronous Operation
+ * Each of the functions above sends a message and blocks the calling thread
+ * until it was acknowledged, so only one message is in flight at a time. With
+ * the `emcute_async` pseudomodule, emcute_pub_async() and emcute_reg_async()
+ * return as soon as the message was sent and report the result to a callback
+ * instead. Up to @ref EMCUTE_ASYNC_WINDOW of these messages can wait for their
+ * acknowledgment at the same time, further calls block until one of them
+ * completed. emcute_reg_batch() uses this to register a number of topics at
+ * once.
+ *
+ * The callbacks are called from emCute's thread, so they **must not** call any
+ * function of emCute that waits for the gateway.
+ *
+ *
  * # Error Handling
  * This implementation tries minimize parameter checks to a minimum, checking as
  * many parameters as feasible using assertions. For the sake of run-time
@@ -59,6 +73,8 @@
  * - updating will message
  * - sending out periodic PINGREQ messages
  * - handling re-transmits
+ * - publishing and registering topics without waiting for each
+ *   acknowledgment (`emcute_async`)
  *
  * The following features are however still missing (but planned):
  * @todo        Gateway discovery (so far there is no support for handling
@@ -161,6 +177,24 @@ extern "C" {
 #define EMCUTE_N_RETRY          (3U)
 #endif
 
+#ifndef EMCUTE_ASYNC_WINDOW
+/**
+ * @brief   Maximum number of asynchronous messages waiting for their
+ *          acknowledgment
+ */
+#define EMCUTE_ASYNC_WINDOW     (4U)
+#endif
+
+#ifndef EMCUTE_ASYNC_BUFSIZE
+/**
+ * @brief   Maximum size of an asynchronous message
+ *
+ * Every message in the window keeps a buffer of this size for
+ * retransmissions.
+ */
+#define EMCUTE_ASYNC_BUFSIZE    (64U)
+#endif
+
 /**
  * @brief   MQTT-SN flags
  *
@@ -225,6 +259,16 @@ typedef struct emcute_sub {
     void *arg;                  /**< optional custom argument */
 } emcute_sub_t;
 
+/**
+ * @brief   Signature for callbacks fired when an asynchronous operation completed
+ *
+ * @param[in] topic     topic of the operation
+ * @param[in] res       EMCUTE_OK on success, otherwise the error the
+ *                      synchronous function would have returned
+ * @param[in] arg       custom argument given to the operation
+ */
+typedef void(*emcute_done_cb_t)(emcute_topic_t *topic, int res, void *arg);
+
 /**
  * @brief   Connect to a given MQTT-SN gateway (CONNECT)
  *
@@ -320,6 +364,69 @@ int emcute_sub(emcute_sub_t *sub, unsigned flags);
  */
 int emcute_unsub(emcute_sub_t *sub);
 
+#if defined(MODULE_EMCUTE_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Get a topic ID for the given topic name without waiting for it
+ *
+ * @p topic.id is set before @p cb is called.
+ *
+ * @note    Blocks while @ref EMCUTE_ASYNC_WINDOW messages are waiting for their
+ *          acknowledgment
+ *
+ * @param[in,out] topic     topic to register, topic.name **must not** be NULL,
+ *                          must stay valid until @p cb was called
+ * @param[in] cb            called with the result, may be NULL
+ * @param[in] arg           custom argument for @p cb
+ *
+ * @return  EMCUTE_OK if the request was sent
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if the message exceeds @ref EMCUTE_ASYNC_BUFSIZE
+ */
+int emcute_reg_async(emcute_topic_t *topic, emcute_done_cb_t cb, void *arg);
+
+/**
+ * @brief   Get topic IDs for a number of topics at once
+ *
+ * All registrations are in flight at the same time, up to
+ * @ref EMCUTE_ASYNC_WINDOW of them.
+ *
+ * @param[in,out] topics    topics to register, topic.name **must not** be NULL
+ * @param[in] numof         number of entries in @p topics
+ *
+ * @return  EMCUTE_OK if all topics were registered
+ * @return  the error of the first failed registration otherwise, see
+ *          emcute_reg()
+ */
+int emcute_reg_batch(emcute_topic_t *topics, size_t numof);
+
+/**
+ * @brief   Publish data on the given topic without waiting for the
+ *          acknowledgment
+ *
+ * Messages with QoS 0 are published with emcute_pub(), @p cb is not called
+ * for them.
+ *
+ * @note    Blocks while @ref EMCUTE_ASYNC_WINDOW messages are waiting for their
+ *          acknowledgment
+ *
+ * @param[in] topic     topic to send data to, topic **must** be registered
+ *                      (topic.id **must** populated) and stay valid until @p cb
+ *                      was called
+ * @param[in] buf       data to publish, copied by the function
+ * @param[in] len       length of @p data in bytes
+ * @param[in] flags     flags used for publication, allowed are QoS and retain
+ * @param[in] cb        called with the result, may be NULL
+ * @param[in] arg       custom argument for @p cb
+ *
+ * @return  EMCUTE_OK if the message was sent
+ * @return  EMCUTE_NOGW if not connected to a gateway
+ * @return  EMCUTE_OVERFLOW if the message exceeds @ref EMCUTE_ASYNC_BUFSIZE
+ * @return  EMCUTE_NOTSUP on unsupported flag values
+ */
+int emcute_pub_async(emcute_topic_t *topic, const void *buf, size_t len,
+                     unsigned flags, emcute_done_cb_t cb, void *arg);
+#endif
+
 /**
  * @brief   Update the last will topic
  *
@@ -11,6 +11,12 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default every lookup scans all entries of a table. With the
+ * `fib_radix` module a radix trie over the destination prefixes is
+ * maintained alongside each single hop table, so fib_get_next_hop() runs in
+ * O(prefix length) and expired entries are only swept once the earliest
+ * lifetime in the table has passed.
+ *
  * @{
  *
  * @file
@@ -129,6 +135,8 @@ int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type
  * @param[in] lifetime       the lifetime in ms to be updates
  *
  * @return 0 on success
+ *         1 if the entry already existed with the same next hop and has only
+ *           been refreshed
  *         -ENOMEM if the entry cannot be created due to insufficient RAM
  *         -EFAULT if dst and/or next_hop is not a valid pointer
  */
@@ -149,6 +157,8 @@ int fib_add_entry(fib_table_t *table, kernel_pid_t iface_id, uint8_t *dst,
  * @param[in] lifetime       the lifetime in ms to be updates
  *
  * @return 0 on success
+ *         1 if the next hop did not change and the entry has only been
+ *           refreshed
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  *         -EFAULT if dst and/or next_hop is not a valid pointer
  */
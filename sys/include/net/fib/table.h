@@ -35,10 +35,28 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+/**
+ * @brief Node of the radix trie indexing the single hop entries of a table
+ *
+ * @details Every entry carries two nodes: one representing the entry itself
+ *          and one spare node used as internal branching (glue) node anywhere
+ *          in the trie. Entries sharing the same prefix are chained by
+ *          fib_radix_node_t::dup.
+ */
+typedef struct fib_radix_node {
+    struct fib_radix_node *parent;      /**< parent node, NULL for the root */
+    struct fib_radix_node *child[2];    /**< children, selected by bit @p len */
+    struct fib_radix_node *dup;         /**< next entry node with same prefix */
+    struct fib_entry *entry;            /**< the entry, NULL for glue nodes */
+    uint16_t len;                       /**< prefix length in bits */
+} fib_radix_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +69,10 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** radix trie nodes: [0] represents the entry, [1] is a spare glue node */
+    fib_radix_node_t radix[2];
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +155,18 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** incremented whenever an entry is added, removed or changes its next
+     *  hop, so users can tell if results of earlier lookups are still valid
+     */
+    uint32_t version;
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** root of the radix trie indexing the single hop entries */
+    fib_radix_node_t *radix_root;
+    /** list of unused glue nodes, chained by fib_radix_node_t::child[0] */
+    fib_radix_node_t *radix_free;
+    /** absolute time-point of the earliest entry expiry in the table */
+    uint64_t next_expiry;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
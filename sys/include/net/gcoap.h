@@ -130,6 +130,25 @@
  * times out. We track the response with an entry in the
  * `_coap_state.open_reqs` array.
  *
+ * ### Event-driven Operation ###
+ *
+ * By default, the gcoap thread alternates between checking its message queue
+ * and blocking on the sock for at most GCOAP_RECV_TIMEOUT, and finds the memo
+ * for a response by comparing its token with every open request. Use the
+ * `gcoap_async` module instead for clients with many requests in flight:
+ *
+ * - The thread sleeps on thread flags until the sock reports data (see
+ *   @ref net_sock_async) or a response timer expired. Sending a request does
+ *   not have to wake it up.
+ * - Open requests are indexed by a hash over their token in
+ *   GCOAP_MEMO_BUCKETS buckets, so a response finds its memo in constant
+ *   time. A new request gets a fresh token if its token is still in use.
+ * - GCOAP_REQ_WAITING_MAX defaults to a larger value.
+ * - gcoap_pdu_buf_alloc() provides request buffers from a pool of
+ *   GCOAP_PDU_BUF_NUMOF buffers. A pooled buffer passed to gcoap_req_send2()
+ *   is owned by gcoap until the request is done, so a client does not need
+ *   a buffer per outstanding request of its own.
+ *
  * @{
  *
  * @file
@@ -175,8 +194,35 @@ extern "C" {
  */
 #define GCOAP_RESP_OPTIONS_BUF  (8)
 
-/** @brief Maximum number of requests awaiting a response */
+/**
+ * @brief Maximum number of requests awaiting a response
+ *
+ * With `gcoap_async`, a response finds its memo by a hashed token, so more
+ * requests may be in flight.
+ */
+#ifndef GCOAP_REQ_WAITING_MAX
+#ifdef MODULE_GCOAP_ASYNC
+#define GCOAP_REQ_WAITING_MAX   (16)
+#else
 #define GCOAP_REQ_WAITING_MAX   (2)
+#endif
+#endif
+
+#if defined(MODULE_GCOAP_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Number of hash buckets for the requests awaiting a response
+ *
+ * Must be a power of two.
+ */
+#ifndef GCOAP_MEMO_BUCKETS
+#define GCOAP_MEMO_BUCKETS      (8)
+#endif
+
+/** @brief Number of buffers in the pool for gcoap_pdu_buf_alloc() */
+#ifndef GCOAP_PDU_BUF_NUMOF
+#define GCOAP_PDU_BUF_NUMOF     (4)
+#endif
+#endif
 
 /** @brief Maximum length in bytes for a token */
 #define GCOAP_TOKENLEN_MAX      (8)
@@ -246,13 +292,24 @@ typedef void (*gcoap_resp_handler_t)(unsigned req_state, coap_pkt_t* pdu);
 /**
  * @brief  Memo to handle a response for a request
  */
-typedef struct {
+typedef struct gcoap_request_memo {
     unsigned state;                     /**< State of this memo, a GCOAP_MEMO... */
     uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
                                         /**< Stores a copy of the request header */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
     xtimer_t response_timer;            /**< Limits wait for response */
+#if !defined(MODULE_GCOAP_ASYNC) || defined(DOXYGEN)
     msg_t timeout_msg;                  /**< For response timer */
+#endif
+#if defined(MODULE_GCOAP_ASYNC) || defined(DOXYGEN)
+    struct gcoap_request_memo *next;    /**< Next memo in the token's bucket
+                                             or in the list of unused memos */
+    uint8_t *pdu_buf;                   /**< Request buffer from the pool,
+                                             NULL if the header was copied */
+    uint16_t generation;                /**< Incremented whenever the memo
+                                             is freed, tells its requests
+                                             apart */
+#endif
 } gcoap_request_memo_t;
 
 /**
@@ -265,6 +322,11 @@ typedef struct {
                                             byte of an entry is zero, the entry
                                             is available */
     uint16_t last_message_id;          /**< Last message ID used */
+#if defined(MODULE_GCOAP_ASYNC) || defined(DOXYGEN)
+    gcoap_request_memo_t *memo_buckets[GCOAP_MEMO_BUCKETS];
+                                       /**< Open requests by token hash */
+    gcoap_request_memo_t *free_reqs;   /**< Unused entries of open_reqs */
+#endif
 } gcoap_state_t;
 
 /**
@@ -340,6 +402,10 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 /**
  * @brief  Sends a buffer containing a CoAP request to the provided endpoint.
  *
+ * With `gcoap_async`, the token in @p buf is replaced if another open request
+ * uses it already. A buffer from gcoap_pdu_buf_alloc() belongs to gcoap after
+ * this call, even if the request could not be sent.
+ *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
  * @param[in] remote Destination for the packet
@@ -411,6 +477,28 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  */
 void gcoap_op_state(uint8_t *open_reqs);
 
+#if defined(MODULE_GCOAP_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Takes a buffer of GCOAP_PDU_BUF_SIZE bytes from the request pool.
+ *
+ * Pass the buffer to gcoap_req_send2() after building the request in it.
+ * gcoap returns it to the pool after the response handler ran, so the handler
+ * for a timeout sees the complete request. Use gcoap_pdu_buf_free() if the
+ * request is not sent.
+ *
+ * @return  a buffer of GCOAP_PDU_BUF_SIZE bytes
+ * @return  NULL, if all buffers are in use
+ */
+uint8_t *gcoap_pdu_buf_alloc(void);
+
+/**
+ * @brief   Returns a buffer from gcoap_pdu_buf_alloc() to the pool.
+ *
+ * @param[in] buf   Buffer from gcoap_pdu_buf_alloc()
+ */
+void gcoap_pdu_buf_free(uint8_t *buf);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,26 @@ gnrc_pktsnip_t *gnrc_icmpv6_build(gnrc_pktsnip_t *next, uint8_t type, uint8_t co
  */
 int gnrc_icmpv6_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+/**
+ * @brief   Updates the checksum of an ICMPv6 packet after a part of its
+ *          checksum domain changed, e.g. the source address in the pseudo
+ *          header.
+ *
+ * The checksum must have been calculated before, the payload is not read.
+ *
+ * @param[in] hdr       The header the checksum should be updated for.
+ * @param[in] old_buf   The changed part before the change. Must start at an
+ *                      even offset of the checksum domain.
+ * @param[in] new_buf   The changed part after the change.
+ * @param[in] len       Length of @p old_buf and @p new_buf.
+ *
+ * @return  0, on success.
+ * @return  -EFAULT, if @p hdr was NULL
+ * @return  -EBADMSG, if gnrc_pktsnip_t::type of @p hdr was not GNRC_NETTYPE_ICMPV6
+ */
+int gnrc_icmpv6_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                            const uint8_t *new_buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
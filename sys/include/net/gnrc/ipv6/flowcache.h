@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_flowcache IPv6 forwarding flow cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Caches the forwarding decision for recent destinations
+ *
+ * Routers forwarding many packets to the same destinations can use this
+ * cache to skip the destination check, the FIB lookup and the next hop
+ * resolution in @ref net_gnrc_ipv6 for all but the first packet of a flow.
+ * An entry maps a destination address to the interface and the ready-made
+ * @ref net_gnrc_netif_hdr "interface header" to send packets to it with.
+ *
+ * All entries are dropped when the neighbor cache or the addresses of an
+ * interface change. With the `fib` module, entries added before the last
+ * change of @ref gnrc_ipv6_fib_table are ignored as well. Since routes and
+ * neighbors may also time out without being looked up, entries are
+ * additionally only used for @ref GNRC_IPV6_FLOWCACHE_TIMEOUT after they
+ * were added.
+ *
+ * @{
+ *
+ * @file
+ * @brief   IPv6 forwarding flow cache definitions
+ */
+#ifndef GNRC_IPV6_FLOWCACHE_H
+#define GNRC_IPV6_FLOWCACHE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of flows in the cache
+ */
+#ifndef GNRC_IPV6_FLOWCACHE_SIZE
+#define GNRC_IPV6_FLOWCACHE_SIZE    (8)
+#endif
+
+/**
+ * @brief   Time in microseconds an entry is used after it was added
+ */
+#ifndef GNRC_IPV6_FLOWCACHE_TIMEOUT
+#define GNRC_IPV6_FLOWCACHE_TIMEOUT (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Flow cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination address of the flow */
+    uint32_t added;             /**< time the entry was added */
+    uint32_t fib_version;       /**< fib_table_t::version when added, if
+                                     the FIB is used */
+    /**
+     * @brief   Interface header to send packets to gnrc_ipv6_flowcache_t::dst
+     *          with, gnrc_netif_hdr_t::if_pid is KERNEL_PID_UNDEF if the entry
+     *          is unused
+     */
+    gnrc_netif_hdr_t netif_hdr;
+    /**
+     * @brief   Destination link layer address of
+     *          gnrc_ipv6_flowcache_t::netif_hdr, must follow it directly
+     */
+    uint8_t dst_l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];
+} gnrc_ipv6_flowcache_t;
+
+/**
+ * @brief   Adds the forwarding decision for a destination to the cache
+ *
+ * Replaces the oldest entry if the cache is full.
+ *
+ * @param[in] dst           destination address of the forwarded packet
+ * @param[in] iface         interface the packet is sent over
+ * @param[in] l2addr        link layer address of the next hop
+ * @param[in] l2addr_len    length of @p l2addr
+ */
+void gnrc_ipv6_flowcache_add(const ipv6_addr_t *dst, kernel_pid_t iface,
+                             const uint8_t *l2addr, uint8_t l2addr_len);
+
+/**
+ * @brief   Looks up the forwarding decision for a destination
+ *
+ * @param[in] dst       destination address
+ * @param[out] flow     copy of the cache entry for @p dst
+ *
+ * @return  true, if a valid entry for @p dst was found
+ * @return  false, otherwise
+ */
+bool gnrc_ipv6_flowcache_get(const ipv6_addr_t *dst, gnrc_ipv6_flowcache_t *flow);
+
+/**
+ * @brief   Drops all entries
+ */
+void gnrc_ipv6_flowcache_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_FLOWCACHE_H */
+/** @} */
@@ -44,6 +44,17 @@ extern "C" {
 #define GNRC_IPV6_NC_SIZE           (GNRC_NETIF_NUMOF * 8)
 #endif
 
+#ifndef GNRC_IPV6_NC_BUCKETS
+/**
+ * @brief   The number of hash buckets of the neighbor cache
+ *
+ * @details Entries are looked up by IPv6 address and by link layer address
+ *          in hash tables of this size. Must be a power of two. About a
+ *          quarter of @ref GNRC_IPV6_NC_SIZE keeps lookups short.
+ */
+#define GNRC_IPV6_NC_BUCKETS        (8U)
+#endif
+
 #ifndef GNRC_IPV6_NC_L2_ADDR_MAX
 /**
  * @brief   The maximum size of a link layer address
@@ -119,7 +130,10 @@ extern "C" {
  *              RFC 4861, section 5.1
  *          </a>.
  */
-typedef struct {
+typedef struct gnrc_ipv6_nc {
+    struct gnrc_ipv6_nc *addr_next;             /**< next entry in IPv6 address hash bucket */
+    struct gnrc_ipv6_nc *l2_next;               /**< next entry in link layer address hash
+                                                 *   bucket */
 #ifdef MODULE_GNRC_NDP_NODE
     gnrc_pktqueue_t *pkts;                      /**< Packets waiting for address resolution */
 #endif
@@ -162,6 +176,7 @@ typedef struct {
                                              *   different from L2 address, if l2_addr_len == 2) */
 #endif
 
+    uint16_t last_used;                     /**< time stamp of last use for eviction */
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
     /**
      * @}
@@ -176,6 +191,11 @@ void gnrc_ipv6_nc_init(void);
 /**
  * @brief   Adds a neighbor to the neighbor cache
  *
+ * If the neighbor cache is full, the least recently used entry in state
+ * @ref GNRC_IPV6_NC_STATE_STALE or @ref GNRC_IPV6_NC_STATE_UNREACHABLE is
+ * replaced. Routers, entries registered by 6LoWPAN-ND and entries with
+ * queued packets are never replaced.
+ *
  * @param[in] iface         PID to the interface where the neighbor is.
  * @param[in] ipv6_addr     IPv6 address of the neighbor. Must not be NULL.
  * @param[in] l2_addr       Link layer address of the neighbor. NULL if unknown.
@@ -212,6 +232,39 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
  */
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
 
+/**
+ * @brief   Searches for neighbor cache entries with the link layer address
+ *          @p l2_addr.
+ *
+ * @param[in] iface         PID to the interface where the neighbor is. If it
+ *                          is KERNEL_PID_UNDEF it will be searched on all
+ *                          interfaces.
+ * @param[in] l2_addr       A link layer address
+ * @param[in] l2_addr_len   Length of @p l2_addr
+ * @param[in] prev          Previous entry returned for the same parameters.
+ *                          NULL to get the first one.
+ *
+ * @return  The next neighbor cache entry with @p l2_addr, if one is found.
+ * @return  NULL, if none is found.
+ */
+gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_by_l2_addr(kernel_pid_t iface, const void *l2_addr,
+                                            size_t l2_addr_len, gnrc_ipv6_nc_t *prev);
+
+/**
+ * @brief   Sets the link layer address of a neighbor cache entry.
+ *
+ * @note    Always use this function instead of writing gnrc_ipv6_nc_t::l2_addr
+ *          directly, so gnrc_ipv6_nc_get_by_l2_addr() finds the entry.
+ *
+ * @param[in] entry         A neighbor cache entry
+ * @param[in] l2_addr       The new link layer address. May be NULL if
+ *                          @p l2_addr_len is 0.
+ * @param[in] l2_addr_len   Length of @p l2_addr, must be lesser than or equal
+ *                          to GNRC_IPV6_NC_L2_ADDR_MAX.
+ */
+void gnrc_ipv6_nc_set_l2_addr(gnrc_ipv6_nc_t *entry, const void *l2_addr,
+                              size_t l2_addr_len);
+
 /**
  * @brief   Gets next entry in neighbor cache after @p prev.
  *
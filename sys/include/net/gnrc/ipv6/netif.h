@@ -207,6 +207,12 @@ extern "C" {
  */
 #define GNRC_IPV6_NETIF_FLAGS_IS_WIRED          (0x0080)
 
+/**
+ * @brief   Flag to indicate that the device of the interface calculates
+ *          upper layer checksums of sent packets (see @ref NETOPT_CHECKSUM_TX)
+ */
+#define GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD      (0x0100)
+
 /**
  * @brief   Offset of the router advertisement flags compared to the position in router
  *          advertisements.
@@ -30,6 +30,8 @@
 #define GNRC_NETDEV_H
 
 #include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "kernel_types.h"
@@ -66,6 +68,31 @@ extern "C" {
  */
 #define GNRC_NETDEV_MAC_INFO_RX_STARTED         (0x0004U)
 
+#if defined(MODULE_GNRC_NETDEV_TX_STATUS) || defined(DOXYGEN)
+/**
+ * @brief   Callback for the result of a unicast transmission
+ *
+ * Called in the thread of the device that sent the frame.
+ *
+ * @param[in] iface         PID of the device the frame was sent with
+ * @param[in] l2addr        link layer destination of the frame
+ * @param[in] l2addr_len    length of @p l2addr
+ * @param[in] acked         true, if the frame was acknowledged
+ */
+typedef void (*gnrc_netdev_tx_status_cb_t)(kernel_pid_t iface,
+                                           const uint8_t *l2addr,
+                                           size_t l2addr_len, bool acked);
+
+/**
+ * @brief   Listener for the results of unicast transmissions, e.g. for link
+ *          estimation
+ */
+typedef struct gnrc_netdev_tx_status {
+    struct gnrc_netdev_tx_status *next; /**< next listener */
+    gnrc_netdev_tx_status_cb_t cb;      /**< callback of the listener */
+} gnrc_netdev_tx_status_t;
+#endif
+
 /**
  * @brief Structure holding GNRC netdev adapter state
  *
@@ -102,6 +129,20 @@ typedef struct gnrc_netdev {
      */
     kernel_pid_t pid;
 
+#if defined(MODULE_GNRC_NETDEV_TX_STATUS) || defined(DOXYGEN)
+    /**
+     * @brief   Link layer destination of the unicast frame in transmission,
+     *          for the listeners to the transmission results
+     */
+    uint8_t tx_dst[IEEE802154_LONG_ADDRESS_LEN];
+
+    /**
+     * @brief   Length of gnrc_netdev_t::tx_dst, 0 if no unicast frame is in
+     *          transmission
+     */
+    uint8_t tx_dst_len;
+#endif
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
@@ -136,6 +177,16 @@ typedef struct gnrc_netdev {
 #endif /* MODULE_GNRC_MAC */
 } gnrc_netdev_t;
 
+#if defined(MODULE_GNRC_NETDEV_TX_STATUS) || defined(DOXYGEN)
+/**
+ * @brief   Registers a listener for the results of the unicast transmissions
+ *          of all devices
+ *
+ * @param[in] listener  the listener, must stay valid
+ */
+void gnrc_netdev_tx_status_register(gnrc_netdev_tx_status_t *listener);
+#endif
+
 #ifdef MODULE_GNRC_MAC
 
 /**
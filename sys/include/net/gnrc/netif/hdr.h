@@ -70,6 +70,16 @@ extern "C" {
  *          this flag the same way it does @ref GNRC_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
+
+/**
+ * @brief   Checksum of received packet was verified by the device.
+ *
+ * @details Set by the link layer on received packets whose UDP, TCP or
+ *          ICMPv6 checksum was already found valid by the device (see
+ *          @ref NETOPT_CHECKSUM_RX). The transport layer does not verify
+ *          the checksum of such packets again.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VALID (0x20)
 /**
  * @}
  */
@@ -53,6 +53,21 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets per protocol type
+ *
+ * @details With the `gnrc_netreg_hash` module the entries of each protocol
+ *          type are distributed over this many lists by their
+ *          gnrc_netreg_entry_t::demux_ctx, so gnrc_netreg_lookup() and
+ *          gnrc_netreg_getnext() only walk the entries sharing a bucket
+ *          instead of all entries of the type. Must be a power of two.
+ *
+ * @note    Only used with the `gnrc_netreg_hash` module.
+ */
+#ifndef GNRC_NETREG_HASH_BUCKETS
+#define GNRC_NETREG_HASH_BUCKETS    (8)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -69,7 +84,7 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#ifdef MODULE_GNRC_NETAPI_MBOX
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -320,6 +335,11 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
  * @param[in] entry     A registry entry retrieved by gnrc_netreg_lookup() or
  *                      gnrc_netreg_getnext(). Must not be NULL.
  *
+ * @note    Entries for the same type and demux context are always kept in
+ *          the same list, so iterating them with gnrc_netreg_lookup() and
+ *          gnrc_netreg_getnext() delivers to every subscriber exactly once as
+ *          long as the registry is not modified in between.
+ *
  * @return  The next entry after @p entry fitting the given parameters on success
  * @return  NULL if no entry new entry can be found.
  */
@@ -341,6 +361,28 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry);
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+/**
+ * @brief   Updates the checksum of a header after a part of its checksum
+ *          domain changed.
+ *
+ * This is cheaper than gnrc_netreg_calc_csum() when e.g. only an address
+ * in the pseudo header changed, since the payload is not read again.
+ *
+ * @param[in] hdr       The header the checksum should be updated for. Its
+ *                      checksum must have been calculated before.
+ * @param[in] old_buf   The changed part before the change. Must start at an
+ *                      even offset of the checksum domain.
+ * @param[in] new_buf   The changed part after the change.
+ * @param[in] len       Length of @p old_buf and @p new_buf.
+ *
+ * @return  0, on success.
+ * @return  -ENOENT, if @ref net_gnrc_netreg does not know how to update the
+ *          checksum for gnrc_pktsnip_t::type of @p hdr. The checksum needs to
+ *          be calculated with gnrc_netreg_calc_csum() then.
+ */
+int gnrc_netreg_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                            const uint8_t *new_buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,21 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @def     GNRC_PKTBUF_SLAB_PAGE_SIZE
+ * @brief   Page size of the `gnrc_pktbuf_slab` implementation.
+ *
+ * @details The `gnrc_pktbuf_slab` implementation splits the packet buffer
+ *          into pages of this size. Small chunks like packet snips and
+ *          protocol headers are taken from pages reserved for one size
+ *          class, larger chunks occupy a run of contiguous pages. The
+ *          default fits a full IEEE 802.15.4 frame into one page and an
+ *          IPv6 minimum MTU packet into 10 pages. Must be a multiple of 8.
+ */
+#ifndef GNRC_PKTBUF_SLAB_PAGE_SIZE
+#define GNRC_PKTBUF_SLAB_PAGE_SIZE  (128)
+#endif  /* GNRC_PKTBUF_SLAB_PAGE_SIZE */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -140,6 +155,41 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
  */
 int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size);
 
+/**
+ * @brief   Removes the first @p size bytes from gnrc_pktsnip_t::data of @p pkt
+ *
+ * @details Meant for link layer headers that are parsed in place on reception
+ *          and are not needed as a snip of their own, so unlike
+ *          gnrc_pktbuf_mark() no new snip is created. The data is not copied
+ *          if the packet buffer implementation can release the removed bytes
+ *          in place. For `gnrc_pktbuf_static` this is the case if @p size is
+ *          a multiple of the word size.
+ *
+ * ~~~~~~~~~~~~~~~~~~~
+ * Before                                    After
+ * ======                                    =====
+ *
+ *  pkt->data                                         pkt->data
+ *  v                                                 v
+ * +--------------------------------+        +--------+---------------+
+ * +--------------------------------+        +--------+---------------+
+ *  \__________pkt->size___________/          \_size_/ \__pkt->size__/
+ *                                             released
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * @pre `pkt != NULL`
+ * @pre `(pkt->size > 0) <=> (pkt->data != NULL)`
+ *
+ * @param[in] pkt   A packet part.
+ * @param[in] size  Number of bytes to remove from the beginning of @p pkt.
+ *
+ * @return  0, on success
+ * @return  EINVAL, if @p size > gnrc_pktsnip_t::size of @p pkt.
+ * @return  ENOMEM, if the data needed to be moved and no space is left in the
+ *          packet buffer.
+ */
+int gnrc_pktbuf_cut_head(gnrc_pktsnip_t *pkt, size_t size);
+
 /**
  * @brief   Increases gnrc_pktsnip_t::users of @p pkt atomically.
  *
@@ -24,6 +24,12 @@
  *   USEMODULE += gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - MRHOF with ETX (RFC 6719) as default objective function instead of OF0.
+ *   The ETX of the links is estimated from the TX feedback of the devices.
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_mrhof
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * - RPL auto-initialization on interface
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
  *   USEMODULE += auto_init_gnrc_rpl
@@ -170,6 +176,11 @@ extern "C" {
  */
 #define GNRC_RPL_MSG_TYPE_DAO_HANDLE  (0x0903)
 
+/**
+ * @brief   Message type for parents the ETX of which changed
+ */
+#define GNRC_RPL_MSG_TYPE_PARENT_ETX  (0x0904)
+
 /**
  * @brief   Infinite rank
  * @see <a href="https://tools.ietf.org/html/rfc6550#section-17">
@@ -198,12 +209,62 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @brief   Default Objective Code Point
+ *
+ * MRHOF (1) with the `gnrc_rpl_mrhof` pseudomodule, OF0 (0) otherwise.
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_DEFAULT_OCP (1)
+#else
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+#endif
+
+/**
+ * @{
+ * @name    Link quality estimation
+ *
+ * With the `gnrc_rpl_mrhof` pseudomodule every parent keeps the expected
+ * transmission count (ETX) of the link to it, fed by the link layer with
+ * gnrc_rpl_parent_etx_update(). The ETX is a fixed point number, with
+ * @ref GNRC_RPL_ETX_DIVISOR representing one transmission per frame.
+ */
+#ifndef GNRC_RPL_ETX_DIVISOR
+#define GNRC_RPL_ETX_DIVISOR    (128U)  /**< ETX of a perfect link */
+#endif
+
+#ifndef GNRC_RPL_ETX_INIT
+/**
+ * @brief   ETX of a parent no frame was sent to yet
+ */
+#define GNRC_RPL_ETX_INIT       (2 * GNRC_RPL_ETX_DIVISOR)
+#endif
+
+#ifndef GNRC_RPL_ETX_MAX_TRIES
+/**
+ * @brief   Number of unacknowledged frames in a row that are taken as one
+ *          sample of this many transmissions
+ */
+#define GNRC_RPL_ETX_MAX_TRIES  (8U)
+#endif
+
+#ifndef GNRC_RPL_ETX_WEIGHT
+/**
+ * @brief   Inverse weight of a new sample in the moving average of the ETX
+ */
+#define GNRC_RPL_ETX_WEIGHT     (8U)
+#endif
+/**
+ * @}
+ */
 
 /**
  * @brief   Default Instance ID
@@ -342,6 +403,17 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #ifndef GNRC_RPL_DEFAULT_DAO_DELAY
 #define GNRC_RPL_DEFAULT_DAO_DELAY (1)
 #endif
+/**
+ * @brief   Upper bound of the random delay in seconds added to
+ *          @ref GNRC_RPL_DEFAULT_DAO_DELAY
+ *
+ * Children of a router, which usually send their DAOs at about the same time
+ * after a repair, are merged into a single DAO of the router if they arrive
+ * within this time.
+ */
+#ifndef GNRC_RPL_DAO_DELAY_JITTER
+#define GNRC_RPL_DAO_DELAY_JITTER (4)
+#endif
 /** @} */
 
 /**
@@ -569,6 +641,10 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
 /**
  * @brief   Delay the DAO sending interval
  *
+ * A DAO that is already scheduled to be sent for the first time is not delayed
+ * again, as it is built from the FIB when sent and so includes all targets
+ * learned until then.
+ *
  * @param[in] dodag     The DODAG of the DAO
  */
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
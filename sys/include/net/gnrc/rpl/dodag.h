@@ -149,6 +149,46 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent);
  */
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent);
 
+#if defined(MODULE_GNRC_RPL_MRHOF) || defined(DOXYGEN)
+/**
+ * @brief   Set the link layer address of all parents with the IPv6 address
+ *          @p addr on the interface @p iface.
+ *
+ * @param[in] iface         PID of the interface the parents are on.
+ * @param[in] addr          Link-local IPv6 address of the parents.
+ * @param[in] l2_addr       Link layer address of the parents.
+ * @param[in] l2_addr_len   Length of @p l2_addr.
+ */
+void gnrc_rpl_parent_set_l2_addr(kernel_pid_t iface, const ipv6_addr_t *addr,
+                                 const uint8_t *l2_addr, size_t l2_addr_len);
+
+/**
+ * @brief   Update the ETX of all parents with the link layer address
+ *          @p l2_addr with the result of a unicast transmission.
+ *
+ * A sample is taken when a frame was acknowledged, counting the frames that
+ * were not acknowledged before, or after @ref GNRC_RPL_ETX_MAX_TRIES frames in
+ * a row were not acknowledged. May be called from the thread of the device,
+ * so the parents are only re-sorted later, by the RPL thread with
+ * gnrc_rpl_parent_etx_changed().
+ *
+ * @param[in] iface         PID of the interface the frame was sent on.
+ * @param[in] l2_addr       Link layer destination of the frame.
+ * @param[in] l2_addr_len   Length of @p l2_addr.
+ * @param[in] acked         true, if the frame was acknowledged.
+ */
+void gnrc_rpl_parent_etx_update(kernel_pid_t iface, const uint8_t *l2_addr,
+                                size_t l2_addr_len, bool acked);
+
+/**
+ * @brief   Move a parent, the ETX of which changed, to its place in the
+ *          parent list and select the preferred parent again.
+ *
+ * @param[in] parent    Pointer to the parent
+ */
+void gnrc_rpl_parent_etx_changed(gnrc_rpl_parent_t *parent);
+#endif
+
 /**
  * @brief   Start a local repair.
  *
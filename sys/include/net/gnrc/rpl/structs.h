@@ -215,6 +215,13 @@ typedef struct gnrc_rpl_parent gnrc_rpl_parent_t;
  */
 typedef struct gnrc_rpl_instance gnrc_rpl_instance_t;
 
+/**
+ * @brief   Maximum length of the link layer address of a parent
+ */
+#ifndef GNRC_RPL_PARENT_L2_ADDR_MAX
+#define GNRC_RPL_PARENT_L2_ADDR_MAX (8)
+#endif
+
 /**
  * @cond INTERNAL */
 struct gnrc_rpl_parent {
@@ -227,6 +234,14 @@ struct gnrc_rpl_parent {
     uint32_t lifetime;              /**< lifetime of this parent in seconds */
     double  link_metric;            /**< metric of the link */
     uint8_t link_metric_type;       /**< type of the metric */
+#ifdef MODULE_GNRC_RPL_MRHOF
+    uint8_t l2_addr[GNRC_RPL_PARENT_L2_ADDR_MAX];   /**< link layer address of this parent */
+    uint8_t l2_addr_len;            /**< length of the link layer address, 0 if unknown */
+    uint8_t etx_tries;              /**< unacknowledged frames since the last ETX sample */
+    uint16_t etx;                   /**< ETX of the link to this parent */
+    uint8_t etx_changed;            /**< 1 if the RPL thread was told about a
+                                         changed ETX, 0 otherwise */
+#endif
 };
 /**
  * @endcond
@@ -14,6 +14,16 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * With the `gnrc_sixlowpan_frag_fwd` module, a router does not reassemble
+ * datagrams it routes to another 6LoWPAN neighbor. The IPv6 header of the
+ * first fragment is decompressed to route it and compressed again for the
+ * next hop. The subsequent fragments are then only relabeled with the
+ * interface, next hop and datagram tag chosen for the first one and sent on
+ * right away. Subsequent fragments received before the first one of their
+ * datagram are held in the reassembly buffer and forwarded together with
+ * the first one.
+ *
  * @{
  *
  * @file
@@ -37,11 +47,43 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of datagrams that can be forwarded fragment by fragment at
+ *          the same time
+ *
+ * @note    Only used with the `gnrc_sixlowpan_frag_fwd` module.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_FWD_SIZE
+#define GNRC_SIXLOWPAN_FRAG_FWD_SIZE    (4U)
+#endif
+
+/**
+ * @brief   Time in microseconds to wait before handing the next fragment to
+ *          an interface whose message queue was full
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RETRY_DELAY
+#define GNRC_SIXLOWPAN_FRAG_RETRY_DELAY (1000U)
+#endif
+
+/**
+ * @brief   Number of times in a row a fragment is retried before the rest of
+ *          the datagram is dropped
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_RETRIES
+#define GNRC_SIXLOWPAN_FRAG_RETRIES     (8U)
+#endif
+
 /**
  * @brief   Message type for passing one 6LoWPAN fragment down the network stack
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Message type for triggering garbage collection of the reassembly
+ *          buffer
+ */
+#define GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF (0x0226)
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -56,6 +98,18 @@ typedef struct {
 /**
  * @brief   Sends a packet fragmented.
  *
+ * All (remaining) fragments are handed to the interface in one go. If no
+ * other packet holds the snips of gnrc_sixlowpan_msg_frag_t::pkt, they are
+ * moved into the fragments instead of being copied, so no more than one
+ * copy of the payload exists in the packet buffer at any time.
+ *
+ * If the message queue of the interface is full, the calling thread receives
+ * a @ref GNRC_SIXLOWPAN_MSG_FRAG_SND message with @p fragment_msg after
+ * @ref GNRC_SIXLOWPAN_FRAG_RETRY_DELAY and has to call this function with it
+ * again. gnrc_sixlowpan_msg_frag_t::pkt is released and set to NULL once the
+ * datagram was sent or had to be dropped, @p fragment_msg must stay valid
+ * until then.
+ *
  * @param[in] fragment_msg    Message containing status of the 6LoWPAN
  *                            fragmentation progress
  */
@@ -68,6 +122,15 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Removes all datagrams from the reassembly buffer whose
+ *          reassembly timed out.
+ *
+ * Must be called by the thread that handles the fragments when it receives
+ * a @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF message.
+ */
+void gnrc_sixlowpan_frag_gc_rbuf(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,17 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's tcp implementation for the gnrc stack
  *
+ * Received segments are handed to their connection by a hash over local port,
+ * peer port and peer address (see GNRC_TCP_DEMUX_BUCKETS), so the cost of a segment
+ * does not grow with the number of open connections.
+ *
+ * By default, received segments are queued to the TCP thread. With the
+ * `gnrc_tcp_direct` pseudomodule, they are processed in the context of the network
+ * layer and outgoing segments are passed to the network layer by the calling thread,
+ * which saves a message and a context switch per segment. Only timeouts are still
+ * handled by the TCP thread then. The network layer threads stack size
+ * (e.g. GNRC_IPV6_STACK_SIZE) may need to be increased for this.
+ *
  * @{
  *
  * @file
@@ -119,7 +130,10 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
  * @pre tcb must not be NULL.
  * @pre data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occured.
+ * @note Blocks until up to @p len bytes were transmitted or an error occured. Transmitted
+ *       bytes may not yet be acknowledged by the peer: up to GNRC_TCP_SND_SEGMENTS segments
+ *       are kept for retransmission, the call only blocks until at least one of them was
+ *       acknowledged if all of them are in use.
  *
  * @param[in,out] tcb                    This connections Transmission control block.
  * @param[in] data                       Pointer to the data that should be transmitted.
@@ -81,6 +81,53 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Number of hash buckets used to find the connection of a received segment
+ *
+ * Must be a power of two.
+ */
+#ifndef GNRC_TCP_DEMUX_BUCKETS
+#define GNRC_TCP_DEMUX_BUCKETS (8U)
+#endif
+
+/**
+ * @brief Number of unacknowledged segments a connection may have in flight
+ *
+ * Unacknowledged segments are kept in the packet buffer until they are acknowledged, so each
+ * one can occupy up to GNRC_TCP_MSS bytes plus headers there.
+ */
+#ifndef GNRC_TCP_SND_SEGMENTS
+#define GNRC_TCP_SND_SEGMENTS (2U)
+#endif
+
+/**
+ * @brief Number of segments a connection may send while its FSM is locked
+ *
+ * Segments are only passed down to the network layer after the FSM was unlocked, because the
+ * network layer may be waiting for the FSM itself. Sending data emits up to
+ * GNRC_TCP_SND_SEGMENTS segments, a received segment up to two.
+ */
+#ifndef GNRC_TCP_OUT_SEGMENTS
+#define GNRC_TCP_OUT_SEGMENTS (GNRC_TCP_SND_SEGMENTS + 2U)
+#endif
+
+/**
+ * @brief Window scale shift count announced to the peer (see RFC 7323)
+ *
+ * The receive window is announced right-shifted by this value, so GNRC_TCP_RCV_BUF_SIZE
+ * shifted by it must fit into 16 bit.
+ */
+#ifndef GNRC_TCP_WND_SCALE
+#define GNRC_TCP_WND_SCALE (0U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
 /**
  * @brief Lower Bound for RTO = 1 sec (see RFC 6298)
  */
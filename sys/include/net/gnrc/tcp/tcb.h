@@ -59,22 +59,31 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send Unacknowledged */
     uint32_t snd_nxt;      /**< Send Next */
-    uint16_t snd_wnd;      /**< Send Window */
+    uint32_t snd_wnd;      /**< Send Window */
     uint32_t snd_wl1;      /**< SeqNo. Last Windowupdate */
     uint32_t snd_wl2;      /**< AckNo. Last Windowupdate */
     uint32_t rcv_nxt;      /**< Receive Next */
-    uint16_t rcv_wnd;      /**< Receive Window */
+    uint32_t rcv_wnd;      /**< Receive Window */
     uint32_t iss;          /**< Initial Sequence Number */
     uint32_t irs;          /**< Initial Received Sequence Number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t snd_wnd_scale; /**< Shift count for windows announced by the peer */
+    uint8_t rcv_wnd_scale; /**< Shift count for windows announced to the peer */
+    uint8_t dup_acks;      /**< Number of consecutive duplicate ACKs */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< SeqNo. that ends the segment used for rtt estimation */
     int32_t rtt_var;       /**< Round Trip Time variance */
     int32_t srtt;          /**< Smoothed Round Trip Time */
     int32_t rto;           /**< Retransmission Timeout Duration */
     uint8_t retries;       /**< Number of Retransmissions */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to Packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_SND_SEGMENTS];  /**< Unacknowledged packets,
+                                                                  oldest first */
+    uint8_t retransmit_cnt;           /**< Number of packets in pkt_retransmit */
+    gnrc_pktsnip_t *pkt_out[GNRC_TCP_OUT_SEGMENTS];  /**< Packets to pass down once the FSM
+                                                          is unlocked */
+    uint8_t out_cnt;                  /**< Number of packets in pkt_out */
     kernel_pid_t owner;               /**< PID of this connection handling thread */
     msg_t msg_queue[GNRC_TCP_TCB_MSG_QUEUE_SIZE];   /**< Tcb's message queue */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
@@ -82,6 +91,8 @@ typedef struct _transmission_control_block {
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for Function call synchronization */
     struct _transmission_control_block *next;   /**< Pointer next TCP connection */
+    struct _transmission_control_block *hash_next;  /**< Next connection in the same
+                                                         demultiplexing bucket */
 } gnrc_tcp_tcb_t;
 
 #ifdef __cplusplus
@@ -66,6 +66,27 @@ extern "C" {
  */
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+/**
+ * @brief   Updates the checksum of the given packet after a part of its
+ *          checksum domain changed, e.g. the source address in the pseudo
+ *          header
+ *
+ * The checksum must have been calculated before, the payload is not read.
+ *
+ * @param[in] hdr       Pointer to the UDP header
+ * @param[in] old_buf   The changed part before the change, must start at an
+ *                      even offset of the checksum domain
+ * @param[in] new_buf   The changed part after the change
+ * @param[in] len       Length of @p old_buf and @p new_buf
+ *
+ * @return  0 on success
+ * @return  -EBADMSG if @p hdr is not of type GNRC_NETTYPE_UDP
+ * @return  -EFAULT if @p hdr is NULL
+ * @return  -ENOENT if @p hdr carries no checksum yet
+ */
+int gnrc_udp_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                         const uint8_t *new_buf, size_t len);
+
 /**
  * @brief   Allocate and initialize a fresh UDP header in the packet buffer
  *
@@ -73,6 +73,52 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum after a 16-bit word of its domain
+ *          changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624, equation 3
+ *      </a>
+ *
+ * @details Unlike inet_csum() this operates on the normalized checksum as it
+ *          is stored in a header, so the whole domain does not need to be
+ *          summed up again when e.g. an address is rewritten.
+ *
+ * @param[in] csum      The normalized checksum.
+ * @param[in] old_word  The word before the change.
+ * @param[in] new_word  The word after the change.
+ *
+ * @return  The updated normalized checksum.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_word,
+                                          uint16_t new_word)
+{
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_word + new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return ~sum;
+}
+
+/**
+ * @brief   Updates an Internet Checksum after a part of its domain changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624, equation 3
+ *      </a>
+ *
+ * @param[in] csum      The normalized checksum.
+ * @param[in] old_buf   The changed part before the change. Must start at an
+ *                      even offset of the checksum domain.
+ * @param[in] new_buf   The changed part after the change.
+ * @param[in] len       Length of @p old_buf and @p new_buf in byte.
+ *
+ * @return  The updated normalized checksum.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_buf,
+                          const uint8_t *new_buf, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -240,6 +240,27 @@ typedef enum {
      */
     NETOPT_RF_TESTMODE,
 
+    /**
+     * @brief   (@ref netopt_enable_t) read-only check if the device verifies
+     *          UDP, TCP and ICMPv6 checksums of received packets
+     *
+     * If enabled, the driver marks every received frame whose checksum was
+     * found to be valid (e.g. with @ref NETDEV_ETH_RX_INFO_CSUM_VALID), so
+     * upper layers can skip the verification. Frames with an invalid or
+     * unchecked checksum are passed up unmarked.
+     */
+    NETOPT_CHECKSUM_RX,
+
+    /**
+     * @brief   (@ref netopt_enable_t) read-only check if the device calculates
+     *          UDP, TCP and ICMPv6 checksums of sent packets
+     *
+     * If enabled, the network layer does not calculate the checksum of
+     * packets sent over this device and the device must overwrite the
+     * checksum field before transmission.
+     */
+    NETOPT_CHECKSUM_TX,
+
     /* add more options if needed */
 
     /**
@@ -51,6 +51,13 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+    uint32_t rx_batch_count;    /**< receive events that delivered frames,
+                                     rx_count / rx_batch_count is the
+                                     average batch size. Only counted by
+                                     drivers that hand several frames to
+                                     the upper layer per event, 0 otherwise */
+    uint32_t rx_batch_max;      /**< largest number of frames delivered
+                                     for a single receive event */
 } netstats_t;
 
 #ifdef __cplusplus
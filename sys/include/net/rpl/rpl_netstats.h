@@ -67,6 +67,10 @@ typedef struct {
     uint32_t dao_ack_tx_ucast_bytes;    /**< unicast dao_ack sent in bytes */
     uint32_t dao_ack_tx_mcast_count;    /**< multicast dao_ack sent in packets */
     uint32_t dao_ack_tx_mcast_bytes;    /**< multicast dao_ack sent in bytes*/
+    /* DAO aggregation */
+    uint32_t dao_tx_targets;            /**< targets sent in daos */
+    uint32_t dao_aggregated;            /**< dao triggers merged into a scheduled dao */
+    uint32_t dao_suppressed;            /**< received daos without new routes */
 } netstats_rpl_t;
 
 #ifdef __cplusplus
@@ -152,6 +152,13 @@ extern "C" {
  */
 #define SOCK_NO_TIMEOUT     (UINT32_MAX)
 
+/**
+ * @brief   Events reported to a callback of the @ref net_sock_async
+ */
+typedef enum {
+    SOCK_ASYNC_MSG_RECV = 0x01,     /**< data was received */
+} sock_async_flags_t;
+
 /**
  * @brief   Abstract IP end point and end point for a raw IP sock object
  */
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_sock_async  Asynchronous sock API
+ * @ingroup     net_sock
+ * @brief       Serve many sock objects from a single event loop thread
+ *
+ * With the blocking @ref sock_udp_recv() and @ref sock_ip_recv(), an
+ * application needs a thread for every sock object it wants to receive on
+ * concurrently. Instead, one thread can run a @ref sock_async_loop_t and
+ * register a callback for each of its sock objects. When data arrives for a
+ * sock object, the network stack marks it as ready and wakes the loop thread
+ * with @ref SOCK_ASYNC_THREAD_FLAG. The loop then calls the callback of every
+ * ready sock object in its own thread.
+ *
+ * The callback should receive the data with a timeout of 0. Data it leaves
+ * waiting causes the callback to be called again in the next round of the
+ * loop.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _echo(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+ * {
+ *     sock_udp_ep_t remote;
+ *     ssize_t res;
+ *
+ *     (void)arg;
+ *     if (flags & SOCK_ASYNC_MSG_RECV) {
+ *         while ((res = sock_udp_recv(sock, buf, sizeof(buf), 0,
+ *                                     &remote)) >= 0) {
+ *             sock_udp_send(sock, buf, res, &remote);
+ *         }
+ *     }
+ * }
+ *
+ * int main(void)
+ * {
+ *     sock_async_loop_t loop;
+ *
+ *     sock_async_loop_init(&loop);
+ *     for (unsigned i = 0; i < SOCK_NUMOF; i++) {
+ *         local.port = 12345 + i;
+ *         sock_udp_create(&socks[i], &local, NULL, 0);
+ *         sock_udp_set_cb(&socks[i], &loop, _echo, NULL);
+ *     }
+ *     sock_async_loop_run(&loop);
+ *     return 0;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The implementation for @ref net_gnrc "GNRC" is called `gnrc_sock_async`.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Asynchronous sock API definitions
+ */
+#ifndef NET_SOCK_ASYNC_H
+#define NET_SOCK_ASYNC_H
+
+#include "net/sock.h"
+#include "net/sock/ip.h"
+#include "net/sock/udp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag the loop thread is woken up with
+ */
+#ifndef SOCK_ASYNC_THREAD_FLAG
+#define SOCK_ASYNC_THREAD_FLAG  (0x1 << 12)
+#endif
+
+/**
+ * @brief   Type for an event loop for sock objects
+ *
+ * @note    API implementors: `struct sock_async_loop` needs to be defined by
+ *          implementation-specific `sock_types.h`.
+ */
+typedef struct sock_async_loop sock_async_loop_t;
+
+/**
+ * @brief   Callback for a raw IPv4/IPv6 sock object
+ *
+ * @param[in] sock  The sock object the event occurred on.
+ * @param[in] flags The events that occurred.
+ * @param[in] arg   Argument given to @ref sock_ip_set_cb().
+ */
+typedef void (*sock_ip_cb_t)(sock_ip_t *sock, sock_async_flags_t flags,
+                             void *arg);
+
+/**
+ * @brief   Callback for a UDP sock object
+ *
+ * @param[in] sock  The sock object the event occurred on.
+ * @param[in] flags The events that occurred.
+ * @param[in] arg   Argument given to @ref sock_udp_set_cb().
+ */
+typedef void (*sock_udp_cb_t)(sock_udp_t *sock, sock_async_flags_t flags,
+                              void *arg);
+
+/**
+ * @brief   Initializes an event loop for the calling thread
+ *
+ * @pre `(loop != NULL)`
+ *
+ * @param[out] loop     An event loop.
+ */
+void sock_async_loop_init(sock_async_loop_t *loop);
+
+/**
+ * @brief   Calls the callbacks of all sock objects that are ready
+ *
+ * Does not block. Must be called by the thread that initialized @p loop,
+ * e.g. after it was woken up with @ref SOCK_ASYNC_THREAD_FLAG while it waits
+ * for other thread flags as well.
+ *
+ * @pre `(loop != NULL)`
+ *
+ * @param[in] loop      An event loop.
+ *
+ * @return  The number of callbacks called.
+ */
+unsigned sock_async_loop_dispatch(sock_async_loop_t *loop);
+
+/**
+ * @brief   Runs an event loop forever
+ *
+ * Must be called by the thread that initialized @p loop.
+ *
+ * @pre `(loop != NULL)`
+ *
+ * @param[in] loop      An event loop.
+ */
+void sock_async_loop_run(sock_async_loop_t *loop);
+
+/**
+ * @brief   Sets the callback of a raw IPv4/IPv6 sock object
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] loop      The event loop to call @p cb in.
+ * @param[in] cb        The callback. May be `NULL` to remove the callback of
+ *                      @p sock.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_ip_set_cb(sock_ip_t *sock, sock_async_loop_t *loop, sock_ip_cb_t cb,
+                    void *cb_arg);
+
+/**
+ * @brief   Sets the callback of a UDP sock object
+ *
+ * If @p sock is not bound yet, the callback is called once @p sock is bound
+ * implicitly by @ref sock_udp_send() and data arrives.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] loop      The event loop to call @p cb in.
+ * @param[in] cb        The callback. May be `NULL` to remove the callback of
+ *                      @p sock.
+ * @param[in] cb_arg    Argument for @p cb.
+ */
+void sock_udp_set_cb(sock_udp_t *sock, sock_async_loop_t *loop,
+                     sock_udp_cb_t cb, void *cb_arg);
+
+#include "sock_types.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_SOCK_ASYNC_H */
+/** @} */
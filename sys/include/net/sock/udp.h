@@ -289,6 +289,22 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   A UDP message for @ref sock_udp_recv_many() and
+ *          @ref sock_udp_send_many()
+ */
+typedef struct {
+    void *data;             /**< data of the message */
+    size_t len;             /**< length of sock_udp_msg_t::data. For
+                             *   @ref sock_udp_recv_many() the space available
+                             *   at sock_udp_msg_t::data on input and the
+                             *   number of bytes received on output */
+    sock_udp_ep_t *remote;  /**< remote end point of the message.
+                             *   May be `NULL` (see `remote` parameter of
+                             *   @ref sock_udp_recv() and
+                             *   @ref sock_udp_send()) */
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -433,6 +449,100 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives multiple UDP messages from remote end points
+ *
+ * Waits according to @p timeout for the first message only and then drains
+ * all messages that are already waiting for @p sock, until @p msgs is full.
+ * Apart from that, every message is received as with @ref sock_udp_recv().
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (num > 0)`
+ * @pre `(msgs[i].data != NULL) && (msgs[i].len > 0)` for all `i < num`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Messages to store the received data in.
+ *                      sock_udp_msg_t::len is set to the number of bytes
+ *                      received for every message received.
+ * @param[in] num       Number of messages in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ *
+ * @return  The number of messages received on success. Receiving stops at
+ *          the first error after at least one message was received, the
+ *          message that caused the error is lost.
+ * @return  Any error of @ref sock_udp_recv(), if no message was received.
+ */
+ssize_t sock_udp_recv_many(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                           unsigned num, uint32_t timeout);
+
+/**
+ * @brief   Receives a UDP message from a remote end point without copying
+ *
+ * The data stays in the buffer of the network stack until it is released
+ * with @ref sock_udp_recv_buf_free(). Apart from that, this function behaves
+ * like @ref sock_udp_recv().
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the received data.
+ * @param[out] buf_ctx  Stack-internal buffer context of @p data. Must be
+ *                      passed to @ref sock_udp_recv_buf_free() when @p data
+ *                      is not needed anymore.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @return  The number of bytes received on success. @p data and @p buf_ctx
+ *          are only set on success.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -ENOBUFS, if the received data is not stored contiguously by the
+ *          network stack.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
+/**
+ * @brief   Releases data received with @ref sock_udp_recv_buf()
+ *
+ * @pre `(buf_ctx != NULL)`
+ *
+ * @param[in] buf_ctx   Buffer context returned by @ref sock_udp_recv_buf().
+ */
+void sock_udp_recv_buf_free(void *buf_ctx);
+
+/**
+ * @brief   Sends multiple UDP messages to remote end points
+ *
+ * Every message is sent as with @ref sock_udp_send(), but the end points may
+ * only be checked once for consecutive messages with the same
+ * sock_udp_msg_t::remote.
+ *
+ * @pre `((sock != NULL) || (msgs[i].remote != NULL))` for all `i < num`
+ * @pre `(msgs[i].len == 0) || (msgs[i].data != NULL)` for all `i < num`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ * @param[in] msgs      Messages to send.
+ * @param[in] num       Number of messages in @p msgs.
+ *
+ * @return  The number of messages sent on success. Sending stops at the
+ *          first error after at least one message was sent.
+ * @return  Any error of @ref sock_udp_send(), if no message was sent.
+ */
+ssize_t sock_udp_send_many(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                           unsigned num);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
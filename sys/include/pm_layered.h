@@ -25,6 +25,12 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * CPUs whose low power modes are expensive to enter or leave may define
+ * PM_MIN_IDLE_US. With the `xtimer_slack` module, the idle thread then only
+ * selects a mode if the next xtimer wakeup is far enough away. Timers set
+ * with xtimer_set_slack() are expired together, which leaves longer idle
+ * periods for the deeper modes.
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -42,6 +48,16 @@
  extern "C" {
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief   Minimum idle time in microseconds per power mode
+ *
+ * Initializer for an array of PM_NUM_MODES entries, lowest power mode first.
+ * Only evaluated with the `xtimer_slack` module.
+ */
+#define PM_MIN_IDLE_US
+#endif
+
 /**
  * @brief   Block a power mode
  *
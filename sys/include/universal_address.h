@@ -11,6 +11,11 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * Containers are looked up by a linear scan over all entries. With the
+ * `universal_address_hash` module an open addressing hash index and a stack
+ * of unused containers are kept, so adding, finding and removing an address
+ * take constant time on average.
+ *
  * @{
  *
  * @file
@@ -20,6 +20,11 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the `xtimer_wheel` module, timers are kept in a hierarchical timing
+ * wheel instead, so insertion and removal take constant time regardless of
+ * the number of active timers. Only timers expiring within the next
+ * XTIMER_WHEEL_SLOTS wheel slots are kept in a sorted list.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,6 +79,10 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may fire late, see
+                                      xtimer_set_slack() */
+#endif
 } xtimer_t;
 
 /**
@@ -291,6 +300,38 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief Set a timer that may fire late by up to @p slack microseconds
+ *
+ * Behaves like xtimer_set(), but the callback may be executed anywhere
+ * between @p offset and @p offset + @p slack microseconds from now. xtimer
+ * uses this to expire timers whose windows overlap from a single low-level
+ * timer interrupt, which saves wakeups for periodic tasks that don't need
+ * exact timing.
+ *
+ * Timers set with any other xtimer function have no slack. With the
+ * `xtimer_wheel` backend, the slack is ignored.
+ *
+ * @param[in] timer     the timer structure to use, see xtimer_set()
+ * @param[in] offset    time in microseconds from now specifying the
+ *                      earliest execution time of the callback
+ * @param[in] slack     time in microseconds the execution may be delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
+/**
+ * @brief Get the time until the low-level timer wakes up xtimer next
+ *
+ * Meant for power management, to decide whether an idle period is long enough
+ * for a deep sleep mode.
+ *
+ * @return  ticks until the next xtimer interrupt
+ */
+xtimer_ticks32_t xtimer_time_to_wakeup(void);
+#endif
+
 /**
  * @brief remove a timer
  *
@@ -580,6 +621,39 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_HZ 1000000ul
 #endif
 
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+#ifndef XTIMER_WHEEL_SHIFT
+/**
+ * @brief   log2 of the number of ticks covered by a slot of the innermost
+ *          timing wheel
+ */
+#define XTIMER_WHEEL_SHIFT  (10)
+#endif
+
+/**
+ * @brief   log2 of the number of slots per timing wheel
+ *
+ * Fixed, as the occupied slots of a wheel are tracked in a 16 bit mask.
+ */
+#define XTIMER_WHEEL_BITS   (4)
+
+/**
+ * @brief   Number of slots per timing wheel
+ */
+#define XTIMER_WHEEL_SLOTS  (1U << XTIMER_WHEEL_BITS)
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of timing wheels
+ *
+ * Each wheel covers XTIMER_WHEEL_SLOTS times the range of the one below.
+ * Timers further in the future than the outermost wheel covers are kept in
+ * an unsorted list that is revisited whenever the outermost wheel advances.
+ */
+#define XTIMER_WHEEL_LEVELS (5)
+#endif
+#endif /* MODULE_XTIMER_WHEEL */
+
 #include "xtimer/tick_conversion.h"
 
 #include "xtimer/implementation.h"
@@ -69,6 +69,9 @@ void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_
 void _xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
 void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
+#endif
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t ticks);
 int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
 
@@ -216,6 +219,15 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
     _xtimer_set(timer, _xtimer_ticks_from_usec(offset));
 }
 
+#ifdef MODULE_XTIMER_SLACK
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack)
+{
+    _xtimer_set_slack(timer, _xtimer_ticks_from_usec(offset),
+                      _xtimer_ticks_from_usec(slack));
+}
+#endif
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
@@ -22,6 +22,12 @@
 #include "net/gcoap.h"
 #include "random.h"
 #include "thread.h"
+#ifdef MODULE_GCOAP_ASYNC
+#include "irq.h"
+#include "mutex.h"
+#include "net/sock/async.h"
+#include "thread_flags.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -29,16 +35,36 @@
 /** @brief Stack size for module thread */
 #define GCOAP_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 
+#ifdef MODULE_GCOAP_ASYNC
+/** @brief Thread flag set when a response timer expired */
+#define TFLAGS_TIMEOUT   (0x0001)
+
+#if (GCOAP_MEMO_BUCKETS & (GCOAP_MEMO_BUCKETS - 1)) != 0
+#error "GCOAP_MEMO_BUCKETS must be a power of two"
+#endif
+#endif
+
 /* Internal functions */
 static void *_event_loop(void *arg);
-static void _listen(sock_udp_t *sock);
+static ssize_t _listen(sock_udp_t *sock);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
 static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static void _generate_token(uint8_t *token, size_t len);
+#ifdef MODULE_GCOAP_ASYNC
+static void _on_sock(sock_udp_t *sock, sock_async_flags_t flags, void *arg);
+static void _on_timeout(void *arg);
+static void _expire_requests(void);
+static gcoap_request_memo_t *_take_req_memo(coap_pkt_t *pdu, unsigned state);
+static void _free_req_memo(gcoap_request_memo_t *memo);
+static size_t _req_send_async(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                                                gcoap_resp_handler_t resp_handler);
+#else
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -59,14 +85,28 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 static sock_udp_t _sock;
 
+#ifdef MODULE_GCOAP_ASYNC
+static thread_t *_thread;
+static sock_async_loop_t _loop;
+/* protects the memo buckets, the unused memos and the buffer pool */
+static mutex_t _lock = MUTEX_INIT;
+static uint8_t _pdu_bufs[GCOAP_PDU_BUF_NUMOF][GCOAP_PDU_BUF_SIZE];
+static uint8_t _pdu_bufs_free[GCOAP_PDU_BUF_NUMOF];   /* stack of indexes */
+static unsigned _pdu_bufs_free_numof;
+#endif
+
 
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
+#ifndef MODULE_GCOAP_ASYNC
     msg_t msg_rcvd, msg_queue[GCOAP_MSG_QUEUE_SIZE];
+#endif
     (void)arg;
 
+#ifndef MODULE_GCOAP_ASYNC
     msg_init_queue(msg_queue, GCOAP_MSG_QUEUE_SIZE);
+#endif
 
     sock_udp_ep_t local;
     memset(&local, 0, sizeof(sock_udp_ep_t));
@@ -80,6 +120,22 @@ static void *_event_loop(void *arg)
         return 0;
     }
 
+#ifdef MODULE_GCOAP_ASYNC
+    /* sleep until a datagram arrives or a response timer expires */
+    sock_async_loop_init(&_loop);
+    sock_udp_set_cb(&_sock, &_loop, _on_sock, NULL);
+    while (1) {
+        thread_flags_t flags = thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG |
+                                                     TFLAGS_TIMEOUT);
+
+        if (flags & SOCK_ASYNC_THREAD_FLAG) {
+            sock_async_loop_dispatch(&_loop);
+        }
+        if (flags & TFLAGS_TIMEOUT) {
+            _expire_requests();
+        }
+    }
+#else
     while(1) {
         res = msg_try_receive(&msg_rcvd);
 
@@ -98,38 +154,59 @@ static void *_event_loop(void *arg)
 
         _listen(&_sock);
     }
+#endif
 
     return 0;
 }
 
-/* Listen for an incoming CoAP message. */
-static void _listen(sock_udp_t *sock)
+#ifdef MODULE_GCOAP_ASYNC
+/* Called by the event loop when the sock has data. */
+static void _on_sock(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    (void)flags;
+    (void)arg;
+
+    /* drain the mailbox; the loop calls again for data left after an error */
+    while (_listen(sock) > 0) {}
+}
+#endif
+
+/*
+ * Listen for an incoming CoAP message.
+ *
+ * Returns the length of the received datagram, or <= 0 if none was received.
+ */
+static ssize_t _listen(sock_udp_t *sock)
 {
     coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
     sock_udp_ep_t remote;
     gcoap_request_memo_t *memo = NULL;
+#ifdef MODULE_GCOAP_ASYNC
+    /* only called when data is available, so never block */
+    uint32_t timeout = 0;
+#else
     uint8_t open_reqs;
 
     gcoap_op_state(&open_reqs);
+    uint32_t timeout = open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT;
+#endif
 
-    ssize_t res = sock_udp_recv(sock, buf, sizeof(buf),
-                                open_reqs > 0 ? GCOAP_RECV_TIMEOUT : SOCK_NO_TIMEOUT,
-                                &remote);
-    if (res <= 0) {
+    ssize_t len = sock_udp_recv(sock, buf, sizeof(buf), timeout, &remote);
+    if (len <= 0) {
 #if ENABLE_DEBUG
-        if (res < 0 && res != -ETIMEDOUT) {
-            DEBUG("gcoap: udp recv failure: %d\n", res);
+        if (len < 0 && len != -ETIMEDOUT && len != -EAGAIN) {
+            DEBUG("gcoap: udp recv failure: %d\n", (int)len);
         }
 #endif
-        return;
+        return len;
     }
 
-    res = coap_parse(&pdu, buf, res);
+    ssize_t res = coap_parse(&pdu, buf, len);
     if (res < 0) {
-        DEBUG("gcoap: parse failure: %d\n", res);
+        DEBUG("gcoap: parse failure: %d\n", (int)res);
         /* If a response, can't clear memo, but it will timeout later. */
-        return;
+        return len;
     }
 
     /* incoming request */
@@ -141,13 +218,22 @@ static void _listen(sock_udp_t *sock)
     }
     /* incoming response */
     else {
+#ifdef MODULE_GCOAP_ASYNC
+        memo = _take_req_memo(&pdu, GCOAP_MEMO_RESP);
+        if (memo) {
+            memo->resp_handler(memo->state, &pdu);
+            _free_req_memo(memo);
+        }
+#else
         _find_req_memo(&memo, &pdu, buf, sizeof(buf));
         if (memo) {
             xtimer_remove(&memo->response_timer);
             memo->resp_handler(memo->state, &pdu);
             memo->state = GCOAP_MEMO_UNUSED;
         }
+#endif
     }
+    return len;
 }
 
 /*
@@ -217,6 +303,250 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     }
 }
 
+/* Fills a token with random bytes. */
+static void _generate_token(uint8_t *token, size_t len)
+{
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t rand = random_uint32();
+        memcpy(&token[i],
+               &rand,
+               (len - i >= 4) ? 4 : len - i);
+    }
+}
+
+#ifdef MODULE_GCOAP_ASYNC
+/* Returns the index of a buffer in the pool, or -1 if it is not from there. */
+static int _pdu_buf_index(const uint8_t *buf)
+{
+    uintptr_t offset = (uintptr_t)buf - (uintptr_t)&_pdu_bufs[0][0];
+
+    if ((offset >= sizeof(_pdu_bufs)) || (offset % GCOAP_PDU_BUF_SIZE)) {
+        return -1;
+    }
+    return offset / GCOAP_PDU_BUF_SIZE;
+}
+
+/* Returns the bucket for a token. Tokens are random, so a simple hash does. */
+static gcoap_request_memo_t **_memo_bucket(const uint8_t *token, unsigned len)
+{
+    unsigned hash = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        hash = (hash * 31) + token[i];
+    }
+    return &_coap_state.memo_buckets[hash & (GCOAP_MEMO_BUCKETS - 1)];
+}
+
+/* Returns the request header of a memo. */
+static inline coap_hdr_t *_memo_hdr(gcoap_request_memo_t *memo)
+{
+    return (coap_hdr_t *)((memo->pdu_buf) ? memo->pdu_buf : &memo->hdr_buf[0]);
+}
+
+/*
+ * Finds the link to the memo for a token within its bucket. The link points
+ * to NULL if no open request uses the token. Caller must hold _lock.
+ */
+static gcoap_request_memo_t **_memo_link(const uint8_t *token, unsigned len)
+{
+    gcoap_request_memo_t **link = _memo_bucket(token, len);
+
+    while (*link) {
+        coap_pkt_t memo_pdu = { .hdr = _memo_hdr(*link) };
+
+        if ((coap_get_token_len(&memo_pdu) == len) &&
+            (memcmp(&memo_pdu.hdr->data[0], token, len) == 0)) {
+            break;
+        }
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+/*
+ * Adds a memo to the bucket for the token of the request in buf. Replaces the
+ * token first, if another open request uses it. Caller must hold _lock.
+ */
+static void _link_req_memo(gcoap_request_memo_t *memo, uint8_t *buf)
+{
+    coap_pkt_t req = { .hdr = (coap_hdr_t *)buf };
+    unsigned len = coap_get_token_len(&req);
+    uint8_t *token = &req.hdr->data[0];
+    gcoap_request_memo_t **link;
+
+    if (len > 0) {
+        while (*_memo_link(token, len)) {
+            _generate_token(token, len);
+        }
+    }
+    if (!memo->pdu_buf) {
+        memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
+    }
+
+    link = _memo_bucket(token, len);
+    while (*link) {
+        link = &(*link)->next;
+    }
+    memo->next = NULL;
+    *link = memo;
+}
+
+/* Removes a memo from its bucket. Caller must hold _lock. */
+static void _unlink_req_memo(gcoap_request_memo_t *memo)
+{
+    coap_pkt_t memo_pdu = { .hdr = _memo_hdr(memo) };
+    gcoap_request_memo_t **link = _memo_bucket(&memo_pdu.hdr->data[0],
+                                               coap_get_token_len(&memo_pdu));
+
+    while (*link != memo) {
+        link = &(*link)->next;
+    }
+    *link = memo->next;
+}
+
+/*
+ * Takes the memo for the token of a response out of its bucket and sets its
+ * state. Returns NULL if no request waits for the token (anymore).
+ */
+static gcoap_request_memo_t *_take_req_memo(coap_pkt_t *pdu, unsigned state)
+{
+    gcoap_request_memo_t **link, *memo;
+
+    mutex_lock(&_lock);
+    link = _memo_link(pdu->token, coap_get_token_len(pdu));
+    memo = *link;
+    if (memo) {
+        /* the response timer may have expired meanwhile */
+        unsigned irq_state = irq_disable();
+        if (memo->state == GCOAP_MEMO_WAIT) {
+            memo->state = state;
+            *link = memo->next;
+        }
+        else {
+            memo = NULL;
+        }
+        irq_restore(irq_state);
+    }
+    mutex_unlock(&_lock);
+
+    if (memo) {
+        xtimer_remove(&memo->response_timer);
+    }
+    return memo;
+}
+
+/* Makes a memo, which is in no bucket anymore, and its buffer available. */
+static void _free_req_memo(gcoap_request_memo_t *memo)
+{
+    mutex_lock(&_lock);
+    if (memo->pdu_buf) {
+        _pdu_bufs_free[_pdu_bufs_free_numof++] = _pdu_buf_index(memo->pdu_buf);
+        memo->pdu_buf = NULL;
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+    memo->generation++;
+    memo->next = _coap_state.free_reqs;
+    _coap_state.free_reqs = memo;
+    mutex_unlock(&_lock);
+}
+
+/* Response timer callback, runs in interrupt context. */
+static void _on_timeout(void *arg)
+{
+    gcoap_request_memo_t *memo = (gcoap_request_memo_t *)arg;
+
+    if (memo->state == GCOAP_MEMO_WAIT) {
+        memo->state = GCOAP_MEMO_TIMEOUT;
+        thread_flags_set(_thread, TFLAGS_TIMEOUT);
+    }
+}
+
+/* Calls the handler of every request for which the response timer expired. */
+static void _expire_requests(void)
+{
+    coap_pkt_t req;
+
+    DEBUG("coap: response timer expired\n");
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+
+        /* only this thread changes the state of an expired memo */
+        if (memo->state != GCOAP_MEMO_TIMEOUT) {
+            continue;
+        }
+        mutex_lock(&_lock);
+        _unlink_req_memo(memo);
+        mutex_unlock(&_lock);
+
+        /* Pass request to handler, for reference */
+        req.hdr = _memo_hdr(memo);
+        memo->resp_handler(memo->state, &req);
+        _free_req_memo(memo);
+    }
+}
+
+static size_t _req_send_async(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                                                gcoap_resp_handler_t resp_handler)
+{
+    gcoap_request_memo_t *memo;
+    int pool_index = _pdu_buf_index(buf);
+    uint16_t generation;
+    bool waiting;
+
+    mutex_lock(&_lock);
+    memo = _coap_state.free_reqs;
+    if (!memo) {
+        if (pool_index >= 0) {
+            _pdu_bufs_free[_pdu_bufs_free_numof++] = pool_index;
+        }
+        mutex_unlock(&_lock);
+        DEBUG("gcoap: dropping request; no space for response tracking\n");
+        return 0;
+    }
+    _coap_state.free_reqs = memo->next;
+    memo->state        = GCOAP_MEMO_WAIT;
+    memo->resp_handler = resp_handler;
+    memo->pdu_buf      = (pool_index >= 0) ? buf : NULL;
+    _link_req_memo(memo, buf);
+    /* the response may be handled and the memo reused by another request
+     * while the request is sent, so its state alone does not tell */
+    generation = memo->generation;
+    mutex_unlock(&_lock);
+
+    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
+    if (res <= 0) {
+        DEBUG("gcoap: sock send failed: %d\n", (int)res);
+        /* no timer runs yet, so the failure is only reported to the caller */
+        mutex_lock(&_lock);
+        waiting = (memo->generation == generation) &&
+                  (memo->state == GCOAP_MEMO_WAIT);
+        if (waiting) {
+            memo->state = GCOAP_MEMO_ERR;
+            _unlink_req_memo(memo);
+        }
+        mutex_unlock(&_lock);
+        if (waiting) {
+            _free_req_memo(memo);
+        }
+        return 0;
+    }
+
+    /* Start the response wait timer, unless the response was handled already.
+     * _take_req_memo() needs _lock as well, so it removes the timer if the
+     * response arrives from now on. */
+    if (GCOAP_NON_TIMEOUT > 0) {
+        mutex_lock(&_lock);
+        if ((memo->generation == generation) &&
+            (memo->state == GCOAP_MEMO_WAIT)) {
+            memo->response_timer.callback = _on_timeout;
+            memo->response_timer.arg      = memo;
+            xtimer_set(&memo->response_timer, GCOAP_NON_TIMEOUT);
+        }
+        mutex_unlock(&_lock);
+    }
+    return res;
+}
+#else
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
  * array. Matches on token.
@@ -279,6 +609,7 @@ static void _expire_request(gcoap_request_memo_t *memo)
         /* was in queue. */
     }
 }
+#endif
 
 /*
  * Handler for /.well-known/core. Lists registered handlers, except for
@@ -366,14 +697,30 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
-    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
-                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
     /* Blank list of open requests so we know if an entry is available. */
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
+#ifdef MODULE_GCOAP_ASYNC
+    memset(&_coap_state.memo_buckets[0], 0, sizeof(_coap_state.memo_buckets));
+    _coap_state.free_reqs = NULL;
+    for (int i = GCOAP_REQ_WAITING_MAX - 1; i >= 0; i--) {
+        _coap_state.open_reqs[i].next = _coap_state.free_reqs;
+        _coap_state.free_reqs = &_coap_state.open_reqs[i];
+    }
+    for (unsigned i = 0; i < GCOAP_PDU_BUF_NUMOF; i++) {
+        _pdu_bufs_free[i] = i;
+    }
+    _pdu_bufs_free_numof = GCOAP_PDU_BUF_NUMOF;
+#endif
     /* randomize initial value */
     _coap_state.last_message_id = random_uint32() & 0xFFFF;
 
+    _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
+                            THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
+#ifdef MODULE_GCOAP_ASYNC
+    _thread = (thread_t *)thread_get(_pid);
+#endif
+
     return _pid;
 }
 
@@ -398,12 +745,7 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
     memset(pdu->url, 0, NANOCOAP_URL_MAX);
 
     /* generate token */
-    for (size_t i = 0; i < GCOAP_TOKENLEN; i += 4) {
-        uint32_t rand = random_uint32();
-        memcpy(&token[i],
-               &rand,
-               (GCOAP_TOKENLEN - i >= 4) ? 4 : GCOAP_TOKENLEN - i);
-    }
+    _generate_token(&token[0], GCOAP_TOKENLEN);
     hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &token[0], GCOAP_TOKENLEN,
                                                      code,
                                                    ++_coap_state.last_message_id);
@@ -453,6 +795,12 @@ size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port
 size_t gcoap_req_send2(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
                                                  gcoap_resp_handler_t resp_handler)
 {
+#ifdef MODULE_GCOAP_ASYNC
+    assert(remote != NULL);
+    assert(resp_handler != NULL);
+
+    return _req_send_async(buf, len, remote, resp_handler);
+#else
     gcoap_request_memo_t *memo = NULL;
     assert(remote != NULL);
     assert(resp_handler != NULL);
@@ -497,6 +845,7 @@ size_t gcoap_req_send2(uint8_t *buf, size_t len, sock_udp_ep_t *remote,
         DEBUG("gcoap: dropping request; no space for response tracking\n");
         return 0;
     }
+#endif
 }
 
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
@@ -526,4 +875,28 @@ void gcoap_op_state(uint8_t *open_reqs)
     *open_reqs = count;
 }
 
+#ifdef MODULE_GCOAP_ASYNC
+uint8_t *gcoap_pdu_buf_alloc(void)
+{
+    uint8_t *buf = NULL;
+
+    mutex_lock(&_lock);
+    if (_pdu_bufs_free_numof > 0) {
+        buf = &_pdu_bufs[_pdu_bufs_free[--_pdu_bufs_free_numof]][0];
+    }
+    mutex_unlock(&_lock);
+    return buf;
+}
+
+void gcoap_pdu_buf_free(uint8_t *buf)
+{
+    int pool_index = _pdu_buf_index(buf);
+
+    assert(pool_index >= 0);
+    mutex_lock(&_lock);
+    _pdu_bufs_free[_pdu_bufs_free_numof++] = pool_index;
+    mutex_unlock(&_lock);
+}
+#endif
+
 /** @} */
@@ -20,6 +20,7 @@
 
 #include <string.h>
 
+#include "irq.h"
 #include "log.h"
 #include "mutex.h"
 #include "sched.h"
@@ -40,6 +41,9 @@
 #define TFLAGS_RESP         (0x0001)
 #define TFLAGS_TIMEOUT      (0x0002)
 #define TFLAGS_ANY          (TFLAGS_RESP | TFLAGS_TIMEOUT)
+#define TFLAGS_BATCH        (0x0004)
+
+#define ASYNC_FREE          (0x00)      /* no ADVERTISE is ever waited for */
 
 
 static const char *cli_id;
@@ -59,6 +63,38 @@ static volatile uint8_t waiton = 0xff;
 static volatile uint16_t waitonid = 0;
 static volatile int result;
 
+#ifdef MODULE_EMCUTE_ASYNC
+/**
+ * @brief   Message waiting for its acknowledgment in the in-flight window
+ */
+typedef struct {
+    emcute_topic_t *topic;      /**< topic of the message */
+    emcute_done_cb_t cb;        /**< completion callback */
+    void *arg;                  /**< argument of the callback */
+    uint32_t sent;              /**< time of the last transmission */
+    size_t len;                 /**< length of the message */
+    uint16_t id;                /**< message ID */
+    uint8_t resp;               /**< expected response, ASYNC_FREE if unused */
+    uint8_t tries;              /**< number of transmissions */
+    uint8_t buf[EMCUTE_ASYNC_BUFSIZE];  /**< the message, for retransmissions */
+} async_msg_t;
+
+/**
+ * @brief   State of emcute_reg_batch()
+ */
+typedef struct {
+    thread_t *thread;           /**< thread waiting for the registrations */
+    unsigned pending;           /**< registrations not completed yet */
+    int res;                    /**< first error */
+} batch_t;
+
+static async_msg_t async_msgs[EMCUTE_ASYNC_WINDOW];
+static unsigned async_numof = 0;
+static mutex_t asynclock;
+/* locked while the window is full or a message is being added */
+static mutex_t windowlock;
+#endif
+
 static inline uint16_t get_u16(const uint8_t *buf)
 {
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
@@ -87,7 +123,7 @@ static int set_len(uint8_t *buf, size_t len)
     }
     else {
         buf[0] = 0x01;
-        set_u16(&tbuf[1], (uint16_t)(len + 3));
+        set_u16(&buf[1], (uint16_t)(len + 3));
         return 3;
     }
 }
@@ -104,6 +140,14 @@ static int get_len(uint8_t *buf, uint16_t *len)
     }
 }
 
+static uint16_t next_id(void)
+{
+    unsigned state = irq_disable();
+    uint16_t id = id_next++;
+    irq_restore(state);
+    return id;
+}
+
 static void time_evt(void *arg)
 {
     thread_flags_set((thread_t *)arg, TFLAGS_TIMEOUT);
@@ -140,29 +184,193 @@ static int syncsend(uint8_t resp, size_t len, bool unlock)
     return res;
 }
 
+#ifdef MODULE_EMCUTE_ASYNC
+/* takes a free message from the window, returns with asynclock held */
+static async_msg_t *async_alloc(void)
+{
+    async_msg_t *msg = NULL;
+
+    mutex_lock(&windowlock);
+    mutex_lock(&asynclock);
+    for (unsigned i = 0; i < EMCUTE_ASYNC_WINDOW; i++) {
+        if (async_msgs[i].resp == ASYNC_FREE) {
+            msg = &async_msgs[i];
+            break;
+        }
+    }
+    assert(msg);
+    if (++async_numof < EMCUTE_ASYNC_WINDOW) {
+        mutex_unlock(&windowlock);
+    }
+    msg->id = next_id();
+    return msg;
+}
+
+/* asynclock must be held */
+static void async_release(async_msg_t *msg)
+{
+    msg->resp = ASYNC_FREE;
+    if (async_numof-- == EMCUTE_ASYNC_WINDOW) {
+        mutex_unlock(&windowlock);
+    }
+}
+
+/* sends a message taken by async_alloc() and releases asynclock */
+static int async_start(async_msg_t *msg, uint8_t resp, emcute_topic_t *topic,
+                       emcute_done_cb_t cb, void *arg)
+{
+    if (gateway.port == 0) {
+        async_release(msg);
+        mutex_unlock(&asynclock);
+        return EMCUTE_NOGW;
+    }
+
+    msg->topic = topic;
+    msg->cb = cb;
+    msg->arg = arg;
+    msg->resp = resp;
+    msg->tries = 1;
+    msg->sent = xtimer_now_usec();
+    sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+    mutex_unlock(&asynclock);
+    return EMCUTE_OK;
+}
+
+/* releases the message and calls its callback, asynclock must be held */
+static void async_finish(async_msg_t *msg, int res)
+{
+    emcute_topic_t *topic = msg->topic;
+    emcute_done_cb_t cb = msg->cb;
+    void *arg = msg->arg;
+
+    if (res > 0) {
+        /* REGACK carries the topic ID */
+        topic->id = (uint16_t)res;
+        res = EMCUTE_OK;
+    }
+    async_release(msg);
+
+    if (cb) {
+        mutex_unlock(&asynclock);
+        cb(topic, res, arg);
+        mutex_lock(&asynclock);
+    }
+}
+
+static void async_flush(int res)
+{
+    mutex_lock(&asynclock);
+    for (unsigned i = 0; i < EMCUTE_ASYNC_WINDOW; i++) {
+        if (async_msgs[i].resp != ASYNC_FREE) {
+            async_finish(&async_msgs[i], res);
+        }
+    }
+    mutex_unlock(&asynclock);
+}
+
+/* retransmits or times out unacknowledged messages, returns the time until
+ * the next retransmission is due */
+static uint32_t async_retry(void)
+{
+    uint32_t t_next = (EMCUTE_T_RETRY * US_PER_SEC);
+
+    mutex_lock(&asynclock);
+    for (unsigned i = 0; i < EMCUTE_ASYNC_WINDOW; i++) {
+        async_msg_t *msg = &async_msgs[i];
+
+        if (msg->resp == ASYNC_FREE) {
+            continue;
+        }
+        /* read per message: async_finish() drops the lock for the callback, which
+         * may send new messages meanwhile */
+        uint32_t now = xtimer_now_usec();
+        uint32_t t_wait = (now - msg->sent);
+
+        if (t_wait >= (EMCUTE_T_RETRY * US_PER_SEC)) {
+            if (msg->tries >= EMCUTE_N_RETRY) {
+                DEBUG("[emcute] async: message %u timed out\n", (unsigned)msg->id);
+                async_finish(msg, EMCUTE_TIMEOUT);
+                continue;
+            }
+            if (msg->resp == PUBACK) {
+                uint16_t len;
+                int pos = get_len(msg->buf, &len);
+                msg->buf[pos + 1] |= EMCUTE_DUP;
+            }
+            DEBUG("[emcute] async: resending message %u\n", (unsigned)msg->id);
+            sock_udp_send(&sock, msg->buf, msg->len, &gateway);
+            msg->tries++;
+            msg->sent = now;
+            t_wait = 0;
+        }
+        if (((EMCUTE_T_RETRY * US_PER_SEC) - t_wait) < t_next) {
+            t_next = (EMCUTE_T_RETRY * US_PER_SEC) - t_wait;
+        }
+    }
+    mutex_unlock(&asynclock);
+    return t_next;
+}
+
+static void on_async_ack(uint8_t type, uint16_t id, int res)
+{
+    mutex_lock(&asynclock);
+    for (unsigned i = 0; i < EMCUTE_ASYNC_WINDOW; i++) {
+        if ((async_msgs[i].resp == type) && (async_msgs[i].id == id)) {
+            async_finish(&async_msgs[i], res);
+            break;
+        }
+    }
+    mutex_unlock(&asynclock);
+}
+
+static void on_batch_done(emcute_topic_t *topic, int res, void *arg)
+{
+    batch_t *batch = (batch_t *)arg;
+    thread_t *thread = batch->thread;
+
+    (void)topic;
+    if ((res != EMCUTE_OK) && (batch->res == EMCUTE_OK)) {
+        batch->res = res;
+    }
+    /* the batch is gone as soon as the last registration completed */
+    unsigned state = irq_disable();
+    batch->pending--;
+    irq_restore(state);
+    thread_flags_set(thread, TFLAGS_BATCH);
+}
+#endif
+
 static void on_disconnect(void)
 {
     if (waiton == DISCONNECT) {
         gateway.port = 0;
         result = EMCUTE_OK;
         thread_flags_set((thread_t *)timer.arg, TFLAGS_RESP);
+#ifdef MODULE_EMCUTE_ASYNC
+        async_flush(EMCUTE_NOGW);
+#endif
+    }
+}
+
+static int ack_result(int ret_pos, int res_pos)
+{
+    if (ret_pos && (rbuf[ret_pos] != ACCEPT)) {
+        return EMCUTE_REJECT;
     }
+    return (res_pos == 0) ? EMCUTE_OK : (int)get_u16(&rbuf[res_pos]);
 }
 
 static void on_ack(uint8_t type, int id_pos, int ret_pos, int res_pos)
 {
     if ((waiton == type) && (!id_pos || (waitonid == get_u16(&rbuf[id_pos])))) {
-        if (!ret_pos || (rbuf[ret_pos] == ACCEPT)) {
-            if (res_pos == 0) {
-                result = EMCUTE_OK;
-            } else {
-                result = (int)get_u16(&rbuf[res_pos]);
-            }
-        } else {
-            result = EMCUTE_REJECT;
-        }
+        result = ack_result(ret_pos, res_pos);
         thread_flags_set((thread_t *)timer.arg, TFLAGS_RESP);
     }
+#ifdef MODULE_EMCUTE_ASYNC
+    else if (id_pos) {
+        on_async_ack(type, get_u16(&rbuf[id_pos]), ack_result(ret_pos, res_pos));
+    }
+#endif
 }
 
 static void on_publish(void)
@@ -325,8 +533,8 @@ int emcute_reg(emcute_topic_t *topic)
     tbuf[0] = (strlen(topic->name) + 6);
     tbuf[1] = REGISTER;
     set_u16(&tbuf[2], 0);
-    set_u16(&tbuf[4], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    set_u16(&tbuf[4], waitonid);
     memcpy(&tbuf[6], topic->name, strlen(topic->name));
 
     int res = syncsend(REGACK, (size_t)tbuf[0], true);
@@ -362,8 +570,8 @@ int emcute_pub(emcute_topic_t *topic, const void *data, size_t len,
     tbuf[pos++] = flags;
     set_u16(&tbuf[pos], topic->id);
     pos += 2;
-    set_u16(&tbuf[pos], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    set_u16(&tbuf[pos], waitonid);
     pos += 2;
     memcpy(&tbuf[pos], data, len);
 
@@ -394,8 +602,8 @@ int emcute_sub(emcute_sub_t *sub, unsigned flags)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = SUBSCRIBE;
     tbuf[2] = flags;
-    set_u16(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    set_u16(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(SUBACK, (size_t)tbuf[0], false);
@@ -430,8 +638,8 @@ int emcute_unsub(emcute_sub_t *sub)
     tbuf[0] = (strlen(sub->topic.name) + 5);
     tbuf[1] = UNSUBSCRIBE;
     tbuf[2] = 0;
-    set_u16(&tbuf[3], id_next);
-    waitonid = id_next++;
+    waitonid = next_id();
+    set_u16(&tbuf[3], waitonid);
     memcpy(&tbuf[5], sub->topic.name, strlen(sub->topic.name));
 
     int res = syncsend(UNSUBACK, (size_t)tbuf[0], false);
@@ -454,6 +662,102 @@ int emcute_unsub(emcute_sub_t *sub)
     return res;
 }
 
+#ifdef MODULE_EMCUTE_ASYNC
+int emcute_reg_async(emcute_topic_t *topic, emcute_done_cb_t cb, void *arg)
+{
+    assert(topic && topic->name);
+
+    size_t len = strlen(topic->name);
+
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if ((len > EMCUTE_TOPIC_MAXLEN) || ((len + 6) > EMCUTE_ASYNC_BUFSIZE)) {
+        return EMCUTE_OVERFLOW;
+    }
+
+    async_msg_t *msg = async_alloc();
+
+    msg->len = (len + 6);
+    msg->buf[0] = (uint8_t)msg->len;
+    msg->buf[1] = REGISTER;
+    set_u16(&msg->buf[2], 0);
+    set_u16(&msg->buf[4], msg->id);
+    memcpy(&msg->buf[6], topic->name, len);
+
+    return async_start(msg, REGACK, topic, cb, arg);
+}
+
+int emcute_reg_batch(emcute_topic_t *topics, size_t numof)
+{
+    batch_t batch = { .thread = (thread_t *)sched_active_thread, .pending = 0,
+                      .res = EMCUTE_OK };
+
+    thread_flags_clear(TFLAGS_BATCH);
+    for (size_t i = 0; i < numof; i++) {
+        unsigned state = irq_disable();
+        batch.pending++;
+        irq_restore(state);
+
+        int res = emcute_reg_async(&topics[i], on_batch_done, &batch);
+        if (res != EMCUTE_OK) {
+            state = irq_disable();
+            batch.pending--;
+            if (batch.res == EMCUTE_OK) {
+                batch.res = res;
+            }
+            irq_restore(state);
+            break;
+        }
+    }
+
+    while (1) {
+        unsigned state = irq_disable();
+        unsigned pending = batch.pending;
+        irq_restore(state);
+        if (pending == 0) {
+            break;
+        }
+        thread_flags_wait_any(TFLAGS_BATCH);
+    }
+    return batch.res;
+}
+
+int emcute_pub_async(emcute_topic_t *topic, const void *data, size_t len,
+                     unsigned flags, emcute_done_cb_t cb, void *arg)
+{
+    assert((topic->id != 0) && data && (len > 0) && !(flags & ~PUB_FLAGS));
+
+    if (!(flags & EMCUTE_QOS_MASK)) {
+        /* nothing to wait for */
+        return emcute_pub(topic, data, len, flags);
+    }
+    if (gateway.port == 0) {
+        return EMCUTE_NOGW;
+    }
+    if ((len + 9) > EMCUTE_ASYNC_BUFSIZE) {
+        return EMCUTE_OVERFLOW;
+    }
+    if (flags & EMCUTE_QOS_2) {
+        return EMCUTE_NOTSUP;
+    }
+
+    async_msg_t *msg = async_alloc();
+
+    int pos = set_len(msg->buf, (len + 6));
+    msg->len = (len + pos + 6);
+    msg->buf[pos++] = PUBLISH;
+    msg->buf[pos++] = flags;
+    set_u16(&msg->buf[pos], topic->id);
+    pos += 2;
+    set_u16(&msg->buf[pos], msg->id);
+    pos += 2;
+    memcpy(&msg->buf[pos], data, len);
+
+    return async_start(msg, PUBACK, topic, cb, arg);
+}
+#endif
+
 int emcute_willupd_topic(const char *topic, unsigned flags)
 {
     assert(!(flags & ~PUB_FLAGS));
@@ -512,6 +816,10 @@ void emcute_run(uint16_t port, const char *id)
     timer.callback = time_evt;
     timer.arg = NULL;
     mutex_init(&txlock);
+#ifdef MODULE_EMCUTE_ASYNC
+    mutex_init(&asynclock);
+    mutex_init(&windowlock);
+#endif
 
     if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
         LOG_ERROR("[emcute] unable to open UDP socket on port %i\n", (int)port);
@@ -564,5 +872,12 @@ void emcute_run(uint16_t port, const char *id)
         else {
             t_out = (EMCUTE_KEEPALIVE * US_PER_SEC) - (now - start);
         }
+#ifdef MODULE_EMCUTE_ASYNC
+        /* messages added while waiting are retransmitted at most T_RETRY late */
+        uint32_t t_retry = async_retry();
+        if (t_retry < t_out) {
+            t_out = t_retry;
+        }
+#endif
     }
 }
@@ -13,16 +13,81 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   32-bit word that may alias the checksummed buffer
+ */
+typedef uint32_t __attribute__((__may_alias__)) _word32_t;
+
+/**
+ * @brief   16-bit word that may alias the checksummed buffer
+ */
+typedef uint16_t __attribute__((__may_alias__)) _word16_t;
+
+/**
+ * @brief   Sums up @p buf as 16-bit words, reading 32 bits at a time
+ *
+ * The one's complement sum is independent of the byte order
+ * (RFC 1071, section 2 (B)), so the words are added in host byte order
+ * into a 64-bit accumulator and only the folded result is converted.
+ * A trailing odd byte is padded as the upper half of a word.
+ *
+ * @pre     @p buf is 16-bit aligned.
+ *
+ * @return  The unnormalized sum in host byte order.
+ */
+static uint16_t _sum(const uint8_t *buf, uint16_t len)
+{
+    uint64_t acc = 0;
+    const _word32_t *words;
+
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        acc += *((const _word16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    words = (const _word32_t *)buf;
+    while (len >= 16) {
+        acc += words[0];
+        acc += words[1];
+        acc += words[2];
+        acc += words[3];
+        words += 4;
+        len -= 16;
+    }
+    while (len >= 4) {
+        acc += *(words++);
+        len -= 4;
+    }
+    buf = (const uint8_t *)words;
+    if (len >= 2) {
+        acc += *((const _word16_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        acc += HTONS((uint16_t)(*buf << 8));
+    }
+
+    while (acc >> 16) {
+        acc = (acc & 0xffff) + (acc >> 16);
+    }
+    return NTOHS((uint16_t)acc);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint16_t part;
+    bool shifted = false;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -41,16 +106,19 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (((uintptr_t)buf & 1) && (len > 0)) {
+        /* add first byte as top half of 16-byte word, the words read from the
+         * now aligned buffer are shifted by one byte */
+        csum += (uint16_t)(*buf << 8);
+        buf++;
+        len--;
+        shifted = true;
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    part = _sum(buf, len);
+    csum += (shifted) ? byteorder_swaps(part) : part;
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
@@ -62,4 +130,11 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_buf,
+                          const uint8_t *new_buf, uint16_t len)
+{
+    return inet_csum_update16(csum, inet_csum(0, old_buf, len),
+                              inet_csum(0, new_buf, len));
+}
+
 /** @} */
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "msg.h"
 #include "thread.h"
@@ -29,6 +30,9 @@
 
 #include "net/gnrc/netdev.h"
 #include "net/ethernet/hdr.h"
+#ifdef MODULE_GNRC_NETDEV_TX_STATUS
+#include "irq.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -41,6 +45,60 @@
 
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
 
+#ifdef MODULE_GNRC_NETDEV_TX_STATUS
+static gnrc_netdev_tx_status_t *_tx_status_listeners;
+
+void gnrc_netdev_tx_status_register(gnrc_netdev_tx_status_t *listener)
+{
+    unsigned state = irq_disable();
+
+    listener->next = _tx_status_listeners;
+    _tx_status_listeners = listener;
+    irq_restore(state);
+}
+
+/**
+ * @brief   Remembers the destination of a frame, if it is a unicast frame
+ *
+ * @param[in] gnrc_netdev   the device the frame is sent with
+ * @param[in] pkt           the frame, starting with its netif header
+ */
+static void _record_tx_dst(gnrc_netdev_t *gnrc_netdev, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr = pkt->data;
+
+    gnrc_netdev->tx_dst_len = 0;
+    if ((pkt->type != GNRC_NETTYPE_NETIF) ||
+        (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) ||
+        (hdr->dst_l2addr_len > sizeof(gnrc_netdev->tx_dst))) {
+        return;
+    }
+    memcpy(gnrc_netdev->tx_dst, gnrc_netif_hdr_get_dst_addr(hdr), hdr->dst_l2addr_len);
+    gnrc_netdev->tx_dst_len = hdr->dst_l2addr_len;
+}
+
+/**
+ * @brief   Passes the result of a unicast transmission to the listeners
+ *
+ * @param[in] gnrc_netdev   the device that sent the frame
+ * @param[in] event         type of event
+ */
+static void _report_tx_status(gnrc_netdev_t *gnrc_netdev, netdev_event_t event)
+{
+    if ((gnrc_netdev->tx_dst_len == 0) ||
+        ((event != NETDEV_EVENT_TX_COMPLETE) && (event != NETDEV_EVENT_TX_NOACK))) {
+        return;
+    }
+    for (gnrc_netdev_tx_status_t *listener = _tx_status_listeners;
+         listener != NULL; listener = listener->next) {
+        listener->cb(gnrc_netdev->pid, gnrc_netdev->tx_dst,
+                     gnrc_netdev->tx_dst_len,
+                     (event == NETDEV_EVENT_TX_COMPLETE));
+    }
+    gnrc_netdev->tx_dst_len = 0;
+}
+#endif
+
 /**
  * @brief   Function called by the device driver on device events
  *
@@ -62,6 +120,9 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
     }
     else {
         DEBUG("gnrc_netdev: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETDEV_TX_STATUS
+        _report_tx_status(gnrc_netdev, event);
+#endif
         switch(event) {
             case NETDEV_EVENT_RX_COMPLETE:
                 {
@@ -143,6 +204,9 @@ static void *_gnrc_netdev_thread(void *args)
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 gnrc_pktsnip_t *pkt = msg.content.ptr;
+#ifdef MODULE_GNRC_NETDEV_TX_STATUS
+                _record_tx_dst(gnrc_netdev, pkt);
+#endif
                 gnrc_netdev->send(gnrc_netdev, pkt);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
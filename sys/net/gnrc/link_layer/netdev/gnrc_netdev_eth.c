@@ -18,6 +18,7 @@
 
 #include "net/gnrc.h"
 #include "net/gnrc/netdev.h"
+#include "net/netdev/eth.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -29,6 +30,16 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief   Headroom in front of the received frame
+ *
+ * Packet buffer chunks are word aligned, so with this headroom the Ethernet
+ * header ends on a word boundary. The payload is then aligned and the header
+ * can be released in place by gnrc_pktbuf_cut_head().
+ */
+#define _HDR_PAD    ((((sizeof(ethernet_hdr_t) + sizeof(void *) - 1) & \
+                       ~(sizeof(void *) - 1))) - sizeof(ethernet_hdr_t))
+
 static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 {
     netdev_t *dev = gnrc_netdev->dev;
@@ -37,7 +48,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 
     if (bytes_expected > 0) {
         pkt = gnrc_pktbuf_add(NULL, NULL,
-                bytes_expected,
+                bytes_expected + _HDR_PAD,
                 GNRC_NETTYPE_UNDEF);
 
         if(!pkt) {
@@ -49,28 +60,30 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        /* let the driver write the frame directly behind the headroom */
+        netdev_eth_rx_info_t rx_info = { .flags = 0 };
+        int nread = dev->driver->recv(dev, ((uint8_t *)pkt->data) + _HDR_PAD,
+                                      bytes_expected, &rx_info);
         if(nread <= 0) {
             DEBUG("_recv_ethernet_packet: read error.\n");
             goto safe_out;
         }
 
+        if (nread < (int)sizeof(ethernet_hdr_t)) {
+            DEBUG("_recv_ethernet_packet: frame too short.\n");
+            goto safe_out;
+        }
+
         if (nread < bytes_expected) {
             /* we've got less then the expected packet size,
              * so free the unused space.*/
 
             DEBUG("_recv_ethernet_packet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
+            gnrc_pktbuf_realloc_data(pkt, nread + _HDR_PAD);
         }
 
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netdev_eth: no space left in packet buffer\n");
-            goto safe_out;
-        }
-
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
+        /* parse the ethernet header in place */
+        ethernet_hdr_t *hdr = (ethernet_hdr_t *)(((uint8_t *)pkt->data) + _HDR_PAD);
 
         /* set payload type from ethertype */
         pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
@@ -83,7 +96,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 
         if (netif_hdr == NULL) {
             DEBUG("gnrc_netdev_eth: no space left in packet buffer\n");
-            pkt = eth_hdr;
             goto safe_out;
         }
 
@@ -91,6 +103,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
         gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
         ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = thread_getpid();
+        if (rx_info.flags & NETDEV_ETH_RX_INFO_CSUM_VALID) {
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+        }
 
         DEBUG("gnrc_netdev_eth: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
                 "of length %d\n",
@@ -100,7 +115,12 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
         od_hex_dump(hdr, nread, OD_WIDTH_DEFAULT);
 #endif
 
-        gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+        /* headroom and ethernet header are not needed anymore */
+        if (gnrc_pktbuf_cut_head(pkt, _HDR_PAD + sizeof(ethernet_hdr_t)) != 0) {
+            DEBUG("gnrc_netdev_eth: no space left in packet buffer\n");
+            gnrc_pktbuf_release(netif_hdr);
+            goto safe_out;
+        }
         LL_APPEND(pkt, netif_hdr);
     }
 
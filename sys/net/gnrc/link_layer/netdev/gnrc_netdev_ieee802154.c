@@ -85,8 +85,14 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+        if (nread < bytes_expected) {
+            /* free the unused space before the header is cut off, so less
+             * data needs to be moved if it can't be cut off in place */
+            DEBUG("_recv_ieee802154: reallocating.\n");
+            gnrc_pktbuf_realloc_data(pkt, nread);
+        }
         if (!(state->flags & NETDEV_IEEE802154_RAW)) {
-            gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
+            gnrc_pktsnip_t *netif_hdr;
             gnrc_netif_hdr_t *hdr;
 #if ENABLE_DEBUG
             char src_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
@@ -99,14 +105,8 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 return NULL;
             }
             nread -= mhr_len;
-            /* mark IEEE 802.15.4 header */
-            ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
-            if (ieee802154_hdr == NULL) {
-                DEBUG("_recv_ieee802154: no space left in packet buffer\n");
-                gnrc_pktbuf_release(pkt);
-                return NULL;
-            }
-            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            /* parse IEEE 802.15.4 header in place */
+            netif_hdr = _make_netif_hdr(pkt->data);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
@@ -117,6 +117,13 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             hdr->rssi = rx_info.rssi;
             hdr->if_pid = thread_getpid();
             pkt->type = state->proto;
+            /* IEEE 802.15.4 header is not needed anymore */
+            if (gnrc_pktbuf_cut_head(pkt, mhr_len) != 0) {
+                DEBUG("_recv_ieee802154: no space left in packet buffer\n");
+                gnrc_pktbuf_release(netif_hdr);
+                gnrc_pktbuf_release(pkt);
+                return NULL;
+            }
 #if ENABLE_DEBUG
             DEBUG("_recv_ieee802154: received packet from %s of length %u\n",
                   gnrc_netif_addr_to_str(src_str, sizeof(src_str),
@@ -127,12 +134,8 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
 #endif
 #endif
-            gnrc_pktbuf_remove_snip(pkt, ieee802154_hdr);
             LL_APPEND(pkt, netif_hdr);
         }
-
-        DEBUG("_recv_ieee802154: reallocating.\n");
-        gnrc_pktbuf_realloc_data(pkt, nread);
     }
 
     return pkt;
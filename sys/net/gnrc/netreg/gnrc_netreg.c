@@ -27,13 +27,37 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_BUCKETS & (GNRC_NETREG_HASH_BUCKETS - 1))
+#error "GNRC_NETREG_HASH_BUCKETS must be a power of two"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hashed demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* multiplicative hashing, so ports and protocol numbers close to each
+     * other still spread over all buckets */
+    uint32_t hash = (demux_ctx * 2654435761U) >> 16;
+
+    return &netreg[type][hash & (GNRC_NETREG_HASH_BUCKETS - 1)];
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -53,7 +77,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(*_list(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -64,7 +88,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_list(type, entry->demux_ctx), entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -75,7 +99,7 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    LL_SEARCH_SCALAR(*_list(type, demux_ctx), res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -89,7 +113,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = *_list(type, demux_ctx);
 
     while (entry != NULL) {
         if (entry->demux_ctx == demux_ctx) {
@@ -144,4 +168,24 @@ int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     }
 }
 
+int gnrc_netreg_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                            const uint8_t *new_buf, size_t len)
+{
+    switch (hdr->type) {
+#ifdef MODULE_GNRC_ICMPV6
+        case GNRC_NETTYPE_ICMPV6:
+            return gnrc_icmpv6_update_csum(hdr, old_buf, new_buf, len);
+#endif
+#ifdef MODULE_GNRC_UDP
+        case GNRC_NETTYPE_UDP:
+            return gnrc_udp_update_csum(hdr, old_buf, new_buf, len);
+#endif
+        default:
+            (void)old_buf;
+            (void)new_buf;
+            (void)len;
+            return -ENOENT;
+    }
+}
+
 /** @} */
@@ -24,6 +24,7 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/ndp.h"
+#include "net/inet_csum.h"
 #include "net/protnum.h"
 #include "od.h"
 #include "utlist.h"
@@ -78,7 +79,8 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     hdr = (icmpv6_hdr_t *)icmpv6->data;
 
-    if (_calc_csum(icmpv6, ipv6, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        _calc_csum(icmpv6, ipv6, pkt)) {
         DEBUG("icmpv6: wrong checksum.\n");
         /* don't release: IPv6 does this */
         return;
@@ -185,6 +187,26 @@ int gnrc_icmpv6_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     return 0;
 }
 
+int gnrc_icmpv6_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                            const uint8_t *new_buf, size_t len)
+{
+    icmpv6_hdr_t *icmpv6;
+
+    if (hdr == NULL) {
+        return -EFAULT;
+    }
+    if (hdr->type != GNRC_NETTYPE_ICMPV6) {
+        return -EBADMSG;
+    }
+
+    icmpv6 = hdr->data;
+    icmpv6->csum = byteorder_htons(inet_csum_update(byteorder_ntohs(icmpv6->csum),
+                                                    old_buf, new_buf,
+                                                    (uint16_t)len));
+
+    return 0;
+}
+
 /**
  * @}
  */
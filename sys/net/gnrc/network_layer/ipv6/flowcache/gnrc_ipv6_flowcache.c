@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/fib/table.h"
+#include "net/gnrc/ipv6.h"
+#include "xtimer.h"
+
+#include "net/gnrc/ipv6/flowcache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+static gnrc_ipv6_flowcache_t _flows[GNRC_IPV6_FLOWCACHE_SIZE];
+static mutex_t _mutex = MUTEX_INIT;
+
+static inline uint32_t _fib_version(void)
+{
+#ifdef MODULE_FIB
+    return gnrc_ipv6_fib_table.version;
+#else
+    return 0;
+#endif
+}
+
+static inline bool _is_valid(gnrc_ipv6_flowcache_t *flow, uint32_t now)
+{
+    return (flow->netif_hdr.if_pid != KERNEL_PID_UNDEF) &&
+           ((now - flow->added) < GNRC_IPV6_FLOWCACHE_TIMEOUT) &&
+           (flow->fib_version == _fib_version());
+}
+
+void gnrc_ipv6_flowcache_add(const ipv6_addr_t *dst, kernel_pid_t iface,
+                             const uint8_t *l2addr, uint8_t l2addr_len)
+{
+    uint32_t now = xtimer_now_usec();
+    gnrc_ipv6_flowcache_t *flow = &_flows[0];
+
+    if (l2addr_len > GNRC_IPV6_NC_L2_ADDR_MAX) {
+        return;
+    }
+    mutex_lock(&_mutex);
+    /* reuse the entry of the destination or an invalid one if possible,
+     * otherwise replace the oldest one */
+    for (unsigned i = 0; i < GNRC_IPV6_FLOWCACHE_SIZE; i++) {
+        if (!_is_valid(&_flows[i], now) ||
+            ipv6_addr_equal(&_flows[i].dst, dst)) {
+            flow = &_flows[i];
+            break;
+        }
+        if ((now - _flows[i].added) > (now - flow->added)) {
+            flow = &_flows[i];
+        }
+    }
+    DEBUG("ipv6 flowcache: add %s via interface %" PRIkernel_pid "\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), iface);
+    flow->dst = *dst;
+    flow->added = now;
+    flow->fib_version = _fib_version();
+    gnrc_netif_hdr_init(&flow->netif_hdr, 0, l2addr_len);
+    gnrc_netif_hdr_set_dst_addr(&flow->netif_hdr, (uint8_t *)l2addr,
+                                l2addr_len);
+    flow->netif_hdr.if_pid = iface;
+    mutex_unlock(&_mutex);
+}
+
+bool gnrc_ipv6_flowcache_get(const ipv6_addr_t *dst, gnrc_ipv6_flowcache_t *flow)
+{
+    uint32_t now = xtimer_now_usec();
+    bool res = false;
+
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_IPV6_FLOWCACHE_SIZE; i++) {
+        if (ipv6_addr_equal(&_flows[i].dst, dst) && _is_valid(&_flows[i], now)) {
+            *flow = _flows[i];
+            res = true;
+            break;
+        }
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_ipv6_flowcache_flush(void)
+{
+    mutex_lock(&_mutex);
+    memset(_flows, 0, sizeof(_flows));
+    mutex_unlock(&_mutex);
+}
+
+/** @} */
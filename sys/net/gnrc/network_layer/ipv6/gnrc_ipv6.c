@@ -33,6 +33,7 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/flowcache.h"
 
 #include "net/gnrc/ipv6.h"
 
@@ -450,8 +451,39 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
     _send_to_iface(iface, pkt);
 }
 
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+static void _send_cached(gnrc_ipv6_flowcache_t *flow, gnrc_pktsnip_t *pkt)
+{
+    kernel_pid_t iface = flow->netif_hdr.if_pid;
+    gnrc_pktsnip_t *netif = gnrc_pktbuf_add(pkt, &flow->netif_hdr,
+                                            gnrc_netif_hdr_sizeof(&flow->netif_hdr),
+                                            GNRC_NETTYPE_NETIF);
+
+    if (netif == NULL) {
+        DEBUG("ipv6: error on interface header allocation, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    DEBUG("ipv6: forward cached flow over interface %" PRIkernel_pid "\n", iface);
+#ifdef MODULE_NETSTATS_IPV6
+    gnrc_ipv6_netif_get_stats(iface)->tx_unicast_count++;
+#endif
+    _send_to_iface(iface, netif);
+}
+#endif
+
+/* checks if the device of iface calculates upper layer checksums itself */
+static inline bool _csum_offload(kernel_pid_t iface)
+{
+    gnrc_ipv6_netif_t *netif;
+
+    return (iface != KERNEL_PID_UNDEF) &&
+           ((netif = gnrc_ipv6_netif_get(iface)) != NULL) &&
+           (netif->flags & GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD);
+}
+
 static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
-                          gnrc_pktsnip_t *payload)
+                          gnrc_pktsnip_t *payload, bool calc_csum)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -497,6 +529,11 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
         }
     }
 
+    if (!calc_csum) {
+        DEBUG("ipv6: checksum for upper header is calculated by device.\n");
+        return 0;
+    }
+
     DEBUG("ipv6: calculate checksum for upper header.\n");
 
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
@@ -509,6 +546,58 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
     return 0;
 }
 
+#if GNRC_NETIF_NUMOF > 1
+/* adapts a header prepared by _fill_ipv6_hdr() for another interface. Only
+ * the checksum of the upper header is updated for a new source address
+ * instead of summing up the whole payload again. csum_done tells if
+ * _fill_ipv6_hdr() calculated the checksum at all */
+static int _refill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
+                            gnrc_pktsnip_t *payload, bool set_src, bool set_hl,
+                            bool csum_done)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+
+    if (set_hl) {
+        hdr->hl = gnrc_ipv6_netif_get(iface)->cur_hl;
+    }
+
+    if (set_src) {
+        ipv6_addr_t old_src = hdr->src;
+        ipv6_addr_t *src = gnrc_ipv6_netif_find_best_src_addr(iface, &hdr->dst, false);
+
+        if (src != NULL) {
+            DEBUG("ipv6: set packet source to %s\n",
+                  ipv6_addr_to_str(addr_str, src, sizeof(addr_str)));
+            memcpy(&hdr->src, src, sizeof(ipv6_addr_t));
+        }
+        else {
+            ipv6_addr_set_unspecified(&hdr->src);
+        }
+
+        if (csum_done && !_csum_offload(iface) &&
+            !ipv6_addr_equal(&old_src, &hdr->src) &&
+            (gnrc_netreg_update_csum(payload, old_src.u8, hdr->src.u8,
+                                     sizeof(ipv6_addr_t)) < 0)) {
+            csum_done = false;
+        }
+    }
+
+    if (!csum_done && !_csum_offload(iface)) {
+        int res;
+
+        DEBUG("ipv6: recalculate checksum for upper header.\n");
+        if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
+            if (res != -ENOENT) {   /* if there is no checksum we are okay */
+                DEBUG("ipv6: checksum calculation failed.\n");
+                return res;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif
+
 static inline void _send_multicast_over_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 {
     DEBUG("ipv6: send multicast over interface %" PRIkernel_pid "\n", iface);
@@ -544,11 +633,31 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
 #if GNRC_NETIF_NUMOF > 1
     /* interface not given: send over all interfaces */
     if (iface == KERNEL_PID_UNDEF) {
+        gnrc_pktsnip_t *orig = ipv6;
+        ipv6_hdr_t *hdr = ipv6->data;
+        bool set_src = false, set_hl = false, csum_done = true;
+
+        if (prep_hdr) {
+            /* the header only differs between interfaces in these fields */
+            set_src = ipv6_addr_is_unspecified(&hdr->src);
+            set_hl = (hdr->hl == 0);
+            csum_done = !_csum_offload(ifs[0]);
+            /* fill header and checksum once, for the first interface */
+            if (_fill_ipv6_hdr(ifs[0], ipv6, payload, csum_done) < 0) {
+                /* error on filling up header */
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+        }
+
         /* send packet to link layer */
         gnrc_pktbuf_hold(pkt, ifnum - 1);
 
         for (size_t i = 0; i < ifnum; i++) {
-            if (prep_hdr) {
+            ipv6 = orig;
+
+            if ((i > 0) && (set_src || set_hl ||
+                            (!csum_done && !_csum_offload(ifs[i])))) {
                 /* need to get second write access (duplication) to fill IPv6
                  * header interface-local */
                 gnrc_pktsnip_t *tmp = gnrc_pktbuf_start_write(pkt);
@@ -576,7 +685,8 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     ptr = ptr->next;
                 }
 
-                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
+                if (_refill_ipv6_hdr(ifs[i], ipv6, tmp, set_src, set_hl,
+                                     csum_done) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(ipv6);
                     return;
@@ -592,7 +702,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
     else {
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload, !_csum_offload(iface)) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -613,7 +723,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
 
     if (prep_hdr) {
-        if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+        if (_fill_ipv6_hdr(iface, ipv6, payload, !_csum_offload(iface)) < 0) {
             /* error on filling up header */
             gnrc_pktbuf_release(pkt);
             return;
@@ -710,7 +820,8 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt;
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            /* looped back packets never pass a device */
+            if (_fill_ipv6_hdr(iface, ipv6, payload, true) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -756,12 +867,18 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         }
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload, !_csum_offload(iface)) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
             }
         }
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+        else if (pkt == ipv6) {
+            /* forwarded packet without preset interface header */
+            gnrc_ipv6_flowcache_add(&hdr->dst, iface, l2addr, l2addr_len);
+        }
+#endif
 
         _send_unicast(iface, l2addr, l2addr_len, pkt);
     }
@@ -792,6 +909,10 @@ static void _receive(gnrc_pktsnip_t *pkt)
     kernel_pid_t iface = KERNEL_PID_UNDEF;
     gnrc_pktsnip_t *ipv6, *netif, *first_ext;
     ipv6_hdr_t *hdr;
+    bool cached = false;
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    gnrc_ipv6_flowcache_t flow;
+#endif
 
     assert(pkt != NULL);
 
@@ -901,7 +1022,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
           ipv6_addr_to_str(addr_str, &(hdr->dst), sizeof(addr_str)),
           hdr->nh, byteorder_ntohs(hdr->len));
 
-    if (_pkt_not_for_me(&iface, hdr)) { /* if packet is not for me */
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    /* destinations are only cached if they were not for me */
+    cached = gnrc_ipv6_flowcache_get(&hdr->dst, &flow);
+#endif
+
+    if (cached || _pkt_not_for_me(&iface, hdr)) { /* if packet is not for me */
         DEBUG("ipv6: packet destination not this host\n");
 
 #ifdef MODULE_GNRC_IPV6_ROUTER    /* only routers redirect */
@@ -953,6 +1079,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
                 reversed_pkt = ptr;
                 ptr = next;
             }
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+            if (cached) {
+                _send_cached(&flow, reversed_pkt);
+                return;
+            }
+#endif
             _send(reversed_pkt, false);
             return;
         }
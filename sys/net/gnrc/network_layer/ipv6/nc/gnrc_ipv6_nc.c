@@ -19,6 +19,9 @@
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+#include "net/gnrc/ipv6/flowcache.h"
+#endif
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -35,7 +38,103 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#if (GNRC_IPV6_NC_BUCKETS & (GNRC_IPV6_NC_BUCKETS - 1))
+#error "GNRC_IPV6_NC_BUCKETS must be a power of two"
+#endif
+
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
+/* entries by IPv6 address */
+static gnrc_ipv6_nc_t *_addr_buckets[GNRC_IPV6_NC_BUCKETS];
+/* entries with a link layer address by link layer address */
+static gnrc_ipv6_nc_t *_l2_buckets[GNRC_IPV6_NC_BUCKETS];
+/* incremented on every use of an entry, see gnrc_ipv6_nc_t::last_used */
+static uint16_t _lru_clock;
+
+static inline unsigned _fold(uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (GNRC_IPV6_NC_BUCKETS - 1);
+}
+
+static gnrc_ipv6_nc_t **_addr_bucket(const ipv6_addr_t *ipv6_addr)
+{
+    /* neighbors differ mostly in the interface identifier */
+    return &_addr_buckets[_fold((ipv6_addr->u32[2].u32 * 31) ^ ipv6_addr->u32[3].u32)];
+}
+
+static gnrc_ipv6_nc_t **_l2_bucket(const uint8_t *l2_addr, size_t l2_addr_len)
+{
+    uint32_t hash = l2_addr_len;
+
+    for (size_t i = 0; i < l2_addr_len; i++) {
+        hash = (hash * 31) + l2_addr[i];
+    }
+    return &_l2_buckets[_fold(hash)];
+}
+
+static void _addr_unlink(gnrc_ipv6_nc_t *entry)
+{
+    gnrc_ipv6_nc_t **iter = _addr_bucket(&entry->ipv6_addr);
+
+    for (; *iter != NULL; iter = &(*iter)->addr_next) {
+        if (*iter == entry) {
+            *iter = entry->addr_next;
+            return;
+        }
+    }
+}
+
+static void _l2_unlink(gnrc_ipv6_nc_t *entry)
+{
+    gnrc_ipv6_nc_t **iter;
+
+    if (entry->l2_addr_len == 0) {
+        return;
+    }
+    iter = _l2_bucket(entry->l2_addr, entry->l2_addr_len);
+    for (; *iter != NULL; iter = &(*iter)->l2_next) {
+        if (*iter == entry) {
+            *iter = entry->l2_next;
+            return;
+        }
+    }
+}
+
+static void _l2_link(gnrc_ipv6_nc_t *entry)
+{
+    if (entry->l2_addr_len > 0) {
+        gnrc_ipv6_nc_t **bucket = _l2_bucket(entry->l2_addr, entry->l2_addr_len);
+
+        entry->l2_next = *bucket;
+        *bucket = entry;
+    }
+}
+
+static inline void _touch(gnrc_ipv6_nc_t *entry)
+{
+    entry->last_used = ++_lru_clock;
+}
+
+/* entries that were not confirmed lately and that nobody depends on */
+static bool _is_evictable(const gnrc_ipv6_nc_t *entry)
+{
+    switch (gnrc_ipv6_nc_get_state(entry)) {
+        case GNRC_IPV6_NC_STATE_UNREACHABLE:
+        case GNRC_IPV6_NC_STATE_STALE:
+            break;
+        default:
+            return false;
+    }
+#ifdef MODULE_GNRC_NDP_NODE
+    if (entry->pkts != NULL) {
+        return false;
+    }
+#endif
+    return !(entry->flags & GNRC_IPV6_NC_IS_ROUTER) &&
+           /* registrations by 6LoWPAN-ND must not be dropped */
+           (gnrc_ipv6_nc_get_type(entry) == GNRC_IPV6_NC_TYPE_NONE);
+}
 
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
@@ -48,6 +147,10 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
           ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)),
           iface);
 
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    gnrc_ipv6_flowcache_flush();
+#endif
+
 #ifdef MODULE_GNRC_NDP_NODE
     while (entry->pkts != NULL) {
         gnrc_pktbuf_release(entry->pkts->pkt);
@@ -73,7 +176,12 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     xtimer_remove(&entry->nbr_sol_timer);
     xtimer_remove(&entry->nbr_adv_timer);
 
+    if (!ipv6_addr_is_unspecified(&(entry->ipv6_addr))) {
+        _addr_unlink(entry);
+        _l2_unlink(entry);
+    }
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
+    entry->l2_addr_len = 0;
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
 }
@@ -86,14 +194,46 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+    memset(_addr_buckets, 0, sizeof(_addr_buckets));
+    memset(_l2_buckets, 0, sizeof(_l2_buckets));
 }
 
-gnrc_ipv6_nc_t *_find_free_entry(void)
+/* returns a free entry or, if there is none, frees the least recently used
+ * evictable one */
+static gnrc_ipv6_nc_t *_find_free_entry(void)
 {
+    gnrc_ipv6_nc_t *lru = NULL;
+
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
             return ncache + i;
         }
+        if (_is_evictable(&ncache[i]) &&
+            ((lru == NULL) || ((uint16_t)(_lru_clock - ncache[i].last_used) >
+                               (uint16_t)(_lru_clock - lru->last_used)))) {
+            lru = &ncache[i];
+        }
+    }
+
+    if (lru != NULL) {
+        DEBUG("ipv6_nc: neighbor cache full, evict %s\n",
+              ipv6_addr_to_str(addr_str, &lru->ipv6_addr, sizeof(addr_str)));
+        _nc_remove(lru->iface, lru);
+    }
+
+    return lru;
+}
+
+static gnrc_ipv6_nc_t *_lookup(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
+{
+    gnrc_ipv6_nc_t *entry = *_addr_bucket(ipv6_addr);
+
+    for (; entry != NULL; entry = entry->addr_next) {
+        if (((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+             (iface == entry->iface)) &&
+            ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
+            return entry;
+        }
     }
 
     return NULL;
@@ -102,7 +242,7 @@ gnrc_ipv6_nc_t *_find_free_entry(void)
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
-    gnrc_ipv6_nc_t *free_entry = NULL;
+    gnrc_ipv6_nc_t *free_entry;
 
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
@@ -114,33 +254,31 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
-
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
-
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
-
-            }
-            return &ncache[i];
-        }
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    gnrc_ipv6_flowcache_flush();
+#endif
+
+    /* an address is only registered once, regardless of the interface */
+    if ((free_entry = _lookup(KERNEL_PID_UNDEF, ipv6_addr)) != NULL) {
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                         l2_addr, l2_addr_len));
+
+            gnrc_ipv6_nc_set_l2_addr(free_entry, l2_addr, l2_addr_len);
+            free_entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
 
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
-            /* found the first free entry */
-            free_entry = &ncache[i];
         }
+        _touch(free_entry);
+        return free_entry;
     }
 
-    if (!free_entry) {
-        /* reached end of NC without finding updateable or free entry */
+    if ((free_entry = _find_free_entry()) == NULL) {
+        /* no free entry and none that can be replaced */
         DEBUG("ipv6_nc: neighbor cache full.\n");
         return NULL;
     }
@@ -156,15 +294,19 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
           ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
           iface);
 
+    gnrc_ipv6_nc_t **bucket = _addr_bucket(ipv6_addr);
+    free_entry->addr_next = *bucket;
+    *bucket = free_entry;
+
     if ((l2_addr != NULL) && (l2_addr_len > 0)) {
         DEBUG(" to L2 address %s",
               gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
                                      l2_addr, l2_addr_len));
-        memcpy(&(free_entry->l2_addr), l2_addr, l2_addr_len);
-        free_entry->l2_addr_len = l2_addr_len;
+        gnrc_ipv6_nc_set_l2_addr(free_entry, l2_addr, l2_addr_len);
     }
 
     free_entry->flags = flags;
+    _touch(free_entry);
 
     DEBUG(" with flags = 0x%0x\n", flags);
 
@@ -199,27 +341,58 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
 {
+    gnrc_ipv6_nc_t *entry;
+
     if ((ipv6_addr == NULL) || (ipv6_addr_is_unspecified(ipv6_addr))) {
         DEBUG("ipv6_nc: address was NULL or ::\n");
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
-             (iface == ncache[i].iface)) &&
-            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
-                  " (0 = all interfaces) [%p]\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
+    if ((entry = _lookup(iface, ipv6_addr)) != NULL) {
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
+        _touch(entry);
+    }
 
-            return ncache + i;
+    return entry;
+}
+
+gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_by_l2_addr(kernel_pid_t iface, const void *l2_addr,
+                                            size_t l2_addr_len, gnrc_ipv6_nc_t *prev)
+{
+    gnrc_ipv6_nc_t *entry;
+
+    if ((l2_addr == NULL) || (l2_addr_len == 0)) {
+        return NULL;
+    }
+
+    entry = (prev == NULL) ? *_l2_bucket(l2_addr, l2_addr_len) : prev->l2_next;
+    for (; entry != NULL; entry = entry->l2_next) {
+        if (((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+             (iface == entry->iface)) &&
+            (entry->l2_addr_len == l2_addr_len) &&
+            (memcmp(entry->l2_addr, l2_addr, l2_addr_len) == 0)) {
+            return entry;
         }
     }
 
     return NULL;
 }
 
+void gnrc_ipv6_nc_set_l2_addr(gnrc_ipv6_nc_t *entry, const void *l2_addr,
+                              size_t l2_addr_len)
+{
+    assert(l2_addr_len <= GNRC_IPV6_NC_L2_ADDR_MAX);
+    _l2_unlink(entry);
+    if (l2_addr_len > 0) {
+        memcpy(entry->l2_addr, l2_addr, l2_addr_len);
+    }
+    entry->l2_addr_len = l2_addr_len;
+    _l2_link(entry);
+}
+
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_next(gnrc_ipv6_nc_t *prev)
 {
     if (prev == NULL) {
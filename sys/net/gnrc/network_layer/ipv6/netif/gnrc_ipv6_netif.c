@@ -33,6 +33,9 @@
 #include "net/gnrc/sixlowpan/netif.h"
 
 #include "net/gnrc/ipv6/netif.h"
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+#include "net/gnrc/ipv6/flowcache.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -309,6 +312,11 @@ ipv6_addr_t *gnrc_ipv6_netif_add_addr(kernel_pid_t pid, const ipv6_addr_t *addr,
 
     mutex_unlock(&entry->mutex);
 
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    /* packets to the address must not be forwarded anymore */
+    gnrc_ipv6_flowcache_flush();
+#endif
+
     return res;
 }
 
@@ -799,6 +807,7 @@ void gnrc_ipv6_netif_init_by_dev(void)
         ipv6_addr_t addr;
         eui64_t iid;
         uint16_t tmp;
+        netopt_enable_t enable;
         gnrc_ipv6_netif_t *ipv6_if = gnrc_ipv6_netif_get(ifs[i]);
 
         if (ipv6_if == NULL) {
@@ -882,6 +891,14 @@ void gnrc_ipv6_netif_init_by_dev(void)
             ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_IS_WIRED;
         }
 
+        if ((gnrc_netapi_get(ifs[i], NETOPT_CHECKSUM_TX, 0, &enable,
+                             sizeof(enable)) > 0) && (enable == NETOPT_ENABLE)) {
+            ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD;
+        }
+        else {
+            ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD;
+        }
+
         mutex_unlock(&ipv6_if->mutex);
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
         gnrc_ipv6_netif_set_router(ipv6_if, true);
@@ -66,8 +66,7 @@ static void _stale_nc(kernel_pid_t iface, ipv6_addr_t *ipaddr, uint8_t *l2addr,
         else if (((uint16_t)l2addr_len != nc_entry->l2_addr_len) ||
                  (memcmp(l2addr, nc_entry->l2_addr, l2addr_len) != 0)) {
             /* if entry exists but l2 address differs: set */
-            nc_entry->l2_addr_len = (uint16_t)l2addr_len;
-            memcpy(nc_entry->l2_addr, l2addr, l2addr_len);
+            gnrc_ipv6_nc_set_l2_addr(nc_entry, l2addr, l2addr_len);
             gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_STALE);
         }
     }
@@ -280,8 +279,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             }
 
             nc_entry->iface = iface;
-            nc_entry->l2_addr_len = l2tgt_len;
-            memcpy(nc_entry->l2_addr, l2tgt, l2tgt_len);
+            gnrc_ipv6_nc_set_l2_addr(nc_entry, l2tgt, l2tgt_len);
 
             if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_S) {
                 gnrc_ndp_internal_set_state(nc_entry, GNRC_IPV6_NC_STATE_REACHABLE);
@@ -327,8 +325,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 (l2tgt_len == 0)) {
                 if (l2tgt_len != 0) {
                     nc_entry->iface = iface;
-                    nc_entry->l2_addr_len = l2tgt_len;
-                    memcpy(nc_entry->l2_addr, l2tgt, l2tgt_len);
+                    gnrc_ipv6_nc_set_l2_addr(nc_entry, l2tgt, l2tgt_len);
                 }
 
                 if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_S) {
@@ -24,6 +24,10 @@
 
 #include "net/gnrc/ndp/internal.h"
 
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+#include "net/gnrc/ipv6/flowcache.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -96,6 +100,11 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
     nc_entry->flags &= ~GNRC_IPV6_NC_STATE_MASK;
     nc_entry->flags |= state;
 
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    /* let the next packet take the slow path, e.g. to start NUD */
+    gnrc_ipv6_flowcache_flush();
+#endif
+
     DEBUG("ndp internal: set %s state to ",
           ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
 
@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/nd.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "xtimer.h"
+
+#include "fwd.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FWD
+
+static fwd_t _fwd[GNRC_SIXLOWPAN_FRAG_FWD_SIZE];
+
+static inline bool _fwd_in_use(fwd_t *entry, uint32_t now_usec)
+{
+    return (entry->out_iface != KERNEL_PID_UNDEF) &&
+           ((now_usec - entry->arrival) <= RBUF_TIMEOUT);
+}
+
+static fwd_t *_fwd_get(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_FWD_SIZE; i++) {
+        fwd_t *entry = &_fwd[i];
+
+        if (_fwd_in_use(entry, now_usec) &&
+            (entry->in_iface == netif_hdr->if_pid) &&
+            (entry->size == size) && (entry->in_tag == tag) &&
+            (entry->src_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(entry->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    entry->src_len) == 0)) {
+            entry->arrival = now_usec;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* checks if all of the given part of the datagram was forwarded before */
+static bool _fwd_forwarded(fwd_t *entry, size_t offset, size_t len)
+{
+    for (unsigned i = offset / RBUF_UNIT; i <= (offset + len - 1) / RBUF_UNIT; i++) {
+        if (!bf_isset(entry->forwarded, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* marks the given part of the datagram as forwarded and closes the entry
+ * once all of the datagram was forwarded */
+static void _fwd_mark(fwd_t *entry, size_t offset, size_t len)
+{
+    for (unsigned i = offset / RBUF_UNIT; i <= (offset + len - 1) / RBUF_UNIT; i++) {
+        if (!bf_isset(entry->forwarded, i)) {
+            bf_set(entry->forwarded, i);
+            entry->units++;
+        }
+    }
+    if (entry->units >= ((entry->size + RBUF_UNIT - 1) / RBUF_UNIT)) {
+        DEBUG("6lo fwd: all fragments forwarded\n");
+        entry->out_iface = KERNEL_PID_UNDEF;
+    }
+}
+
+static fwd_t *_fwd_add(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now_usec();
+    fwd_t *res = NULL;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_FWD_SIZE; i++) {
+        fwd_t *entry = &_fwd[i];
+
+        if (!_fwd_in_use(entry, now_usec)) {
+            res = entry;
+            break;
+        }
+        /* remember oldest entry */
+        if ((res == NULL) || ((now_usec - entry->arrival) >
+                              (now_usec - res->arrival))) {
+            res = entry;
+        }
+    }
+    DEBUG("6lo fwd: using entry %p\n", (void *)res);
+    res->arrival = now_usec;
+    memcpy(res->src, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           netif_hdr->src_l2addr_len);
+    res->src_len = netif_hdr->src_l2addr_len;
+    res->in_iface = netif_hdr->if_pid;
+    res->size = size;
+    res->in_tag = tag;
+    res->out_tag = frag_next_tag();
+    res->units = 0;
+    memset(res->forwarded, 0, sizeof(res->forwarded));
+    return res;
+}
+
+static bool _is_forwarded(ipv6_hdr_t *hdr)
+{
+    /* link-local and multicast datagrams are not routed and datagrams for
+     * this node are reassembled of course. Let gnrc_ipv6 handle the hop
+     * limit running out. */
+    return !ipv6_addr_is_multicast(&hdr->dst) &&
+           !ipv6_addr_is_link_local(&hdr->dst) &&
+           !ipv6_addr_is_link_local(&hdr->src) &&
+           (hdr->hl > 1) &&
+           (gnrc_ipv6_netif_find_by_addr(NULL, &hdr->dst) == KERNEL_PID_UNDEF);
+}
+
+/* builds the uncompressed headers of the first fragment from the header
+ * decompressed into dec_hdr, so that they can be compressed for the next
+ * hop */
+static gnrc_pktsnip_t *_build_hdrs(gnrc_pktsnip_t *dec_hdr, size_t nh_len,
+                                   gnrc_pktsnip_t *payload)
+{
+#ifdef MODULE_GNRC_UDP
+    const gnrc_nettype_t nh_type = GNRC_NETTYPE_UDP;
+#else
+    const gnrc_nettype_t nh_type = GNRC_NETTYPE_UNDEF;
+#endif
+    gnrc_pktsnip_t *ipv6;
+
+    if (nh_len > 0) {
+        payload = gnrc_pktbuf_add(payload,
+                                  ((uint8_t *)dec_hdr->data) + sizeof(ipv6_hdr_t),
+                                  nh_len, nh_type);
+        if (payload == NULL) {
+            return NULL;
+        }
+    }
+    ipv6 = gnrc_pktbuf_add(payload, dec_hdr->data, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if ((ipv6 == NULL) && (nh_len > 0)) {
+        /* release only UDP header, payload is released by caller */
+        payload->next = NULL;
+        gnrc_pktbuf_release(payload);
+    }
+    return ipv6;
+}
+
+/* sends len bytes of data at offset of the datagram as a subsequent fragment
+ * to the next hop of entry */
+static void _fwd_send_n(fwd_t *entry, const uint8_t *data, size_t offset,
+                        size_t len)
+{
+    kernel_pid_t iface = entry->out_iface;
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_frag_n_t *hdr;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->dst, entry->dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo fwd: unable to allocate interface header\n");
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    frag = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_frag_n_t) + len,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo fwd: unable to allocate subsequent fragment\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    netif->next = frag;
+    hdr = frag->data;
+    hdr->disp_size = byteorder_htons(entry->size);
+    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+    hdr->tag = byteorder_htons(entry->out_tag);
+    hdr->offset = (uint8_t)(offset / 8);
+    memcpy(hdr + 1, data, len);
+    _fwd_mark(entry, offset, len);
+
+    DEBUG("6lo fwd: forward buffered fragment (offset: %u, tag: %u)\n",
+          (unsigned)offset, entry->out_tag);
+    if (gnrc_netapi_send(iface, netif) < 1) {
+        DEBUG("6lo fwd: unable to send buffered fragment\n");
+        gnrc_pktbuf_release(netif);
+    }
+}
+
+/* forwards the subsequent fragments of a datagram that arrived before its
+ * first fragment and were put into the reassembly buffer */
+static void _fwd_replay(gnrc_netif_hdr_t *netif_hdr, fwd_t *entry)
+{
+    rbuf_t *rbuf = rbuf_find(netif_hdr, entry->size, entry->in_tag);
+    unsigned units = (entry->size + RBUF_UNIT - 1) / RBUF_UNIT;
+
+    if (rbuf == NULL) {
+        return;
+    }
+    for (unsigned first = 0; first < units; first++) {
+        unsigned end = first + 1;
+        size_t offset = first * RBUF_UNIT;
+
+        if (!bf_isset(rbuf->starts, first) || bf_isset(entry->forwarded, first)) {
+            continue;
+        }
+        /* the fragment goes on up to the next one or a part not received */
+        while ((end < units) && bf_isset(rbuf->received, end) &&
+               !bf_isset(rbuf->starts, end)) {
+            end++;
+        }
+        _fwd_send_n(entry, ((uint8_t *)rbuf->pkt->data) + offset, offset,
+                    ((end < units) ? (end * RBUF_UNIT) : entry->size) - offset);
+    }
+    rbuf_rm(rbuf);
+}
+
+bool fwd_frag_1(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                size_t frag_size)
+{
+    sixlowpan_frag_t *frag = pkt->data;
+    uint8_t *data = (uint8_t *)(frag + 1);
+    size_t datagram_size = byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    uint16_t tag = byteorder_ntohs(frag->tag);
+    uint8_t l2addr[RBUF_L2ADDR_MAX_LEN];
+    uint8_t l2addr_len = sizeof(l2addr);
+    size_t iphc_len, nh_len = 0;
+    gnrc_sixlowpan_netif_t *out;
+    gnrc_pktsnip_t *dec_hdr, *payload, *ipv6, *netif;
+    kernel_pid_t iface;
+    fwd_t *entry;
+
+    if (_fwd_get(netif_hdr, datagram_size, tag) != NULL) {
+        DEBUG("6lo fwd: first fragment forwarded before\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    /* without IPHC the datagram is most likely not meant to be routed over
+     * 6LoWPAN anyway */
+    if ((frag_size == 0) || !sixlowpan_iphc_is(data)) {
+        return false;
+    }
+    /* room for the IPv6 header and an UDP header decompressed by NHC */
+    dec_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                              GNRC_NETTYPE_IPV6);
+    if (dec_hdr == NULL) {
+        DEBUG("6lo fwd: unable to allocate space for header\n");
+        return false;
+    }
+    iphc_len = gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, datagram_size,
+                                          sizeof(sixlowpan_frag_t), &nh_len);
+    if ((iphc_len == 0) || (iphc_len > frag_size) ||
+        !_is_forwarded(dec_hdr->data)) {
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    iface = gnrc_sixlowpan_nd_next_hop_l2addr(l2addr, &l2addr_len,
+                                              KERNEL_PID_UNDEF,
+                                              &((ipv6_hdr_t *)dec_hdr->data)->dst);
+    out = (iface > KERNEL_PID_UNDEF) ? gnrc_sixlowpan_netif_get(iface) : NULL;
+    if ((out == NULL) || !out->iphc_enabled) {
+        DEBUG("6lo fwd: next hop not reachable over 6LoWPAN\n");
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    ((ipv6_hdr_t *)dec_hdr->data)->hl--;
+
+    payload = gnrc_pktbuf_add(NULL, data + iphc_len, frag_size - iphc_len,
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        gnrc_pktbuf_release(dec_hdr);
+        return false;
+    }
+    ipv6 = _build_hdrs(dec_hdr, nh_len, payload);
+    gnrc_pktbuf_release(dec_hdr);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return false;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, l2addr, l2addr_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    netif->next = ipv6;
+    /* the header is compressed for the next hop, since some of it may be
+     * elided based on the link-layer addresses */
+    if (!gnrc_sixlowpan_iphc_encode(netif) ||
+        ((gnrc_pkt_len(netif->next) + sizeof(sixlowpan_frag_t)) > out->max_frag_size)) {
+        DEBUG("6lo fwd: unable to compress first fragment for next hop\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    payload = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                              GNRC_NETTYPE_SIXLOWPAN);
+    if (payload == NULL) {
+        DEBUG("6lo fwd: unable to allocate fragment header\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    netif->next = payload;
+
+    entry = _fwd_add(netif_hdr, datagram_size, tag);
+    memcpy(entry->dst, l2addr, l2addr_len);
+    entry->dst_len = l2addr_len;
+    entry->out_iface = iface;
+
+    frag = payload->data;
+    frag->disp_size = byteorder_htons((uint16_t)datagram_size);
+    frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    frag->tag = byteorder_htons(entry->out_tag);
+
+    DEBUG("6lo fwd: forward first fragment (datagram size: %u, tag: %u => %u)\n",
+          (unsigned)datagram_size, tag, entry->out_tag);
+    if (gnrc_netapi_send(iface, netif) < 1) {
+        DEBUG("6lo fwd: unable to send first fragment\n");
+        gnrc_pktbuf_release(netif);
+        entry->out_iface = KERNEL_PID_UNDEF;
+        return false;
+    }
+    /* account for the uncompressed size of the first fragment */
+    _fwd_mark(entry, 0, sizeof(ipv6_hdr_t) + nh_len + frag_size - iphc_len);
+    _fwd_replay(netif_hdr, entry);
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+
+bool fwd_frag_n(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                size_t frag_size)
+{
+    sixlowpan_frag_n_t *frag = pkt->data;
+    fwd_t *entry = _fwd_get(netif_hdr,
+                            byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
+                            byteorder_ntohs(frag->tag));
+    size_t offset = frag->offset * 8U;
+    gnrc_pktsnip_t *netif;
+    kernel_pid_t iface;
+
+    if (entry == NULL) {
+        return false;
+    }
+    if ((frag_size == 0) || ((offset + frag_size) > entry->size) ||
+        _fwd_forwarded(entry, offset, frag_size)) {
+        DEBUG("6lo fwd: fragment forwarded before or invalid\n");
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, entry->dst, entry->dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo fwd: unable to allocate interface header\n");
+        return false;
+    }
+    iface = entry->out_iface;
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    pkt = gnrc_pktbuf_start_write(pkt);
+    if (pkt == NULL) {
+        DEBUG("6lo fwd: unable to get write access to fragment\n");
+        gnrc_pktbuf_release(netif);
+        return false;
+    }
+    /* replace the incoming interface header */
+    gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    LL_PREPEND(pkt, netif);
+    frag = pkt->next->data;
+    frag->tag = byteorder_htons(entry->out_tag);
+    _fwd_mark(entry, offset, frag_size);
+
+    DEBUG("6lo fwd: forward subsequent fragment (offset: %u, tag: %u)\n",
+          (unsigned)offset, entry->out_tag);
+    if (gnrc_netapi_send(iface, pkt) < 1) {
+        DEBUG("6lo fwd: unable to send subsequent fragment\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return true;
+}
+
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_FWD */
+
+/** @} */
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN fragment forwarding
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_FWD_H
+#define GNRC_SIXLOWPAN_FRAG_FWD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitfield.h"
+#include "kernel_types.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pkt.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   An entry in the fragment forwarding table.
+ *
+ * @details Maps the fragments of a datagram, identified like in the
+ *          reassembly buffer (see @ref rbuf_t), to the interface, the next
+ *          hop and the datagram tag they are forwarded with.
+ *
+ * @internal
+ */
+typedef struct {
+    uint32_t arrival;                   /**< time in microseconds of arrival of
+                                         *   last forwarded fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];   /**< source address of the incoming
+                                         *   fragments */
+    uint8_t dst[RBUF_L2ADDR_MAX_LEN];   /**< next hop of the outgoing
+                                         *   fragments */
+    uint8_t src_len;                    /**< length of source address */
+    uint8_t dst_len;                    /**< length of next hop address */
+    kernel_pid_t in_iface;              /**< interface of the incoming fragments */
+    kernel_pid_t out_iface;             /**< interface of the outgoing
+                                         *   fragments, KERNEL_PID_UNDEF if
+                                         *   the entry is unused */
+    uint16_t size;                      /**< the datagram's size */
+    uint16_t in_tag;                    /**< the datagram's incoming tag */
+    uint16_t out_tag;                   /**< the datagram's outgoing tag */
+    uint16_t units;                     /**< number of units set in
+                                         *   fwd_t::forwarded */
+    /**
+     * @brief   forwarded parts of the datagram in units of @ref RBUF_UNIT
+     */
+    BITFIELD(forwarded, (SIXLOWPAN_FRAG_MAX_LEN + RBUF_UNIT - 1) / RBUF_UNIT);
+} fwd_t;
+
+/**
+ * @brief   Forwards a first fragment if its datagram is routed over a
+ *          6LoWPAN interface and adds an entry for the datagram to the
+ *          forwarding table.
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] pkt           The fragment.
+ * @param[in] frag_size     The fragment's size without fragment header.
+ *
+ * @return  true, if the fragment was forwarded. @p pkt was released.
+ * @return  false, if the fragment needs to be reassembled.
+ *
+ * @internal
+ */
+bool fwd_frag_1(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                size_t frag_size);
+
+/**
+ * @brief   Forwards a subsequent fragment if the first fragment of its
+ *          datagram was forwarded.
+ *
+ * Fragments forwarded before are dropped. Subsequent fragments received
+ * before the first one end up in the reassembly buffer and are forwarded
+ * from there by fwd_frag_1().
+ *
+ * @param[in] netif_hdr     The interface header of the fragment.
+ * @param[in] pkt           The fragment.
+ * @param[in] frag_size     The fragment's size without fragment header.
+ *
+ * @return  true, if the fragment was forwarded. @p pkt was released.
+ * @return  false, if the fragment needs to be reassembled.
+ *
+ * @internal
+ */
+bool fwd_frag_n(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                size_t frag_size);
+
+/**
+ * @brief   Gets the datagram tag for the next datagram sent fragmented.
+ *
+ * @return  a new datagram tag
+ *
+ * @internal
+ */
+uint16_t frag_next_tag(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_SIXLOWPAN_FRAG_FWD_H */
+/** @} */
@@ -16,6 +16,8 @@
  * @author  Peter Kietzmann <peter.kietzmann@haw-hamburg.de>
  */
 
+#include <errno.h>
+
 #include "kernel_types.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
@@ -23,8 +25,11 @@
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
+#include "thread.h"
 #include "utlist.h"
+#include "xtimer.h"
 
+#include "fwd.h"
 #include "rbuf.h"
 
 #define ENABLE_DEBUG    (0)
@@ -36,6 +41,10 @@
 #endif
 
 static uint16_t _tag;
+static xtimer_t _retry_timer;
+static msg_t _retry_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_SND };
+static unsigned _retries;
+static bool _take;
 
 static inline uint16_t _floor8(uint16_t length)
 {
@@ -47,8 +56,7 @@ static inline size_t _min(size_t a, size_t b)
     return (a < b) ? a : b;
 }
 
-static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
-                                       size_t size)
+static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t size)
 {
     gnrc_netif_hdr_t *hdr = pkt->data, *new_hdr;
     gnrc_pktsnip_t *netif, *frag;
@@ -67,11 +75,10 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     new_hdr->rssi = hdr->rssi;
     new_hdr->lqi = hdr->lqi;
 
-    frag = gnrc_pktbuf_add(NULL, NULL, _min(size, payload_len),
-                           GNRC_NETTYPE_SIXLOWPAN);
+    frag = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_SIXLOWPAN);
 
     if (frag == NULL) {
-        DEBUG("6lo frag: error allocating first fragment\n");
+        DEBUG("6lo frag: error allocating fragment\n");
         gnrc_pktbuf_release(netif);
         return NULL;
     }
@@ -81,149 +88,175 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     return frag;
 }
 
-static uint16_t _send_1st_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size)
+static bool _exclusive(gnrc_pktsnip_t *pkt)
 {
-    gnrc_pktsnip_t *frag;
-    uint16_t local_offset = 0;
-    /* payload_len: actual size of the packet vs
-     * datagram_size: size of the uncompressed IPv6 packet */
-    int payload_diff = (datagram_size - payload_len);
-    /* virtually add payload_diff to flooring to account for offset (must be divisable by 8)
-     * in uncompressed datagram */
-    uint16_t max_frag_size = _floor8(iface->max_frag_size + payload_diff -
-                                     sizeof(sixlowpan_frag_t)) - payload_diff;
-    sixlowpan_frag_t *hdr;
-    uint8_t *data;
-
-    DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
+    while (pkt != NULL) {
+        if (pkt->users > 1) {
+            return false;
+        }
+        pkt = pkt->next;
+    }
+    return true;
+}
 
-    frag = _build_frag_pkt(pkt, payload_len,
-                           max_frag_size + sizeof(sixlowpan_frag_t));
+static void _copy_payload(gnrc_pktsnip_t *pkt, uint8_t *data, size_t offset,
+                          size_t size)
+{
+    pkt = pkt->next;    /* don't copy netif header */
 
-    if (frag == NULL) {
-        return 0;
+    while ((pkt != NULL) && (offset >= pkt->size)) {    /* go to offset */
+        offset -= pkt->size;
+        pkt = pkt->next;
     }
+    while ((pkt != NULL) && (size > 0)) {
+        size_t clen = _min(size, pkt->size - offset);
 
-    hdr = frag->next->data;
-    data = (uint8_t *)(hdr + 1);
-
-    hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
-    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
-    hdr->tag = byteorder_htons(_tag);
+        memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+        data += clen;
+        size -= clen;
+        offset = 0;
+        pkt = pkt->next;
+    }
+}
 
-    pkt = pkt->next;    /* don't copy netif header */
+/* unlinks the first size bytes following the netif header pkt from the
+ * datagram and returns them as a packet of their own */
+static gnrc_pktsnip_t *_take_payload(gnrc_pktsnip_t *pkt, size_t size)
+{
+    gnrc_pktsnip_t *payload = NULL, **tail = &payload;
 
-    while (pkt != NULL) {
-        size_t clen = _min(max_frag_size - local_offset, pkt->size);
+    while (size > 0) {
+        gnrc_pktsnip_t *snip = pkt->next;
 
-        memcpy(data + local_offset, pkt->data, clen);
-        local_offset += clen;
+        if (snip->size > size) {
+            /* with gnrc_pktbuf_static this only splits the snip descriptor
+             * as long as size is aligned, which holds for all but the first
+             * fragment of datagrams with 8 byte aligned uncompressed headers */
+            gnrc_pktsnip_t *front = gnrc_pktbuf_mark(snip, size, snip->type);
 
-        if (local_offset >= max_frag_size) {
-            break;
+            if (front == NULL) {
+                DEBUG("6lo frag: error splitting payload\n");
+                gnrc_pktbuf_release(payload);
+                return NULL;
+            }
+            /* gnrc_pktbuf_mark() put front behind the remainder */
+            snip->next = front->next;
+            snip = front;
         }
-
-        pkt = pkt->next;
+        else {
+            pkt->next = snip->next;
+        }
+        snip->next = NULL;
+        *tail = snip;
+        tail = &snip->next;
+        size -= snip->size;
     }
 
-    DEBUG("6lo frag: send first fragment (datagram size: %u, "
-          "datagram tag: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, local_offset);
-    if (gnrc_netapi_send(iface->pid, frag) < 1) {
-        DEBUG("6lo frag: unable to send first fragment\n");
-        gnrc_pktbuf_release(frag);
-    }
+    return payload;
+}
 
-    return local_offset;
+/* puts the payload _take_payload() moved behind frag_hdr back in front of
+ * the remaining datagram */
+static void _return_payload(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr)
+{
+    gnrc_pktsnip_t *last = frag_hdr->next;
+
+    while (last->next != NULL) {
+        last = last->next;
+    }
+    last->next = pkt->next;
+    pkt->next = frag_hdr->next;
+    frag_hdr->next = NULL;
 }
 
-static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
-                                   size_t payload_len, size_t datagram_size,
-                                   uint16_t offset)
+static int _send_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t *pkt,
+                          size_t payload_len, size_t datagram_size,
+                          uint16_t offset, bool take)
 {
     gnrc_pktsnip_t *frag;
-    /* since dispatches aren't supposed to go into subsequent fragments, we need not account
-     * for payload difference as for the first fragment */
-    uint16_t max_frag_size = _floor8(iface->max_frag_size - sizeof(sixlowpan_frag_n_t));
-    uint16_t local_offset = 0, offset_count = 0;
-    sixlowpan_frag_n_t *hdr;
-    uint8_t *data;
+    /* payload_len: actual size of the packet vs
+     * datagram_size: size of the uncompressed IPv6 packet */
+    int payload_diff = (datagram_size - payload_len);
+    uint16_t max_frag_size, frag_len;
+    size_t hdr_len;
+    sixlowpan_frag_t *hdr;
+
+    if (offset == 0) {
+        /* virtually add payload_diff to flooring to account for offset (must
+         * be divisable by 8) in uncompressed datagram */
+        max_frag_size = _floor8(iface->max_frag_size + payload_diff -
+                                sizeof(sixlowpan_frag_t)) - payload_diff;
+        hdr_len = sizeof(sixlowpan_frag_t);
+    }
+    else {
+        /* since dispatches aren't supposed to go into subsequent fragments,
+         * we need not account for payload difference as for the first
+         * fragment */
+        max_frag_size = _floor8(iface->max_frag_size - sizeof(sixlowpan_frag_n_t));
+        hdr_len = sizeof(sixlowpan_frag_n_t);
+    }
+    frag_len = _min(max_frag_size, payload_len - offset);
 
     DEBUG("6lo frag: determined max_frag_size = %" PRIu16 "\n", max_frag_size);
 
-    frag = _build_frag_pkt(pkt,
-                           payload_len - offset + sizeof(sixlowpan_frag_n_t),
-                           max_frag_size + sizeof(sixlowpan_frag_n_t));
+    frag = _build_frag_pkt(pkt, (take) ? hdr_len : (hdr_len + frag_len));
 
     if (frag == NULL) {
         return 0;
     }
 
     hdr = frag->next->data;
-    data = (uint8_t *)(hdr + 1);
 
     /* XXX: truncation of datagram_size > 4095 may happen here */
     hdr->disp_size = byteorder_htons((uint16_t)datagram_size);
-    hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
     hdr->tag = byteorder_htons(_tag);
-    /* don't mention payload diff in offset */
-    hdr->offset = (uint8_t)((offset + (datagram_size - payload_len)) >> 3);
-    pkt = pkt->next;    /* don't copy netif header */
-
-    while ((pkt != NULL) && (offset_count != offset)) {   /* go to offset */
-        offset_count += (uint16_t)pkt->size;
-
-        if (offset_count > offset) {    /* we overshot */
-            /* => copy rest of partly send packet snip */
-            uint16_t pkt_offset = offset - (offset_count - ((uint16_t)pkt->size));
-            size_t clen = _min(max_frag_size, pkt->size - pkt_offset);
-
-            memcpy(data, ((uint8_t *)pkt->data) + pkt_offset, clen);
-            local_offset = clen;
-            pkt = pkt->next;
-            break;
-        }
-
-        pkt = pkt->next;
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        /* don't mention payload diff in offset */
+        ((sixlowpan_frag_n_t *)hdr)->offset = (uint8_t)((offset + payload_diff) >> 3);
     }
 
-    if (local_offset < max_frag_size) { /* copy other packet snips */
-        while (pkt != NULL) {
-            size_t clen = _min(max_frag_size - local_offset, pkt->size);
-
-            memcpy(data + local_offset, pkt->data, clen);
-            local_offset += clen;
-
-            if (local_offset == max_frag_size) {
-                break;
-            }
-
-            pkt = pkt->next;
+    if (take) {
+        frag->next->next = _take_payload(pkt, frag_len);
+        if (frag->next->next == NULL) {
+            gnrc_pktbuf_release(frag);
+            return 0;
         }
     }
-
-    DEBUG("6lo frag: send subsequent fragment (datagram size: %u, "
-          "datagram tag: %" PRIu16 ", offset: %" PRIu8 " (%u bytes), "
-          "fragment size: %" PRIu16 ")\n",
-          (unsigned int)datagram_size, _tag, hdr->offset, hdr->offset << 3,
-          local_offset);
-    if (gnrc_netapi_send(iface->pid, frag) < 1) {
-        DEBUG("6lo frag: unable to send subsequent fragment\n");
-        gnrc_pktbuf_release(frag);
+    else {
+        _copy_payload(pkt, ((uint8_t *)hdr) + hdr_len, offset, frag_len);
     }
 
-    return local_offset;
+    DEBUG("6lo frag: send fragment (datagram size: %u, datagram tag: %" PRIu16
+          ", offset: %" PRIu16 ", fragment size: %" PRIu16 ")\n",
+          (unsigned int)datagram_size, _tag, offset, frag_len);
+    switch (gnrc_netapi_send(iface->pid, frag)) {
+        case 1:
+            return frag_len;
+        case 0:
+            DEBUG("6lo frag: interface queue is full\n");
+            if (take) {
+                /* keep the payload for the next attempt */
+                _return_payload(pkt, frag->next);
+            }
+            gnrc_pktbuf_release(frag);
+            return -ENOBUFS;
+        default:
+            DEBUG("6lo frag: unable to send fragment\n");
+            gnrc_pktbuf_release(frag);
+            return 0;
+    }
 }
 
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
 {
     gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(fragment_msg->pid);
-    uint16_t res;
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
-    size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
+    size_t payload_len;
 
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
@@ -236,50 +269,46 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     }
 #endif
 
-    /* Check weater to send the first or an Nth fragment */
-    if (fragment_msg->offset == 0) {
+    if ((fragment_msg->offset == 0) && (_retries == 0)) {
         /* increment tag for successive, fragmented datagrams */
         _tag++;
-        if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
-            /* error sending first fragment */
-            DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
-            return;
-        }
-        fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
+        /* if nobody else holds the datagram, the fragments take its snips
+         * over instead of copying them */
+        _take = _exclusive(fragment_msg->pkt->next);
     }
-    else {
-        /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
-        if (fragment_msg->offset < payload_len) {
-            if ((res = _send_nth_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size,
-                                          fragment_msg->offset)) == 0) {
-                /* error sending subsequent fragment */
-                DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
-                      ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
-                fragment_msg->pkt = NULL;
-                return;
-                }
-            fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+    /* the fragments sent before a retry took their part of the payload */
+    payload_len = gnrc_pkt_len(fragment_msg->pkt->next) +
+                  ((_take) ? fragment_msg->offset : 0);
+    /* fragments are handed to the interface one after another without
+     * returning to the message loop in between, unless the interface can't
+     * keep up */
+    while (fragment_msg->offset < payload_len) {
+        int res = _send_fragment(iface, fragment_msg->pkt, payload_len,
+                                 fragment_msg->datagram_size,
+                                 fragment_msg->offset, _take);
+
+        if ((res == -ENOBUFS) && (_retries < GNRC_SIXLOWPAN_FRAG_RETRIES)) {
+            DEBUG("6lo frag: retry in %u us (offset = %" PRIu16 ")\n",
+                  (unsigned)GNRC_SIXLOWPAN_FRAG_RETRY_DELAY, fragment_msg->offset);
+            _retries++;
+            _retry_msg.content.ptr = fragment_msg;
+            xtimer_set_msg(&_retry_timer, GNRC_SIXLOWPAN_FRAG_RETRY_DELAY,
+                           &_retry_msg, thread_getpid());
+            return;
         }
-        else {
-            gnrc_pktbuf_release(fragment_msg->pkt);
-            fragment_msg->pkt = NULL;
+        if (res <= 0) {
+            /* the receiver can't reassemble the datagram without this
+             * fragment, so don't bother to send the others */
+            DEBUG("6lo frag: error sending fragment (offset = %" PRIu16 ")\n",
+                  fragment_msg->offset);
+            break;
         }
+        _retries = 0;
+        fragment_msg->offset += res;
     }
+    _retries = 0;
+    gnrc_pktbuf_release(fragment_msg->pkt);
+    fragment_msg->pkt = NULL;
 }
 
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
@@ -292,11 +321,21 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
     switch (frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) {
         case SIXLOWPAN_FRAG_1_DISP:
             frag_size = (pkt->size - sizeof(sixlowpan_frag_t));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FWD
+            if (fwd_frag_1(hdr, pkt, frag_size)) {
+                return;
+            }
+#endif
             break;
 
         case SIXLOWPAN_FRAG_N_DISP:
             offset = (((sixlowpan_frag_n_t *)frag)->offset * 8);
             frag_size = (pkt->size - sizeof(sixlowpan_frag_n_t));
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FWD
+            if (fwd_frag_n(hdr, pkt, frag_size)) {
+                return;
+            }
+#endif
             break;
 
         default:
@@ -311,4 +350,14 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
     gnrc_pktbuf_release(pkt);
 }
 
+uint16_t frag_next_tag(void)
+{
+    return ++_tag;
+}
+
+void gnrc_sixlowpan_frag_gc_rbuf(void)
+{
+    rbuf_gc();
+}
+
 /** @} */
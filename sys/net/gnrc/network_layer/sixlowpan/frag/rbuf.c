@@ -29,22 +29,19 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
+static rbuf_t rbuf[RBUF_SIZE];
 
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* entries by hash of the tupel identifying their datagram */
+static rbuf_t *_buckets[RBUF_HASH_BUCKETS];
+/* entries in order of the arrival of their last fragment, oldest first */
+static rbuf_t *_arrivals;
+/* entries that were used before and are free now */
+static rbuf_t *_free;
+/* number of entries of rbuf that were never used */
+static unsigned _unused = RBUF_SIZE;
 
-static rbuf_t rbuf[RBUF_SIZE];
+static xtimer_t _gc_timer;
+static msg_t _gc_msg = { .type = GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF };
 
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
@@ -53,16 +50,22 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
+/* checks the received parts of entry for given fragment. Returns 0 if none
+ * of the fragment was received yet, 1 if it duplicates a fragment received
+ * before and -1 if it overlaps other fragments */
+static int _rbuf_check_received(rbuf_t *entry, uint16_t start, uint16_t end);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
-static void _rbuf_gc(void);
+/* removes entries that timed out */
+static void _rbuf_gc(uint32_t now_usec);
+/* hashes the tupel identifying a datagram to its bucket */
+static inline unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                                  const uint8_t *dst, size_t dst_len,
+                                  size_t size, uint16_t tag);
+/* finds an entry identified by its tupel */
+static rbuf_t *_rbuf_find(unsigned bucket, const void *src, size_t src_len,
+                          const void *dst, size_t dst_len,
+                          size_t size, uint16_t tag);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
@@ -77,10 +80,9 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
-    _rbuf_gc();
+    _rbuf_gc(xtimer_now_usec());
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                       byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK,
@@ -91,8 +93,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -133,8 +133,17 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
+    switch (_rbuf_check_received(entry, offset, offset + frag_size - 1)) {
+        case 0:
+            DEBUG("6lo rbuf: add fragment data\n");
+            entry->cur_size += (uint16_t)frag_size;
+            memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
+                   frag_size - data_offset);
+            break;
+        case 1:
+            DEBUG("6lo rbuf: fragment received before\n");
+            break;
+        default:
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
             _rbuf_rem(entry);
@@ -145,16 +154,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             rbuf_add(netif_hdr, pkt, original_size, offset);
 
             return;
-        }
-
-        ptr = ptr->next;
-    }
-
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->cur_size += (uint16_t)frag_size;
-        memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
-               frag_size - data_offset);
     }
 
     if (entry->cur_size == entry->pkt->size) {
@@ -189,132 +188,178 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     }
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+rbuf_t *rbuf_find(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
+
+    return _rbuf_find(_rbuf_hash(src, netif_hdr->src_l2addr_len,
+                                 dst, netif_hdr->dst_l2addr_len, size, tag),
+                      src, netif_hdr->src_l2addr_len,
+                      dst, netif_hdr->dst_l2addr_len, size, tag);
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+void rbuf_rm(rbuf_t *entry)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
-
-    return NULL;
+    gnrc_pktbuf_release(entry->pkt);
+    _rbuf_rem(entry);
 }
 
-static void _rbuf_rem(rbuf_t *entry)
+void rbuf_gc(void)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    uint32_t now_usec = xtimer_now_usec();
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    _rbuf_gc(now_usec);
+    xtimer_remove(&_gc_timer);
+    if (_arrivals != NULL) {
+        /* check again when the oldest entry times out */
+        xtimer_set_msg(&_gc_timer,
+                       RBUF_TIMEOUT - (now_usec - _arrivals->arrival) + 1,
+                       &_gc_msg, thread_getpid());
     }
-
-    entry->pkt = NULL;
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static int _rbuf_check_received(rbuf_t *entry, uint16_t start, uint16_t end)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    /* start and ends are both inclusive */
+    unsigned first = start / RBUF_UNIT, last = end / RBUF_UNIT;
+    unsigned received = 0;
 
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    for (unsigned i = first; i <= last; i++) {
+        if (bf_isset(entry->received, i)) {
+            received++;
+        }
+    }
+    if (received == 0) {
+        DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
+              start, end, gnrc_netif_addr_to_str(l2addr_str,
+                      sizeof(l2addr_str), entry->src, entry->src_len));
+        DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->dst, entry->dst_len),
+              (unsigned)entry->pkt->size, entry->tag);
+        for (unsigned i = first; i <= last; i++) {
+            bf_set(entry->received, i);
+        }
+        bf_set(entry->starts, first);
+        return 0;
     }
+    if ((received < (last - first + 1)) || !bf_isset(entry->starts, first)) {
+        return -1;
+    }
+    /* a duplicate covers exactly one fragment received before, since all
+     * but the last fragment end at a unit boundary */
+    for (unsigned i = first + 1; i <= last; i++) {
+        if (bf_isset(entry->starts, i)) {
+            return -1;
+        }
+    }
+    if (((last + 1) < (entry->pkt->size + RBUF_UNIT - 1) / RBUF_UNIT) &&
+        bf_isset(entry->received, last + 1) &&
+        !bf_isset(entry->starts, last + 1)) {
+        /* the received fragment goes on */
+        return -1;
+    }
+    return 1;
+}
 
-    new->start = offset;
-    new->end = end;
+static inline unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                                  const uint8_t *dst, size_t dst_len,
+                                  size_t size, uint16_t tag)
+{
+    uint32_t hash = ((uint32_t)size << 16) | tag;
 
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), entry->src, entry->src_len));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
-            sizeof(l2addr_str), entry->dst, entry->dst_len),
-          (unsigned)entry->pkt->size, entry->tag);
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 31) + dst[i];
+    }
+    /* multiplicative hashing, so consecutive tags spread over the buckets */
+    return ((hash * 2654435761U) >> 16) % RBUF_HASH_BUCKETS;
+}
+
+static void _rbuf_rem(rbuf_t *entry)
+{
+    LL_DELETE(_buckets[entry->bucket], entry);
+    DL_DELETE2(_arrivals, entry, older, newer);
+    entry->pkt = NULL;
+    LL_PREPEND(_free, entry);
+}
 
-    LL_PREPEND(entry->ints, new);
+static void _rbuf_gc(uint32_t now_usec)
+{
+    /* since pkt occupies pktbuf, aggressivly collect garbage */
+    while ((_arrivals != NULL) &&
+           ((now_usec - _arrivals->arrival) > RBUF_TIMEOUT)) {
+        rbuf_t *entry = _arrivals;
+
+        DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->src, entry->src_len));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->dst,
+                                     entry->dst_len),
+              (unsigned)entry->pkt->size, entry->tag);
 
-    return true;
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+    }
 }
 
-static void _rbuf_gc(void)
+static rbuf_t *_rbuf_find(unsigned bucket, const void *src, size_t src_len,
+                          const void *dst, size_t dst_len,
+                          size_t size, uint16_t tag)
 {
-    uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
-                    sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                         rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
+    rbuf_t *res;
+
+    LL_FOREACH(_buckets[bucket], res) {
+        if ((res->pkt->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                         res->src, res->src_len));
+            DEBUG("%s, %u, %u) found\n",
+                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                         res->dst, res->dst_len),
+                  (unsigned)res->pkt->size, res->tag);
+            return res;
         }
     }
+    return NULL;
 }
 
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    unsigned bucket = _rbuf_hash(src, src_len, dst, dst_len, size, tag);
     uint32_t now_usec = xtimer_now_usec();
-
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
-        }
+    rbuf_t *res = _rbuf_find(bucket, src, src_len, dst, dst_len, size, tag);
+
+    /* check first if entry already available */
+    if (res != NULL) {
+        res->arrival = now_usec;
+        /* keep _arrivals sorted */
+        DL_DELETE2(_arrivals, res, older, newer);
+        DL_APPEND2(_arrivals, res, older, newer);
+        return res;
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
+    if (_free != NULL) {
+        res = _free;
+        LL_DELETE(_free, res);
+    }
+    else if (_unused > 0) {
+        res = &rbuf[RBUF_SIZE - _unused--];
+    }
+    else {
+        /* entry not in buffer and no empty spot found */
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
+        gnrc_pktbuf_release(_arrivals->pkt);
+        _rbuf_rem(_arrivals);
+        res = _free;
+        LL_DELETE(_free, res);
     }
 
     /* now we have an empty spot */
@@ -322,6 +367,7 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        LL_PREPEND(_free, res);
         return NULL;
     }
 
@@ -334,6 +380,17 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->dst_len = dst_len;
     res->tag = tag;
     res->cur_size = 0;
+    res->bucket = bucket;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
+    LL_PREPEND(_buckets[bucket], res);
+    if (_arrivals == NULL) {
+        /* the timer is only set while there are entries, see rbuf_gc() */
+        xtimer_remove(&_gc_timer);
+        xtimer_set_msg(&_gc_timer, RBUF_TIMEOUT + 1, &_gc_msg,
+                       thread_getpid());
+    }
+    DL_APPEND2(_arrivals, res, older, newer);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
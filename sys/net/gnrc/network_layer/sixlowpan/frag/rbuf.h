@@ -21,36 +21,41 @@
 
 #include <inttypes.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
 
 #include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+
 #ifdef __cplusplus
 
 extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
+#ifndef RBUF_SIZE
 #define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
+#endif
+#ifndef RBUF_HASH_BUCKETS
+/**
+ * @brief   number of hash buckets to look up reassembly buffer entries
+ */
+#define RBUF_HASH_BUCKETS   (RBUF_SIZE)
+#endif
 #define RBUF_TIMEOUT        (3U * US_PER_SEC) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
+ * @brief   Granularity of the received parts of a datagram in bytes
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * All fragments but the last one end at a multiple of 8 bytes in the
+ * datagram.
  *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
- *
- * @internal
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#define RBUF_UNIT           (8U)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -70,8 +75,11 @@ typedef struct rbuf_int {
  *
  * @internal
  */
-typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
+typedef struct rbuf {
+    struct rbuf *next;                  /**< next entry in the same hash
+                                         *   bucket or next free entry */
+    struct rbuf *older;                 /**< entry with the previous arrival */
+    struct rbuf *newer;                 /**< entry with the next arrival */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
@@ -81,6 +89,21 @@ typedef struct {
     uint8_t dst_len;                    /**< length of destination address */
     uint16_t tag;                       /**< the datagram's tag */
     uint16_t cur_size;                  /**< the datagram's current size */
+    uint16_t bucket;                    /**< hash bucket of the entry */
+    /**
+     * @brief   received parts of the datagram in units of @ref RBUF_UNIT
+     *
+     * @note    Fragments MUST NOT overlap and overlapping fragments are to be
+     *          discarded
+     */
+    BITFIELD(received, (SIXLOWPAN_FRAG_MAX_LEN + RBUF_UNIT - 1) / RBUF_UNIT);
+    /**
+     * @brief   units of @ref RBUF_UNIT a received fragment started with
+     *
+     * Tells a duplicate from a fragment that only covers received parts
+     * but starts or ends within another fragment.
+     */
+    BITFIELD(starts, (SIXLOWPAN_FRAG_MAX_LEN + RBUF_UNIT - 1) / RBUF_UNIT);
 } rbuf_t;
 
 /**
@@ -100,6 +123,41 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+/**
+ * @brief   Looks up the entry of a datagram in the reassembly buffer
+ *
+ * @param[in] netif_hdr     The interface header of a fragment of the datagram.
+ * @param[in] size          The datagram's size.
+ * @param[in] tag           The datagram's tag.
+ *
+ * @return  The entry of the datagram.
+ * @return  NULL, if no fragment of the datagram was received yet.
+ *
+ * @internal
+ */
+rbuf_t *rbuf_find(gnrc_netif_hdr_t *netif_hdr, size_t size, uint16_t tag);
+
+/**
+ * @brief   Removes an entry from the reassembly buffer and releases its
+ *          datagram
+ *
+ * @param[in] entry     The entry to remove.
+ *
+ * @internal
+ */
+void rbuf_rm(rbuf_t *entry);
+
+/**
+ * @brief   Removes all entries that timed out from the reassembly buffer
+ *
+ * Scheduled by the reassembly buffer itself with a
+ * @ref GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF message to the calling thread while
+ * it holds entries.
+ *
+ * @internal
+ */
+void rbuf_gc(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -273,6 +273,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (fragment_msg.pkt != NULL) {
+        /* only while the previous datagram waits for the interface */
         DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
         gnrc_pktbuf_release(pkt2);
         return;
@@ -280,19 +281,13 @@ static void _send(gnrc_pktsnip_t *pkt)
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %" PRIu16 ")\n",
               (unsigned int)datagram_size, iface->max_frag_size);
-        msg_t msg;
-
         fragment_msg.pid = hdr->if_pid;
         fragment_msg.pkt = pkt2;
         fragment_msg.datagram_size = datagram_size;
         /* Sending the first fragment has an offset==0 */
         fragment_msg.offset = 0;
 
-        /* set the outgoing message's fields */
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = &fragment_msg;
-        /* send message to self */
-        msg_send_to_self(&msg);
+        gnrc_sixlowpan_frag_send(&fragment_msg);
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
@@ -349,6 +344,10 @@ static void *_event_loop(void *args)
                 DEBUG("6lo: send fragmented event received\n");
                 gnrc_sixlowpan_frag_send(msg.content.ptr);
                 break;
+            case GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF:
+                DEBUG("6lo: garbage collect reassembly buffer event received\n");
+                gnrc_sixlowpan_frag_gc_rbuf();
+                break;
 #endif
 
             default:
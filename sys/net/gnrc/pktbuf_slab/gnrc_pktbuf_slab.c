@@ -0,0 +1,781 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using segregated size-class slabs
+ *
+ * The packet buffer is split into pages of @ref GNRC_PKTBUF_SLAB_PAGE_SIZE
+ * bytes. Chunks up to the largest size class (packet snips and typical
+ * link layer, IPv6 and UDP headers) are taken from pages reserved for their
+ * class, larger chunks occupy a run of contiguous pages. Freeing a chunk
+ * never needs to merge holes and short-lived headers can't split the space
+ * left for full frames.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK    (sizeof(void *) - 1)
+#define _PAGE_NUMOF        (GNRC_PKTBUF_SIZE / GNRC_PKTBUF_SLAB_PAGE_SIZE)
+
+#if (GNRC_PKTBUF_SLAB_PAGE_SIZE % 8) || (GNRC_PKTBUF_SLAB_PAGE_SIZE < 64) || \
+    (GNRC_PKTBUF_SLAB_PAGE_SIZE > 2048)
+#error "GNRC_PKTBUF_SLAB_PAGE_SIZE must be a multiple of 8 between 64 and 2048"
+#endif
+#if (_PAGE_NUMOF == 0) || (_PAGE_NUMOF > 250)
+#error "GNRC_PKTBUF_SIZE must hold between 1 and 250 pages of GNRC_PKTBUF_SLAB_PAGE_SIZE"
+#endif
+
+/**
+ * @name    Special values of the page and chunk indices
+ * @{
+ */
+#define _NONE              (0xff)   /**< end of a page or chunk list */
+#define _PAGE_FREE         (0xff)   /**< page is not in use */
+#define _PAGE_RUN          (0xfe)   /**< first page of a large chunk */
+#define _PAGE_CONT         (0xfd)   /**< further page of a large chunk */
+/** @} */
+
+/**
+ * @brief   Size of the packet snip class
+ */
+#define _SNIP_SIZE         ((sizeof(gnrc_pktsnip_t) + _ALIGNMENT_MASK) & \
+                            ~(_ALIGNMENT_MASK))
+
+#define _CLASS_NUMOF       (sizeof(_class_size) / sizeof(_class_size[0]))
+
+typedef struct {
+    uint8_t cls;    /**< size class, or one of the _PAGE_* values */
+    uint8_t used;   /**< chunks in use, or number of pages of a run */
+    uint8_t free;   /**< first free chunk of a slab page */
+    uint8_t next;   /**< next page of the same class with free chunks */
+} _page_t;
+
+/* chunk sizes of the slab pages: packet snips, UDP and 6LoWPAN headers,
+ * link layer headers and IPv6 headers */
+static const uint16_t _class_size[] = { _SNIP_SIZE, 16, 32, 64 };
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[GNRC_PKTBUF_SIZE] __attribute__((aligned(sizeof(void *))));
+static _page_t _pages[_PAGE_NUMOF];
+/* per size class the first page with free chunks */
+static uint8_t _partial[_CLASS_NUMOF];
+
+#ifdef DEVELHELP
+/* maximum number of bytes allocated */
+static uint16_t max_byte_count = 0;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data);
+static size_t _pktbuf_space(void *data);
+static void _pktbuf_trim(void *data, size_t size);
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - _pktbuf) < (_PAGE_NUMOF * GNRC_PKTBUF_SLAB_PAGE_SIZE);
+}
+
+static inline uint8_t *_page_addr(unsigned page)
+{
+    return &_pktbuf[page * GNRC_PKTBUF_SLAB_PAGE_SIZE];
+}
+
+static inline unsigned _page_of(void *ptr)
+{
+    return ((uint8_t *)ptr - _pktbuf) / GNRC_PKTBUF_SLAB_PAGE_SIZE;
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        _pages[i].cls = _PAGE_FREE;
+        _pages[i].used = 0;
+        _pages[i].free = _NONE;
+        _pages[i].next = _NONE;
+    }
+    memset(_partial, _NONE, sizeof(_partial));
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->size != size) {
+        /* a chunk can only be freed as a whole, so the (usually small) marked
+         * header gets its own chunk and the remainder stays in place */
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* new size does not fit into the chunk */
+    else if ((pkt->data == NULL) || (size > _pktbuf_space(pkt->data))) {
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        _pktbuf_free(pkt->data);
+        pkt->data = new_data;
+    }
+    else if (size < pkt->size) {
+        _pktbuf_trim(pkt->data, size);
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+int gnrc_pktbuf_cut_head(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    if (size > pkt->size) {
+        mutex_unlock(&_mutex);
+        return EINVAL;
+    }
+    if (size == pkt->size) {
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    else {
+        /* chunks are released by any pointer into them, so the head can
+         * just be skipped */
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    pkt->size -= size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head;
+    struct iovec *vec;
+
+    assert(len != NULL);
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of snips in the packet and allocate the IOVEC */
+    length = gnrc_pkt_count(pkt);
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    assert(head->data != NULL);
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC */
+    while (pkt != NULL) {
+        vec->iov_base = pkt->data;
+        vec->iov_len = pkt->size;
+        ++vec;
+        pkt = pkt->next;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    unsigned used = 0;
+
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
+    printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        _page_t *page = &_pages[i];
+
+        switch (page->cls) {
+            case _PAGE_FREE:
+                break;
+            case _PAGE_RUN:
+                printf("  page %3u (%p): %u page chunk\n", i,
+                       (void *)_page_addr(i), (unsigned)page->used);
+                used += page->used;
+                break;
+            case _PAGE_CONT:
+                break;
+            default:
+                printf("  page %3u (%p): %u of %u chunks of %u bytes in use\n",
+                       i, (void *)_page_addr(i), (unsigned)page->used,
+                       (unsigned)(GNRC_PKTBUF_SLAB_PAGE_SIZE / _class_size[page->cls]),
+                       (unsigned)_class_size[page->cls]);
+                used++;
+                break;
+        }
+    }
+    printf("  pages in use: %u of %u (page size: %u)\n", used, _PAGE_NUMOF,
+           GNRC_PKTBUF_SLAB_PAGE_SIZE);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        if (_pages[i].cls != _PAGE_FREE) {
+            return false;
+        }
+    }
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        if (_partial[i] != _NONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned partial = 0;
+
+    /* Invariants of this implementation:
+     *  - a run starts with a _PAGE_RUN page followed by exactly used - 1
+     *    _PAGE_CONT pages
+     *  - forall slab pages: 0 < used and used + length of the free list ==
+     *    number of chunks in the page
+     *  - a slab page is in the partial list of its class iff it has free
+     *    chunks
+     */
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        _page_t *page = &_pages[i];
+
+        if (page->cls == _PAGE_FREE) {
+            continue;
+        }
+        if (page->cls == _PAGE_CONT) {
+            return false;
+        }
+        if (page->cls == _PAGE_RUN) {
+            if ((page->used == 0) || ((i + page->used) > _PAGE_NUMOF)) {
+                return false;
+            }
+            for (unsigned j = 1; j < page->used; j++) {
+                if (_pages[i + j].cls != _PAGE_CONT) {
+                    return false;
+                }
+            }
+            i += page->used - 1;
+            continue;
+        }
+        if (page->cls >= _CLASS_NUMOF) {
+            return false;
+        }
+
+        unsigned chunks = GNRC_PKTBUF_SLAB_PAGE_SIZE / _class_size[page->cls];
+        unsigned free = 0;
+
+        for (uint8_t idx = page->free; idx != _NONE;
+             idx = _page_addr(i)[idx * _class_size[page->cls]]) {
+            if ((idx >= chunks) || (++free > chunks)) {
+                return false;
+            }
+        }
+        if ((page->used == 0) || ((page->used + free) != chunks)) {
+            return false;
+        }
+        if (free > 0) {
+            partial++;
+        }
+    }
+    for (unsigned cls = 0; cls < _CLASS_NUMOF; cls++) {
+        unsigned num = 0;
+
+        for (uint8_t i = _partial[cls]; i != _NONE; i = _pages[i].next) {
+            if ((i >= _PAGE_NUMOF) || (_pages[i].cls != cls) ||
+                (_pages[i].free == _NONE) || (++num > _PAGE_NUMOF)) {
+                return false;
+            }
+        }
+        partial -= (num > partial) ? partial : num;
+    }
+
+    return (partial == 0);
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static inline void _update_max(uint8_t *end)
+{
+#ifdef DEVELHELP
+    uint16_t last_byte = (uint16_t)(end - &(_pktbuf[0]));
+    if (last_byte > max_byte_count) {
+        max_byte_count = last_byte;
+    }
+#else
+    (void)end;
+#endif
+}
+
+/* returns the smallest size class fitting size or -1 if size needs a run */
+static int _class_of(size_t size)
+{
+    int res = -1;
+
+    for (unsigned i = 0; i < _CLASS_NUMOF; i++) {
+        if ((_class_size[i] >= size) &&
+            ((res < 0) || (_class_size[i] < _class_size[res]))) {
+            res = i;
+        }
+    }
+    return res;
+}
+
+/* returns the first page of num contiguous free pages or -1 */
+static int _pages_alloc(unsigned num)
+{
+    unsigned len = 0;
+
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        if (_pages[i].cls != _PAGE_FREE) {
+            len = 0;
+        }
+        else if (++len == num) {
+            return i + 1 - num;
+        }
+    }
+    return -1;
+}
+
+static void *_chunk_alloc(unsigned cls)
+{
+    unsigned size = _class_size[cls];
+    uint8_t *chunk;
+    _page_t *page;
+
+    if (_partial[cls] == _NONE) {
+        int new = _pages_alloc(1);
+
+        if (new < 0) {
+            return NULL;
+        }
+        page = &_pages[new];
+        page->cls = cls;
+        page->used = 0;
+        page->free = 0;
+        page->next = _NONE;
+        /* chain all chunks of the page in the free list */
+        chunk = _page_addr(new);
+        for (unsigned i = 1; i < (GNRC_PKTBUF_SLAB_PAGE_SIZE / size); i++) {
+            *chunk = i;
+            chunk += size;
+        }
+        *chunk = _NONE;
+        _partial[cls] = new;
+    }
+    page = &_pages[_partial[cls]];
+    chunk = _page_addr(_partial[cls]) + (page->free * size);
+    page->free = *chunk;
+    page->used++;
+    if (page->free == _NONE) {
+        /* page is full */
+        _partial[cls] = page->next;
+        page->next = _NONE;
+    }
+    _update_max(chunk + size);
+    return chunk;
+}
+
+static void *_run_alloc(size_t size)
+{
+    unsigned num = (size + GNRC_PKTBUF_SLAB_PAGE_SIZE - 1) / GNRC_PKTBUF_SLAB_PAGE_SIZE;
+    int first = _pages_alloc(num);
+
+    if (first < 0) {
+        return NULL;
+    }
+    _pages[first].cls = _PAGE_RUN;
+    _pages[first].used = num;
+    for (unsigned i = 1; i < num; i++) {
+        _pages[first + i].cls = _PAGE_CONT;
+    }
+    _update_max(_page_addr(first + num));
+    return _page_addr(first);
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    int cls = _class_of(size);
+    void *res = (cls < 0) ? _run_alloc(size) : _chunk_alloc(cls);
+
+    if (res == NULL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+    }
+    return res;
+}
+
+/* returns the first page of the run containing page */
+static inline unsigned _run_start(unsigned page)
+{
+    while (_pages[page].cls == _PAGE_CONT) {
+        page--;
+    }
+    return page;
+}
+
+static void _pages_free(unsigned first, unsigned num)
+{
+    for (unsigned i = first; i < (first + num); i++) {
+        _pages[i].cls = _PAGE_FREE;
+        _pages[i].used = 0;
+    }
+}
+
+static void _pktbuf_free(void *data)
+{
+    unsigned num;
+    _page_t *page;
+    uint8_t *chunk;
+    unsigned size, idx;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    num = _page_of(data);
+    page = &_pages[num];
+    assert(page->cls != _PAGE_FREE);
+    if ((page->cls == _PAGE_RUN) || (page->cls == _PAGE_CONT)) {
+        num = _run_start(num);
+        _pages_free(num, _pages[num].used);
+        return;
+    }
+    /* data may point into the chunk after gnrc_pktbuf_mark() */
+    size = _class_size[page->cls];
+    idx = ((uint8_t *)data - _page_addr(num)) / size;
+    chunk = _page_addr(num) + (idx * size);
+    if (page->free == _NONE) {
+        /* page was full, so it has a free chunk again */
+        page->next = _partial[page->cls];
+        _partial[page->cls] = num;
+    }
+    *chunk = page->free;
+    page->free = idx;
+    if (--page->used == 0) {
+        /* return the empty page to the pool */
+        uint8_t *ptr = &_partial[page->cls];
+
+        while (*ptr != num) {
+            ptr = &_pages[*ptr].next;
+        }
+        *ptr = page->next;
+        page->next = _NONE;
+        page->free = _NONE;
+        page->cls = _PAGE_FREE;
+    }
+}
+
+/* returns the number of bytes from data up to the end of its chunk */
+static size_t _pktbuf_space(void *data)
+{
+    unsigned num = _page_of(data);
+    _page_t *page = &_pages[num];
+
+    if ((page->cls == _PAGE_RUN) || (page->cls == _PAGE_CONT)) {
+        num = _run_start(num);
+        return _page_addr(num + _pages[num].used) - (uint8_t *)data;
+    }
+    return _class_size[page->cls] -
+           (((uint8_t *)data - _page_addr(num)) % _class_size[page->cls]);
+}
+
+/* releases the pages of a run that are not needed anymore for size bytes
+ * starting at data */
+static void _pktbuf_trim(void *data, size_t size)
+{
+    unsigned num = _page_of(data);
+
+    if ((_pages[num].cls == _PAGE_RUN) || (_pages[num].cls == _PAGE_CONT)) {
+        unsigned first = _run_start(num);
+        unsigned keep = _page_of((uint8_t *)data + size - 1) + 1 - first;
+
+        _pages_free(first + keep, _pages[first].used - keep);
+        _pages[first].used = keep;
+    }
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
@@ -213,6 +213,47 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     return 0;
 }
 
+int gnrc_pktbuf_cut_head(gnrc_pktsnip_t *pkt, size_t size)
+{
+    size_t rest;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    if (size > pkt->size) {
+        mutex_unlock(&_mutex);
+        return EINVAL;
+    }
+    rest = pkt->size - size;
+    if (size == 0) {
+        /* nothing to do */
+    }
+    else if (rest == 0) {
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    else if ((_align(size) == size) && (size >= sizeof(_unused_t)) &&
+             (rest >= sizeof(_unused_t))) {
+        /* both parts fit an _unused_t marker => release head in place */
+        _pktbuf_free(pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        void *new_data = _pktbuf_alloc(rest);
+
+        if (new_data == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        memcpy(new_data, ((uint8_t *)pkt->data) + size, rest);
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    pkt->size = rest;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
 void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
 {
     mutex_lock(&_mutex);
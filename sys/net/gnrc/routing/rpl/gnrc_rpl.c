@@ -19,8 +19,15 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc.h"
 #include "mutex.h"
+#include "random.h"
 
 #include "net/gnrc/rpl.h"
+#ifdef MODULE_GNRC_RPL_MRHOF
+#include "net/gnrc/netdev.h"
+#endif
+#ifdef MODULE_NETSTATS_RPL
+#include "gnrc_rpl_internal/netstats.h"
+#endif
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -39,6 +46,9 @@ static msg_t _msg_q[GNRC_RPL_MSG_QUEUE_SIZE];
 static gnrc_netreg_entry_t _me_reg;
 static mutex_t _inst_id_mutex = MUTEX_INIT;
 static uint8_t _instance_id;
+#ifdef MODULE_GNRC_RPL_MRHOF
+static gnrc_netdev_tx_status_t _tx_status = { .cb = gnrc_rpl_parent_etx_update };
+#endif
 
 gnrc_rpl_instance_t gnrc_rpl_instances[GNRC_RPL_INSTANCES_NUMOF];
 gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
@@ -73,6 +83,10 @@ kernel_pid_t gnrc_rpl_init(kernel_pid_t if_pid)
         gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &_me_reg);
 
         gnrc_rpl_of_manager_init();
+#ifdef MODULE_GNRC_RPL_MRHOF
+        /* the ETX of the parents is estimated from the unicast transmissions */
+        gnrc_netdev_tx_status_register(&_tx_status);
+#endif
         xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
 
 #ifdef MODULE_NETSTATS_RPL
@@ -158,6 +172,16 @@ static void _receive(gnrc_pktsnip_t *icmpv6)
             DEBUG("RPL: DIO received\n");
             gnrc_rpl_recv_DIO((gnrc_rpl_dio_t *)(icmpv6_hdr + 1), iface, &ipv6_hdr->src,
                               &ipv6_hdr->dst, byteorder_ntohs(ipv6_hdr->len));
+#ifdef MODULE_GNRC_RPL_MRHOF
+            /* the link layer feedback for the ETX only knows link layer addresses */
+            if (netif) {
+                gnrc_netif_hdr_t *hdr = netif->data;
+
+                gnrc_rpl_parent_set_l2_addr(iface, &ipv6_hdr->src,
+                                            gnrc_netif_hdr_get_src_addr(hdr),
+                                            hdr->src_l2addr_len);
+            }
+#endif
             break;
         case GNRC_RPL_ICMPV6_CODE_DAO:
             DEBUG("RPL: DAO received\n");
@@ -230,6 +254,12 @@ static void *_event_loop(void *args)
                     trickle_callback(trickle);
                 }
                 break;
+#ifdef MODULE_GNRC_RPL_MRHOF
+            case GNRC_RPL_MSG_TYPE_PARENT_ETX:
+                DEBUG("RPL: GNRC_RPL_MSG_TYPE_PARENT_ETX received\n");
+                gnrc_rpl_parent_etx_changed(msg.content.ptr);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("RPL: GNRC_NETAPI_MSG_TYPE_RCV received\n");
                 _receive(msg.content.ptr);
@@ -304,7 +334,16 @@ void _update_lifetime(void)
 
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
-    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    /* a DAO is pending that was not sent yet: it will carry the new targets as well */
+    if ((dodag->dao_counter == 0) && !dodag->dao_ack_received &&
+        (dodag->dao_time <= (GNRC_RPL_DEFAULT_DAO_DELAY + GNRC_RPL_DAO_DELAY_JITTER))) {
+#ifdef MODULE_NETSTATS_RPL
+        gnrc_rpl_netstats_DAO_aggregated(&gnrc_rpl_netstats);
+#endif
+        return;
+    }
+    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY +
+                      random_uint32_range(0, GNRC_RPL_DAO_DELAY_JITTER + 1);
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
 }
@@ -306,9 +306,14 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
-/** @todo allow target prefixes in target options to be of variable length */
+/**
+ * @todo allow target prefixes in target options to be of variable length
+ *
+ * @p routes_changed is set to true if the options of a DAO added, rerouted or
+ * removed a route, it may be NULL
+ */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
-                    ipv6_addr_t *src, uint32_t *included_opts)
+                    ipv6_addr_t *src, uint32_t *included_opts, bool *routes_changed)
 {
     uint16_t l = 0;
     gnrc_rpl_opt_target_t *first_target = NULL;
@@ -316,6 +321,7 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
     eui64_t iid;
     *included_opts = 0;
     ipv6_addr_t *me;
+    bool changed = false;
 
 #ifndef GNRC_RPL_WITHOUT_VALIDATION
     if (!gnrc_rpl_validation_options(msg_type, inst, opt, len)) {
@@ -404,11 +410,14 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                       target->prefix_length,
                       fib_dst_flags);
 
-                fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface, target->target.u8,
-                              sizeof(ipv6_addr_t), fib_dst_flags, src->u8,
-                              sizeof(ipv6_addr_t), FIB_FLAG_RPL_ROUTE,
-                              (dodag->default_lifetime * dodag->lifetime_unit) *
-                              MS_PER_SEC);
+                /* 1 means an existing route was only refreshed */
+                if (fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface, target->target.u8,
+                                  sizeof(ipv6_addr_t), fib_dst_flags, src->u8,
+                                  sizeof(ipv6_addr_t), FIB_FLAG_RPL_ROUTE,
+                                  (dodag->default_lifetime * dodag->lifetime_unit) *
+                                  MS_PER_SEC) == 0) {
+                    changed = true;
+                }
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
@@ -426,14 +435,18 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
                           first_target->prefix_length);
 
-                    fib_update_entry(&gnrc_ipv6_fib_table,
-                                     first_target->target.u8,
-                                     sizeof(ipv6_addr_t), src->u8,
-                                     sizeof(ipv6_addr_t),
-                                     ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
-                                      0x0 : FIB_FLAG_RPL_ROUTE),
-                                     (transit->path_lifetime *
-                                      dodag->lifetime_unit * MS_PER_SEC));
+                    int res = fib_update_entry(&gnrc_ipv6_fib_table,
+                                               first_target->target.u8,
+                                               sizeof(ipv6_addr_t), src->u8,
+                                               sizeof(ipv6_addr_t),
+                                               ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
+                                                0x0 : FIB_FLAG_RPL_ROUTE),
+                                               (transit->path_lifetime *
+                                                dodag->lifetime_unit * MS_PER_SEC));
+                    /* a path lifetime of 0 (no-path DAO) removes the route */
+                    if ((res == 0) || ((res > 0) && (transit->path_lifetime == 0))) {
+                        changed = true;
+                    }
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
                 }
@@ -451,6 +464,9 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
         l += opt->length + sizeof(gnrc_rpl_opt_t);
         opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
     }
+    if (routes_changed != NULL) {
+        *routes_changed = changed;
+    }
     return true;
 }
 
@@ -513,7 +529,7 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
 
         uint32_t included_opts = 0;
         if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DIO, inst, (gnrc_rpl_opt_t *)(dio + 1), len,
-                           src, &included_opts)) {
+                           src, &included_opts, NULL)) {
             DEBUG("RPL: Error encountered during DIO option parsing - remove DODAG\n");
             gnrc_rpl_instance_remove(inst);
             return;
@@ -649,7 +665,7 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
         dodag->prf = dio->g_mop_prf & GNRC_RPL_PRF_MASK;
         uint32_t included_opts = 0;
         if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DIO, inst, (gnrc_rpl_opt_t *)(dio + 1), len,
-                           src, &included_opts)) {
+                           src, &included_opts, NULL)) {
             DEBUG("RPL: Error encountered during DIO option parsing - remove DODAG\n");
             gnrc_rpl_instance_remove(inst);
             return;
@@ -730,6 +746,9 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
     gnrc_rpl_dao_t *dao;
     bool ext_processed = false, int_processed = false;
+#ifdef MODULE_NETSTATS_RPL
+    unsigned targets = 1;
+#endif
 
     /* find my address */
     ipv6_addr_t *me = NULL;
@@ -782,6 +801,9 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
                     mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
                     return;
                 }
+#ifdef MODULE_NETSTATS_RPL
+                targets++;
+#endif
             }
         }
     }
@@ -847,6 +869,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
 #ifdef MODULE_NETSTATS_RPL
     gnrc_rpl_netstats_tx_DAO(&gnrc_rpl_netstats, gnrc_pkt_len(pkt),
                              (destination && !ipv6_addr_is_multicast(destination)));
+    gnrc_rpl_netstats_tx_DAO_targets(&gnrc_rpl_netstats, targets);
 #endif
 
     gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
@@ -957,7 +980,9 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
 #endif
 
     uint32_t included_opts = 0;
-    if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DAO, inst, opts, len, src, &included_opts)) {
+    bool routes_changed = false;
+    if(!_parse_options(GNRC_RPL_ICMPV6_CODE_DAO, inst, opts, len, src, &included_opts,
+                       &routes_changed)) {
         DEBUG("RPL: Error encountered during DAO option parsing - ignore DAO\n");
         return;
     }
@@ -967,6 +992,16 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         gnrc_rpl_send_DAO_ACK(inst, src, dao->dao_sequence);
     }
 
+    /* only added, removed or rerouted targets need to be announced to the parents
+     * right away, refreshed ones are included in the next regular DAO */
+    if (!routes_changed) {
+        DEBUG("RPL: DAO did not change any route - not triggering a DAO\n");
+#ifdef MODULE_NETSTATS_RPL
+        gnrc_rpl_netstats_DAO_suppressed(&gnrc_rpl_netstats);
+#endif
+        return;
+    }
+
     gnrc_rpl_delay_dao(dodag);
 }
 
@@ -16,6 +16,8 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
+#include "mutex.h"
 #include "net/af.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -36,7 +38,13 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag);
+#ifdef MODULE_GNRC_RPL_MRHOF
+/* protects the link estimates of the parents against the device threads */
+static mutex_t _etx_mutex = MUTEX_INIT;
+#endif
+
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *parent);
 static void _rpl_trickle_send_dio(void *args);
 
 static void _rpl_trickle_send_dio(void *args)
@@ -201,6 +209,14 @@ bool gnrc_rpl_parent_add_by_addr(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
     if (*parent != NULL) {
         (*parent)->dodag = dodag;
         LL_APPEND(dodag->parents, *parent);
+#ifdef MODULE_GNRC_RPL_MRHOF
+        mutex_lock(&_etx_mutex);
+        (*parent)->l2_addr_len = 0;
+        (*parent)->etx_tries = 0;
+        (*parent)->etx = GNRC_RPL_ETX_INIT;
+        (*parent)->etx_changed = 0;
+        mutex_unlock(&_etx_mutex);
+#endif
         (*parent)->state = 1;
         (*parent)->addr = *addr;
         return true;
@@ -238,10 +254,90 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
         }
     }
     LL_DELETE(dodag->parents, parent);
+#ifdef MODULE_GNRC_RPL_MRHOF
+    mutex_lock(&_etx_mutex);
+#endif
     memset(parent, 0, sizeof(gnrc_rpl_parent_t));
+#ifdef MODULE_GNRC_RPL_MRHOF
+    mutex_unlock(&_etx_mutex);
+#endif
     return true;
 }
 
+#ifdef MODULE_GNRC_RPL_MRHOF
+void gnrc_rpl_parent_set_l2_addr(kernel_pid_t iface, const ipv6_addr_t *addr,
+                                 const uint8_t *l2_addr, size_t l2_addr_len)
+{
+    if (l2_addr_len > GNRC_RPL_PARENT_L2_ADDR_MAX) {
+        return;
+    }
+
+    mutex_lock(&_etx_mutex);
+    for (uint8_t i = 0; i < GNRC_RPL_PARENTS_NUMOF; ++i) {
+        gnrc_rpl_parent_t *parent = &gnrc_rpl_parents[i];
+
+        if ((parent->state != 0) && (parent->dodag->iface == iface) &&
+            ipv6_addr_equal(&parent->addr, addr)) {
+            memcpy(parent->l2_addr, l2_addr, l2_addr_len);
+            parent->l2_addr_len = l2_addr_len;
+        }
+    }
+    mutex_unlock(&_etx_mutex);
+}
+
+void gnrc_rpl_parent_etx_update(kernel_pid_t iface, const uint8_t *l2_addr,
+                                size_t l2_addr_len, bool acked)
+{
+    mutex_lock(&_etx_mutex);
+    for (uint8_t i = 0; i < GNRC_RPL_PARENTS_NUMOF; ++i) {
+        gnrc_rpl_parent_t *parent = &gnrc_rpl_parents[i];
+        uint32_t sample;
+
+        if ((parent->state == 0) || (parent->dodag->iface != iface) ||
+            (parent->l2_addr_len != l2_addr_len) ||
+            (memcmp(parent->l2_addr, l2_addr, l2_addr_len) != 0)) {
+            continue;
+        }
+        if (!acked && (++parent->etx_tries < GNRC_RPL_ETX_MAX_TRIES)) {
+            continue;
+        }
+        /* frames it took to get one through (or to give up) */
+        sample = (acked ? parent->etx_tries + 1 : parent->etx_tries);
+        sample *= GNRC_RPL_ETX_DIVISOR;
+        parent->etx = (uint16_t)((((uint32_t)parent->etx * (GNRC_RPL_ETX_WEIGHT - 1)) +
+                                  sample) / GNRC_RPL_ETX_WEIGHT);
+        parent->etx_tries = 0;
+        DEBUG("RPL: ETX of parent %s is now %u\n",
+              ipv6_addr_to_str(addr_str, &parent->addr, sizeof(addr_str)),
+              (unsigned)parent->etx);
+        /* one message per parent is enough, the RPL thread reads the
+         * latest ETX */
+        if (!parent->etx_changed && (gnrc_rpl_pid != KERNEL_PID_UNDEF)) {
+            msg_t msg = { .type = GNRC_RPL_MSG_TYPE_PARENT_ETX,
+                          .content = { .ptr = parent } };
+
+            parent->etx_changed = (msg_try_send(&msg, gnrc_rpl_pid) == 1);
+        }
+    }
+    mutex_unlock(&_etx_mutex);
+}
+
+void gnrc_rpl_parent_etx_changed(gnrc_rpl_parent_t *parent)
+{
+    mutex_lock(&_etx_mutex);
+    parent->etx_changed = 0;
+    mutex_unlock(&_etx_mutex);
+
+    /* the parent may have been removed meanwhile */
+    if (parent->state == 0) {
+        return;
+    }
+    if (_gnrc_rpl_find_preferred_parent(parent->dodag, parent) == NULL) {
+        gnrc_rpl_local_repair(parent->dodag);
+    }
+}
+#endif
+
 void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
 {
     DEBUG("RPL: [INFO] Local Repair started\n");
@@ -287,20 +383,46 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 #endif
     }
 
-    if (_gnrc_rpl_find_preferred_parent(dodag) == NULL) {
+    if (_gnrc_rpl_find_preferred_parent(dodag, parent) == NULL) {
         gnrc_rpl_local_repair(dodag);
     }
 }
 
 /**
- * @brief   Find the parent with the lowest rank and update the DODAG's preferred parent
+ * @brief   Inserts a parent behind the preferred parent, in the order of the
+ *          objective function
+ *
+ * @param[in] dodag     Pointer to the DODAG, must have a preferred parent
+ * @param[in] parent    Pointer to the parent, must not be in the parent list
+ */
+static void _gnrc_rpl_insert_parent(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
+{
+    gnrc_rpl_parent_t *prev = dodag->parents;
+
+    while ((prev->next != NULL) &&
+           (dodag->instance->of->which_parent(prev->next, parent) == prev->next)) {
+        prev = prev->next;
+    }
+    parent->next = prev->next;
+    prev->next = parent;
+}
+
+/**
+ * @brief   Find the best parent and update the DODAG's preferred parent
+ *
+ * The parent list starts with the preferred parent, followed by the other
+ * parents in the order of the objective function. Only @p parent is moved
+ * within the list, and the preferred parent is only compared to the best of
+ * the others.
  *
  * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Pointer to the parent that was updated, may be NULL
  *
  * @return  Pointer to the preferred parent, on success.
  * @return  NULL, otherwise.
  */
-static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag)
+static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag,
+                                                          gnrc_rpl_parent_t *parent)
 {
     gnrc_rpl_parent_t *old_best = dodag->parents;
     gnrc_rpl_parent_t *new_best = old_best;
@@ -311,8 +433,14 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
         return NULL;
     }
 
-    LL_FOREACH(dodag->parents, elt) {
-        new_best = dodag->instance->of->which_parent(new_best, elt);
+    if ((parent != NULL) && (parent != old_best)) {
+        LL_DELETE(dodag->parents, parent);
+        _gnrc_rpl_insert_parent(dodag, parent);
+    }
+
+    if ((old_best->next != NULL) &&
+        (dodag->instance->of->which_parent(old_best, old_best->next) != old_best)) {
+        new_best = old_best->next;
     }
 
     if (new_best->rank == GNRC_RPL_INFINITE_RANK) {
@@ -320,8 +448,8 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
     }
 
     if (new_best != old_best) {
-        LL_DELETE(dodag->parents, new_best);
-        LL_PREPEND(dodag->parents, new_best);
+        LL_DELETE(dodag->parents, old_best);
+        _gnrc_rpl_insert_parent(dodag, old_best);
         /* no-path DAOs only for the storing mode */
         if ((dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_NO_MC) ||
             (dodag->instance->mop == GNRC_RPL_MOP_STORING_MODE_MC)) {
@@ -348,16 +476,25 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
     }
 
     dodag->my_rank = dodag->instance->of->calc_rank(dodag->parents, 0);
-    if (dodag->my_rank != old_rank) {
+    /* the rank may change with every link estimate, but only a changed DAGRank
+     * is of interest to other nodes */
+    if (DAGRANK(dodag->my_rank, dodag->instance->min_hop_rank_inc)
+        != DAGRANK(old_rank, dodag->instance->min_hop_rank_inc)) {
         trickle_reset_timer(&dodag->trickle);
-    }
 
-    LL_FOREACH_SAFE(dodag->parents, elt, tmp) {
-        if (DAGRANK(dodag->my_rank, dodag->instance->min_hop_rank_inc)
-            <= DAGRANK(elt->rank, dodag->instance->min_hop_rank_inc)) {
-            gnrc_rpl_parent_remove(elt);
+        LL_FOREACH_SAFE(dodag->parents, elt, tmp) {
+            if (DAGRANK(dodag->my_rank, dodag->instance->min_hop_rank_inc)
+                <= DAGRANK(elt->rank, dodag->instance->min_hop_rank_inc)) {
+                gnrc_rpl_parent_remove(elt);
+            }
         }
     }
+    /* with an unchanged DAGRank, only the updated parent can have become invalid */
+    else if ((parent != NULL) && (parent != dodag->parents) &&
+             (DAGRANK(dodag->my_rank, dodag->instance->min_hop_rank_inc)
+              <= DAGRANK(parent->rank, dodag->instance->min_hop_rank_inc))) {
+        gnrc_rpl_parent_remove(parent);
+    }
 
     return dodag->parents;
 }
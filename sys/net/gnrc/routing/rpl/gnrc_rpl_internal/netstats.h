@@ -183,6 +183,37 @@ static inline void gnrc_rpl_netstats_tx_DAO_ACK(netstats_rpl_t *netstats, size_t
     }
 }
 
+/**
+ * @brief   Increase statistics for the targets of a sent DAO
+ *
+ * @param[in]   netstats    Pointer to netstats_rpl_t
+ * @param[in]   targets     Number of target options in the DAO
+ */
+static inline void gnrc_rpl_netstats_tx_DAO_targets(netstats_rpl_t *netstats, unsigned targets)
+{
+    netstats->dao_tx_targets += targets;
+}
+
+/**
+ * @brief   Increase statistics for a DAO trigger merged into a scheduled DAO
+ *
+ * @param[in]   netstats    Pointer to netstats_rpl_t
+ */
+static inline void gnrc_rpl_netstats_DAO_aggregated(netstats_rpl_t *netstats)
+{
+    netstats->dao_aggregated++;
+}
+
+/**
+ * @brief   Increase statistics for a received DAO that did not trigger a DAO
+ *
+ * @param[in]   netstats    Pointer to netstats_rpl_t
+ */
+static inline void gnrc_rpl_netstats_DAO_suppressed(netstats_rpl_t *netstats)
+{
+    netstats->dao_suppressed++;
+}
+
 #ifdef __cplusplus
 }
 #endif
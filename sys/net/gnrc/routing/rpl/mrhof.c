@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF with the ETX metric.
+ * @}
+ */
+
+#ifdef MODULE_GNRC_RPL_MRHOF
+
+#include "mrhof.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+/* converts a metric value to rank units */
+static inline uint32_t _to_rank(gnrc_rpl_parent_t *parent, uint32_t metric)
+{
+    return (metric * parent->dodag->instance->min_hop_rank_inc) / GNRC_RPL_ETX_DIVISOR;
+}
+
+/* rank increase of the link to the parent, infinite if the link is too bad */
+static uint16_t _link_cost(gnrc_rpl_parent_t *parent)
+{
+    if (parent->etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    return (uint16_t)_to_rank(parent, parent->etx);
+}
+
+/* rank of the path through the parent */
+static uint16_t _path_cost(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint32_t cost = (uint32_t)base_rank + _link_cost(parent);
+
+    return (cost >= GNRC_RPL_INFINITE_RANK) ? GNRC_RPL_INFINITE_RANK : (uint16_t)cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void) dodag;
+}
+
+/* The link estimates change all the time, so the current rank is kept as long as
+ * it is valid and the path cost did not move by the switch threshold. */
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint16_t rank, cur, mhri, diff;
+
+    if (parent == NULL) {
+        if ((base_rank == 0) ||
+            ((base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE) < base_rank)) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+        return base_rank + GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    if (base_rank != 0) {
+        return _path_cost(parent, base_rank);
+    }
+
+    rank = _path_cost(parent, parent->rank);
+    cur = parent->dodag->my_rank;
+    mhri = parent->dodag->instance->min_hop_rank_inc;
+    diff = (rank > cur) ? rank - cur : cur - rank;
+    if ((rank != GNRC_RPL_INFINITE_RANK) && (cur != GNRC_RPL_INFINITE_RANK) &&
+        (DAGRANK(cur, mhri) > DAGRANK(parent->rank, mhri)) &&
+        (diff < _to_rank(parent, GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD))) {
+        return cur;
+    }
+    return rank;
+}
+
+/* The parent with the lower path cost, but only replace the preferred parent
+ * if that saves at least GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    gnrc_rpl_parent_t *preferred = p1->dodag->parents;
+    uint32_t c1 = _path_cost(p1, p1->rank);
+    uint32_t c2 = _path_cost(p2, p2->rank);
+
+    if (p2 == preferred) {
+        gnrc_rpl_parent_t *tmp = p1;
+        uint32_t c = c1;
+
+        p1 = p2;
+        p2 = tmp;
+        c1 = c2;
+        c2 = c;
+    }
+    if ((p1 == preferred) && (c1 != GNRC_RPL_INFINITE_RANK)) {
+        c2 += _to_rank(p1, GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD);
+        return (c2 < c1) ? p2 : p1;
+    }
+
+    return (c1 <= c2) ? p1 : p2;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_RPL_MRHOF */
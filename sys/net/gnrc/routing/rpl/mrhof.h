@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF with the ETX metric as defined in
+ * <a href="https://tools.ietf.org/html/rfc6719">RFC 6719</a>, used with the
+ * `gnrc_rpl_mrhof` pseudomodule. The ETX of a parent is kept with the parent
+ * (see gnrc_rpl_parent_etx_update()). Metric values are in units of
+ * @ref GNRC_RPL_ETX_DIVISOR, i.e. encoded like in the ETX metric object of
+ * RFC 6551.
+ */
+
+#ifndef MRHOF_H
+#define MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (0x1)
+
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+/**
+ * @brief   Highest ETX of a link to a parent that may become the preferred one
+ */
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512)
+#endif
+
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+/**
+ * @brief   ETX by which the path through another parent must be better than
+ *          the one through the preferred parent to switch to it, and by which
+ *          the path cost must change to advertise a new rank
+ */
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MRHOF_H */
+/**
+ * @}
+ */
@@ -21,8 +21,13 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/netreg.h"
 #include "net/udp.h"
+#include "irq.h"
 #include "utlist.h"
 #include "xtimer.h"
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "net/sock/async.h"
+#include "thread_flags.h"
+#endif
 
 #include "sock_types.h"
 #include "gnrc_sock_internal.h"
@@ -44,10 +49,136 @@ static void _callback_put(void *arg)
 }
 #endif
 
+#ifdef MODULE_GNRC_SOCK_ASYNC
+/* must be called with interrupts disabled, returns the thread to wake up
+ * with _async_wake() after interrupts were restored */
+static thread_t *_async_ready(gnrc_sock_reg_t *reg)
+{
+    sock_async_loop_t *loop = reg->async_loop;
+
+    if ((loop == NULL) || reg->async_ready) {
+        return NULL;
+    }
+    reg->async_ready = true;
+    LL_APPEND2(loop->ready, reg, async_next);
+    return loop->thread;
+}
+
+static inline void _async_wake(thread_t *thread)
+{
+    if (thread != NULL) {
+        thread_flags_set(thread, SOCK_ASYNC_THREAD_FLAG);
+    }
+}
+
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    gnrc_sock_reg_t *reg = ctx;
+    msg_t msg = { .type = cmd, .content = { .ptr = pkt } };
+    thread_t *thread;
+    unsigned state;
+
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        /* drop packet as netapi would do for a full mbox */
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    state = irq_disable();
+    thread = _async_ready(reg);
+    irq_restore(state);
+    _async_wake(thread);
+}
+
+void gnrc_sock_set_cb(gnrc_sock_reg_t *reg, sock_async_loop_t *loop,
+                      gnrc_sock_async_cb_t cb, void *cb_arg)
+{
+    thread_t *thread = NULL;
+    unsigned state = irq_disable();
+
+    if (reg->async_ready) {
+        LL_DELETE2(reg->async_loop->ready, reg, async_next);
+        reg->async_ready = false;
+    }
+    if ((loop == NULL) || (cb == NULL)) {
+        reg->async_loop = NULL;
+    }
+    else {
+        reg->async_loop = loop;
+        reg->async_cb = cb;
+        reg->async_cb_arg = cb_arg;
+        /* report data that arrived before the callback was set */
+        if (cib_avail(&reg->mbox.cib) > 0) {
+            thread = _async_ready(reg);
+        }
+    }
+    irq_restore(state);
+    _async_wake(thread);
+}
+
+void sock_async_loop_init(sock_async_loop_t *loop)
+{
+    assert(loop != NULL);
+    loop->thread = (thread_t *)sched_active_thread;
+    loop->ready = NULL;
+}
+
+unsigned sock_async_loop_dispatch(sock_async_loop_t *loop)
+{
+    gnrc_sock_reg_t *reg;
+    unsigned count = 0, num = 0;
+    unsigned state;
+
+    assert(loop->thread == sched_active_thread);
+    /* only dispatch the socks that are ready now, so a sock that has data
+     * left after its callback returned does not starve the others */
+    state = irq_disable();
+    LL_COUNT2(loop->ready, reg, num, async_next);
+    irq_restore(state);
+    while (count < num) {
+        thread_t *thread = NULL;
+
+        state = irq_disable();
+        reg = loop->ready;
+        if (reg == NULL) {
+            /* socks removed meanwhile */
+            irq_restore(state);
+            break;
+        }
+        LL_DELETE2(loop->ready, reg, async_next);
+        reg->async_ready = false;
+        irq_restore(state);
+        /* reg is the first member of every sock type */
+        reg->async_cb(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
+        count++;
+        state = irq_disable();
+        if (cib_avail(&reg->mbox.cib) > 0) {
+            thread = _async_ready(reg);
+        }
+        irq_restore(state);
+        _async_wake(thread);
+    }
+    return count;
+}
+
+void sock_async_loop_run(sock_async_loop_t *loop)
+{
+    while (1) {
+        thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG);
+        sock_async_loop_dispatch(loop);
+    }
+}
+#endif /* MODULE_GNRC_SOCK_ASYNC */
+
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    reg->netreg_cb.cb = _netapi_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
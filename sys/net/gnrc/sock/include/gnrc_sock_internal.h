@@ -30,6 +30,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/iana/portrange.h"
 #include "net/sock/ip.h"
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "net/sock/async.h"
+#endif
 
 #include "sock_types.h"
 
@@ -102,6 +105,29 @@ static inline bool gnrc_ep_addr_any(const sock_ip_ep_t *ep)
  */
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx);
 
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Initialize the asynchronous part of a sock without callback
+ * @internal
+ */
+static inline void gnrc_sock_async_init(gnrc_sock_reg_t *reg)
+{
+    /* the mbox is checked for data when the callback is set, even if the
+     * sock is not bound yet */
+    mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+    reg->async_loop = NULL;
+    reg->async_ready = false;
+}
+
+/**
+ * @brief   Set or remove (with @p loop or @p cb being NULL) the callback of
+ *          a sock
+ * @internal
+ */
+void gnrc_sock_set_cb(gnrc_sock_reg_t *reg, sock_async_loop_t *loop,
+                      gnrc_sock_async_cb_t cb, void *cb_arg);
+#endif
+
 /**
  * @brief   Receive a packet internally
  * @internal
@@ -31,6 +31,9 @@
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_ASYNC
+#include "thread.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +43,15 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+#ifdef MODULE_GNRC_SOCK_ASYNC
+/**
+ * @brief   Callback of an asynchronous sock, called with the sock object
+ * @internal
+ */
+typedef void (*gnrc_sock_async_cb_t)(void *sock, sock_async_flags_t flags,
+                                     void *arg);
+#endif
+
 /**
  * @brief   sock @ref net_gnrc_netreg info
  * @internal
@@ -51,8 +63,31 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    /**
+     * @brief   callback for gnrc_sock_reg_t::entry that fills
+     *          gnrc_sock_reg_t::mbox and notifies gnrc_sock_reg_t::async_loop
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    struct sock_async_loop *async_loop; /**< loop to call async_cb in */
+    struct gnrc_sock_reg *async_next;   /**< next in the loop's ready list */
+    gnrc_sock_async_cb_t async_cb;      /**< callback of the sock */
+    void *async_cb_arg;                 /**< argument for async_cb */
+    bool async_ready;                   /**< sock is in the loop's ready list */
+#endif
 } gnrc_sock_reg_t;
 
+#ifdef MODULE_GNRC_SOCK_ASYNC
+/**
+ * @brief   Event loop for asynchronous socks
+ * @internal
+ */
+struct sock_async_loop {
+    thread_t *thread;                   /**< thread running the loop */
+    gnrc_sock_reg_t *ready;             /**< socks with pending events */
+};
+#endif
+
 /**
  * @brief   Raw IP sock type
  * @internal
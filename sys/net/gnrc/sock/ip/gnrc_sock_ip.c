@@ -36,6 +36,9 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_async_init(&sock->reg);
+#endif
     memset(&sock->local, 0, sizeof(sock_ip_ep_t));
     if (local != NULL) {
         if (gnrc_af_not_supported(local->family)) {
@@ -63,8 +66,20 @@ void sock_ip_close(sock_ip_t *sock)
 {
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &sock->reg.entry);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_set_cb(&sock->reg, NULL, NULL, NULL);
+#endif
 }
 
+#ifdef MODULE_GNRC_SOCK_ASYNC
+void sock_ip_set_cb(sock_ip_t *sock, sock_async_loop_t *loop, sock_ip_cb_t cb,
+                    void *cb_arg)
+{
+    assert(sock != NULL);
+    gnrc_sock_set_cb(&sock->reg, loop, (gnrc_sock_async_cb_t)cb, cb_arg);
+}
+#endif
+
 int sock_ip_get_local(sock_ip_t *sock, sock_ip_ep_t *local)
 {
     assert(sock && local);
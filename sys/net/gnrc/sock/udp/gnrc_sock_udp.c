@@ -96,6 +96,9 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         (local->netif != remote->netif)) {
         return -EINVAL;
     }
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_async_init(&sock->reg);
+#endif
     memset(&sock->local, 0, sizeof(sock_udp_ep_t));
     if (local != NULL) {
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
@@ -138,6 +141,9 @@ void sock_udp_close(sock_udp_t *sock)
 {
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_set_cb(&sock->reg, NULL, NULL, NULL);
+#endif
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     if (_udp_socks != NULL) {
         gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
@@ -166,15 +172,28 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+#ifdef MODULE_GNRC_SOCK_ASYNC
+void sock_udp_set_cb(sock_udp_t *sock, sock_async_loop_t *loop,
+                     sock_udp_cb_t cb, void *cb_arg)
+{
+    assert(sock != NULL);
+    gnrc_sock_set_cb(&sock->reg, loop, (gnrc_sock_async_cb_t)cb, cb_arg);
+}
+#endif
+
+/**
+ * @brief   Receives a UDP packet for @p sock
+ *
+ * @return  Length of the UDP payload, which is the first snip of @p pkt_out
+ */
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -183,10 +202,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -205,22 +220,89 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    *pkt_out = pkt;
+    return (ssize_t)pkt->size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    if ((size_t)res > max_len) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
     memcpy(data, pkt->data, pkt->size);
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+ssize_t sock_udp_recv_many(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                           unsigned num, uint32_t timeout)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
-    uint16_t src_port = 0, dst_port;
-    sock_ip_ep_t local;
-    sock_ip_ep_t *rem;
+    unsigned i;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    for (i = 0; i < num; i++) {
+        ssize_t res;
 
+        /* only wait for the first message */
+        res = sock_udp_recv(sock, msgs[i].data, msgs[i].len,
+                            (i == 0) ? timeout : 0, msgs[i].remote);
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+        msgs[i].len = (size_t)res;
+    }
+    return (ssize_t)i;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return res;
+}
+
+void sock_udp_recv_buf_free(void *buf_ctx)
+{
+    assert(buf_ctx != NULL);
+    gnrc_pktbuf_release(buf_ctx);
+}
+
+/**
+ * @brief   Checks the end points for sending with @p sock to @p remote and
+ *          binds @p sock implicitly if required
+ *
+ * @param[out] local    local end point to send from
+ * @param[out] rem      remote end point to send to
+ * @param[out] src_port source port to send from
+ * @param[out] dst_port destination port to send to
+ */
+static int _send_prepare(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                         sock_ip_ep_t *local, sock_ip_ep_t **rem,
+                         uint16_t *src_port, uint16_t *dst_port)
+{
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -248,20 +330,20 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     /* cppcheck-suppress nullPointer */
     if ((sock == NULL) || (sock->local.family == AF_UNSPEC)) {
         /* no sock or sock currently unbound */
-        memset(&local, 0, sizeof(local));
-        if ((src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
+        memset(local, 0, sizeof(*local));
+        if ((*src_port = _get_dyn_port(sock)) == GNRC_SOCK_DYN_PORTRANGE_ERR) {
             return -EINVAL;
         }
         if (sock != NULL) {
             /* bind sock object implicitly */
-            sock->local.port = src_port;
+            sock->local.port = *src_port;
             if (remote == NULL) {
                 sock->local.family = sock->remote.family;
             }
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, *src_port);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -270,25 +352,35 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         }
     }
     else {
-        src_port = sock->local.port;
-        memcpy(&local, &sock->local, sizeof(local));
+        *src_port = sock->local.port;
+        memcpy(local, &sock->local, sizeof(*local));
     }
     /* sock can't be NULL at this point */
     if (remote == NULL) {
-        rem = (sock_ip_ep_t *)&sock->remote;
-        dst_port = sock->remote.port;
+        *rem = (sock_ip_ep_t *)&sock->remote;
+        *dst_port = sock->remote.port;
     }
     else {
-        rem = (sock_ip_ep_t *)remote;
-        dst_port = remote->port;
+        *rem = (sock_ip_ep_t *)remote;
+        *dst_port = remote->port;
     }
     /* check for matching address families in local and remote */
-    if (local.family == AF_UNSPEC) {
-        local.family = rem->family;
+    if (local->family == AF_UNSPEC) {
+        local->family = (*rem)->family;
     }
-    else if (local.family != rem->family) {
+    else if (local->family != (*rem)->family) {
         return -EINVAL;
     }
+    return 0;
+}
+
+static ssize_t _send(const void *data, size_t len, sock_ip_ep_t *local,
+                     const sock_ip_ep_t *rem, uint16_t src_port,
+                     uint16_t dst_port)
+{
+    gnrc_pktsnip_t *payload, *pkt;
+    ssize_t res;
+
     /* generate payload and header snips */
     payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
@@ -299,11 +391,62 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, local, rem, PROTNUM_UDP);
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
     return res;
 }
 
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    int res;
+    uint16_t src_port = 0, dst_port;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem;
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+
+    res = _send_prepare(sock, remote, &local, &rem, &src_port, &dst_port);
+    if (res < 0) {
+        return res;
+    }
+    return _send(data, len, &local, rem, src_port, dst_port);
+}
+
+ssize_t sock_udp_send_many(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                           unsigned num)
+{
+    uint16_t src_port = 0, dst_port = 0;
+    sock_ip_ep_t local;
+    sock_ip_ep_t *rem = NULL;
+    unsigned i;
+
+    assert(msgs != NULL);
+    for (i = 0; i < num; i++) {
+        ssize_t res = 0;
+
+        assert((msgs[i].len == 0) || (msgs[i].data != NULL));
+        /* without a sock every message is sent from a new source port, as
+         * with sock_udp_send() */
+        if ((i == 0) || (sock == NULL) ||
+            (msgs[i].remote != msgs[i - 1].remote)) {
+            res = _send_prepare(sock, msgs[i].remote, &local, &rem,
+                                &src_port, &dst_port);
+        }
+        if (res >= 0) {
+            res = _send(msgs[i].data, msgs[i].len, &local, rem, src_port,
+                        dst_port);
+        }
+        if (res < 0) {
+            if (i == 0) {
+                return res;
+            }
+            break;
+        }
+    }
+    return (ssize_t)i;
+}
+
 /** @} */
@@ -35,6 +35,13 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if (GNRC_TCP_RCV_BUF_SIZE >> GNRC_TCP_WND_SCALE) > 0xFFFF
+#error "GNRC_TCP_WND_SCALE is too small to announce the whole GNRC_TCP_RCV_BUF_SIZE"
+#endif
+#if GNRC_TCP_WND_SCALE > TCP_WS_SHIFT_MAX
+#error "GNRC_TCP_WND_SCALE must not exceed 14"
+#endif
+
 /**
  * @brief Allocate memory for TCP thread's stack
  */
@@ -226,17 +233,23 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->iss = 0;
     tcb->irs = 0;
     tcb->mss = 0;
+    tcb->snd_wnd_scale = 0;
+    tcb->rcv_wnd_scale = 0;
+    tcb->dup_acks = 0;
     tcb->rtt_start = 0;
+    tcb->rtt_seq = 0;
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
     tcb->retries = 0;
-    tcb->pkt_retransmit = NULL;
+    tcb->retransmit_cnt = 0;
+    tcb->out_cnt = 0;
     tcb->owner = KERNEL_PID_UNDEF;
     tcb->rcv_buf_raw = NULL;
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
     tcb->next = NULL;
+    tcb->hash_next = NULL;
 }
 
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  const uint8_t address_family,
@@ -328,8 +341,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         xtimer_set_msg(&user_timeout_timer, timeout_duration_us, &user_timeout_msg, tcb->owner);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent and there is room to send further segments */
+    while (ret == 0 || tcb->retransmit_cnt >= GNRC_TCP_SND_SEGMENTS) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/demux.h
+ * @}
+ */
+
+#include <utlist.h>
+#include "net/af.h"
+#include "internal/common.h"
+#include "internal/fsm.h"
+#include "internal/demux.h"
+
+#ifdef MODULE_GNRC_IPV6
+#include "net/gnrc/ipv6.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (GNRC_TCP_DEMUX_BUCKETS & (GNRC_TCP_DEMUX_BUCKETS - 1))
+#error "GNRC_TCP_DEMUX_BUCKETS must be a power of two"
+#endif
+
+/**
+ * @brief Hash table of connections with a known peer
+ */
+static gnrc_tcp_tcb_t *_buckets[GNRC_TCP_DEMUX_BUCKETS];
+
+/**
+ * @brief Calculates the bucket of a connection
+ *
+ * @param[in] local_port   Local port of the connection.
+ * @param[in] peer_port    Peer port of the connection.
+ * @param[in] peer_addr    Peer address of the connection.
+ *
+ * @return   Index into _buckets.
+ */
+static unsigned _hash(uint16_t local_port, uint16_t peer_port, const uint8_t *peer_addr)
+{
+    uint32_t hash = ((uint32_t) local_port << 16) | peer_port;
+
+#ifdef MODULE_GNRC_IPV6
+    /* Peers differ mostly in the interface identifier */
+    for (unsigned i = sizeof(ipv6_addr_t) / 2; i < sizeof(ipv6_addr_t); ++i) {
+        hash = (hash * 31) + peer_addr[i];
+    }
+#else
+    (void) peer_addr;
+#endif
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (GNRC_TCP_DEMUX_BUCKETS - 1);
+}
+
+/**
+ * @brief Checks if a connection has the given peer
+ *
+ * @param[in] tcb          Connection to check.
+ * @param[in] local_port   Local port to compare.
+ * @param[in] peer_port    Peer port to compare.
+ * @param[in] peer_addr    Peer address to compare.
+ *
+ * @return   true if ports and peer address match, false otherwise.
+ */
+static bool _matches(const gnrc_tcp_tcb_t *tcb, uint16_t local_port, uint16_t peer_port,
+                     const uint8_t *peer_addr)
+{
+    if (tcb->local_port != local_port || tcb->peer_port != peer_port) {
+        return false;
+    }
+    switch (tcb->address_family) {
+#ifdef MODULE_GNRC_IPV6
+        case AF_INET6:
+            return ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) peer_addr);
+#endif
+        default:
+            (void) peer_addr;
+            return false;
+    }
+}
+
+void _demux_add(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_t **bucket;
+    gnrc_tcp_tcb_t *iter;
+
+#ifdef MODULE_GNRC_IPV6
+    bucket = &_buckets[_hash(tcb->local_port, tcb->peer_port, tcb->peer_addr)];
+#else
+    bucket = &_buckets[_hash(tcb->local_port, tcb->peer_port, NULL)];
+#endif
+    for (iter = *bucket; iter != NULL; iter = iter->hash_next) {
+        if (iter == tcb) {
+            return;
+        }
+    }
+    DEBUG("gnrc_tcp_demux.c : _demux_add() : tcb=%p\n", (void *) tcb);
+    tcb->hash_next = *bucket;
+    *bucket = tcb;
+}
+
+void _demux_remove(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_tcp_tcb_t **iter;
+
+#ifdef MODULE_GNRC_IPV6
+    iter = &_buckets[_hash(tcb->local_port, tcb->peer_port, tcb->peer_addr)];
+#else
+    iter = &_buckets[_hash(tcb->local_port, tcb->peer_port, NULL)];
+#endif
+    for (; *iter != NULL; iter = &(*iter)->hash_next) {
+        if (*iter == tcb) {
+            DEBUG("gnrc_tcp_demux.c : _demux_remove() : tcb=%p\n", (void *) tcb);
+            *iter = tcb->hash_next;
+            tcb->hash_next = NULL;
+            return;
+        }
+    }
+}
+
+gnrc_tcp_tcb_t *_demux_lookup(uint16_t local_port, uint16_t peer_port,
+                              const uint8_t *peer_addr)
+{
+    gnrc_tcp_tcb_t *iter = _buckets[_hash(local_port, peer_port, peer_addr)];
+
+    while (iter != NULL && !_matches(iter, local_port, peer_port, peer_addr)) {
+        iter = iter->hash_next;
+    }
+    return iter;
+}
+
+gnrc_tcp_tcb_t *_demux_lookup_listener(uint16_t local_port, const uint8_t *local_addr)
+{
+    gnrc_tcp_tcb_t *iter;
+
+    LL_FOREACH(_list_tcb_head, iter) {
+        if (iter->state != FSM_STATE_LISTEN || iter->local_port != local_port) {
+            continue;
+        }
+        switch (iter->address_family) {
+#ifdef MODULE_GNRC_IPV6
+            case AF_INET6:
+                /* Local address must be unspecified or match */
+                if (ipv6_addr_is_unspecified((ipv6_addr_t *) iter->local_addr) ||
+                    ipv6_addr_equal((ipv6_addr_t *) iter->local_addr,
+                                    (ipv6_addr_t *) local_addr)) {
+                    return iter;
+                }
+                break;
+#endif
+            default:
+                (void) local_addr;
+                break;
+        }
+    }
+    return NULL;
+}
@@ -24,6 +24,7 @@
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/fsm.h"
+#include "internal/demux.h"
 #include "internal/eventloop.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -144,8 +145,9 @@ static int _receive(gnrc_pktsnip_t *pkt)
         pkt->type = GNRC_NETTYPE_UNDEF;
     }
 
-    /* Validate Checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    /* Validate Checksum, unless the device did already */
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
@@ -153,39 +155,24 @@ static int _receive(gnrc_pktsnip_t *pkt)
 
     /* Find tcb to de-multiplex this packet to */
     mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
 #ifdef MODULE_GNRC_IPV6
-        /* Check if current tcb is fitting for the incomming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or preconfigured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
+    if (ip->type == GNRC_NETTYPE_IPV6) {
+        ipv6_hdr_t *ip6_hdr = (ipv6_hdr_t *)ip->data;
 
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IP-Addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
+        /* If SYN is set, a connection is listening on that port, else it is an ongoing one */
+        if (syn) {
+            tcb = _demux_lookup_listener(dst, (uint8_t *) &ip6_hdr->dst);
+        }
+        else {
+            tcb = _demux_lookup(dst, src, (uint8_t *) &ip6_hdr->src);
         }
+    }
 #else
-        /* Supress compiler warnings if TCP is build without IP-Layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
+    /* Supress compiler warnings if TCP is build without IP-Layer */
+    (void) syn;
+    (void) src;
+    (void) dst;
 #endif
-        tcb = tcb->next;
-    }
     mutex_unlock(&_list_tcb_lock);
 
     /* Call FSM with event RCVD_PKT if a fitting connection was found */
@@ -196,15 +183,42 @@ static int _receive(gnrc_pktsnip_t *pkt)
     else {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Can't find fitting connection\n");
         if ((ctl & MSK_RST) != MSK_RST) {
-            _pkt_build_reset_from_pkt(&reset, pkt);
-            gnrc_netapi_send(gnrc_tcp_pid, reset);
+            if (_pkt_build_reset_from_pkt(&reset, pkt) == 0) {
+                _pkt_dispatch(reset);
+            }
         }
+        gnrc_pktbuf_release(pkt);
         return -ENOTCONN;
     }
     gnrc_pktbuf_release(pkt);
     return 0;
 }
 
+#ifdef MODULE_GNRC_TCP_DIRECT
+/**
+ * @brief netreg callback, processes received packets in the context of the network layer
+ *
+ * @param[in] cmd   netapi command
+ * @param[in] pkt   received paket
+ * @param[in] ctx   unused
+ */
+static void _direct_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void) ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        _receive(pkt);
+    }
+    else {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/**
+ * @brief netreg callback data of TCP
+ */
+static gnrc_netreg_entry_cbd_t _direct_cbd = { .cb = _direct_cb, .ctx = NULL };
+#endif
+
 void *_event_loop(__attribute__((unused)) void *arg)
 {
     msg_t msg;
@@ -223,7 +237,12 @@ void *_event_loop(__attribute__((unused)) void *arg)
 
     /* Register GNRC_tcp in netreg */
     gnrc_netreg_entry_t entry;
+#ifdef MODULE_GNRC_TCP_DIRECT
+    /* Received packets don't pass this thread, only timeouts do */
+    gnrc_netreg_entry_init_cb(&entry, GNRC_NETREG_DEMUX_CTX_ALL, &_direct_cbd);
+#else
     gnrc_netreg_entry_init_pid(&entry, GNRC_NETREG_DEMUX_CTX_ALL, gnrc_tcp_pid);
+#endif
     gnrc_netreg_register(GNRC_NETTYPE_TCP, &entry);
 
     /* dispatch NETAPI Messages */
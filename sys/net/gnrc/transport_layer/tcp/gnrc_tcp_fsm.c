@@ -23,6 +23,7 @@
 #include "internal/pkt.h"
 #include "internal/option.h"
 #include "internal/rcvbuf.h"
+#include "internal/demux.h"
 #include "internal/fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -79,11 +80,31 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->retransmit_cnt > 0) {
+        for (uint8_t i = 0; i < tcb->retransmit_cnt; ++i) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->retransmit_cnt = 0;
     }
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_RTT_PENDING;
+    return 0;
+}
+
+/**
+ * @brief retransmits the oldest unacknowledged segment before its retransmission timer expired
+ *
+ * @param[in/out] tcb   tcb containing the retransmit queue.
+ *
+ * @return zero on success
+ */
+static int _fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fast_retransmit()\n");
+    /* Every send attempt consumes a user, the retransmission timer keeps running */
+    gnrc_pktbuf_hold(tcb->pkt_retransmit[0], 1);
+    _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     return 0;
 }
 
@@ -132,6 +153,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state, bool *notify_o
             if (found) {
                 LL_DELETE(_list_tcb_head, iter);
             }
+            _demux_remove(tcb);
             mutex_unlock(&_list_tcb_lock);
 
             /* Free potencially allocated Receive Buffer */
@@ -140,6 +162,11 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state, bool *notify_o
             break;
 
         case FSM_STATE_LISTEN:
+            /* The peer is forgotten: Remove from demultiplexing */
+            mutex_lock(&_list_tcb_lock);
+            _demux_remove(tcb);
+            mutex_unlock(&_list_tcb_lock);
+
             /* Clear Adress Info */
             switch (tcb->address_family) {
 #ifdef MODULE_GNRC_IPV6
@@ -205,6 +232,14 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state, bool *notify_o
                 }
                 LL_APPEND(_list_tcb_head, tcb);
             }
+            _demux_add(tcb);
+            mutex_unlock(&_list_tcb_lock);
+            break;
+
+        case FSM_STATE_SYN_RCVD:
+            /* The peer is known now: Add to demultiplexing */
+            mutex_lock(&_list_tcb_lock);
+            _demux_add(tcb);
             mutex_unlock(&_list_tcb_lock);
             break;
 
@@ -277,6 +312,8 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb, bool *notify_owner)
 /**
  * @brief FSM Handling Function for sending data.
  *
+ * Sends as many segments as the send window and the retransmit queue allow.
+ *
  * @param[in/out] tcb   Specifies tcb to use fsm on.
  * @param[in/out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send.
@@ -287,24 +324,35 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     gnrc_pktsnip_t *out_pkt = NULL;     /* Outgoing packet */
     uint16_t seq_con = 0;               /* Sequence number consumption (out_pkt) */
+    size_t sent = 0;                    /* Number of bytes sent */
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    while (sent < len && tcb->retransmit_cnt < GNRC_TCP_SND_SEGMENTS) {
+        /* We are allowed to send further bytes if window is open */
+        int32_t usable = (int32_t) ((tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt);
+        if (usable <= 0) {
+            break;
+        }
 
-    /* We are allowed to send further bytes if window is open */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t payload = usable;
         payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+        if (payload == 0) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        /* Build segment, stop if the packet buffer is full */
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -432,6 +480,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt, bool *noti
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* The window in SYNs is never scaled */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
+
     /* Extract IPv6-Header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -460,25 +513,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt, bool *noti
             uint16_t dst = byteorder_ntohs(tcp_hdr->dst_port);
 
             /* Check if SYN Request is handled by another connection */
-            lst = _list_tcb_head;
-            while (lst) {
-                /* Compare Portnumbers and Network Layer Adresses */
-                /* Note: Packets without ip-header were discarded earlier */
-                if (lst->local_port == dst && lst->peer_port == src) {
+            /* Note: Packets without ip-header were discarded earlier */
 #ifdef MODULE_GNRC_IPV6
-                    if (snp->type == GNRC_NETTYPE_IPV6 && lst->address_family == AF_INET6) {
-                        ipv6_addr_t *dst_addr = &((ipv6_hdr_t *)ip)->dst;
-                        ipv6_addr_t *src_addr = &((ipv6_hdr_t *)ip)->src;
-
-                        if (ipv6_addr_equal((ipv6_addr_t *)lst->local_addr, dst_addr) &&
-                            ipv6_addr_equal((ipv6_addr_t *)lst->peer_addr, src_addr)) {
-                            break;
-                        }
-                    }
-#endif
-                }
-                lst = lst->next;
+            mutex_lock(&_list_tcb_lock);
+            lst = _demux_lookup(dst, src, (uint8_t *) &((ipv6_hdr_t *)ip)->src);
+            if (lst != NULL && !ipv6_addr_equal((ipv6_addr_t *)lst->local_addr,
+                                                &((ipv6_hdr_t *)ip)->dst)) {
+                lst = NULL;
             }
+            mutex_unlock(&_list_tcb_lock);
+#endif
             /* Return if connection is already handled (port and addresses match) */
             if (lst != NULL) {
                 DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Connection already handled\n");
@@ -633,7 +677,19 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt, bool *noti
                 /* Sent data has been acknowledged */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
+                    tcb->dup_acks = 0;
                     _pkt_acknowledge(tcb, seg_ack);
+
+                    /* Signal User, the retransmit queue has room for further segments */
+                    *notify_owner = true;
+                }
+                /* Duplicate ACK: Retransmit oldest segment after enough of them (RFC 5681) */
+                else if (seg_ack == tcb->snd_una && tcb->retransmit_cnt > 0 && pay_len == 0 &&
+                         !(ctl & MSK_FIN) && seg_wnd == tcb->snd_wnd) {
+                    tcb->dup_acks += 1;
+                    if (tcb->dup_acks == GNRC_TCP_DUP_ACK_THRESHOLD) {
+                        _fast_retransmit(tcb);
+                    }
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -657,25 +713,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt, bool *noti
                 /* Additional processing */
                 /* Check additionaly if previous our sent FIN has been acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2, notify_owner);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_cnt == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Translate to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT, notify_owner);
                     }
                 }
                 /* If our FIN has been acknowledged: last ACK received, close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->retransmit_cnt == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED, notify_owner);
                         return 0;
                     }
@@ -728,7 +784,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt, bool *noti
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT, notify_owner);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->retransmit_cnt == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT, notify_owner);
                 }
                 else {
@@ -771,9 +827,9 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb, bool *notify_owner)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->retransmit_cnt > 0) {
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -894,18 +950,31 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
     msg_t msg;
     int32_t result;
     bool notify_owner;
+    gnrc_pktsnip_t *out[GNRC_TCP_OUT_SEGMENTS];
+    uint8_t out_cnt;
 
     /* Lock FSM */
     mutex_lock(&(tcb->fsm_lock));
     notify_owner = false;
     result = _fsm_unprotected(tcb, event, in_pkt, buf, len, &notify_owner);
 
-    /* Notify owner if something interesting happend */
+    /* Notify owner if something interesting happend. Don't block if the owner has
+     * notifications pending anyway, the caller may be the network layer */
     if (notify_owner && tcb->owner != KERNEL_PID_UNDEF) {
         msg.type = MSG_TYPE_NOTIFY_USER;
-        msg_send(&msg, tcb->owner);
+        msg_try_send(&msg, tcb->owner);
     }
+    /* Take the packets sent by the FSM */
+    out_cnt = tcb->out_cnt;
+    memcpy(out, tcb->pkt_out, out_cnt * sizeof(gnrc_pktsnip_t *));
+    tcb->out_cnt = 0;
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
+
+    /* Pass the packets down only now: sending may block until the network layer takes them,
+     * and the network layer may be waiting for this FSM with a received segment */
+    for (uint8_t i = 0; i < out_cnt; ++i) {
+        _pkt_dispatch(out[i]);
+    }
     return result;
 }
@@ -24,8 +24,17 @@
 
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    uint16_t off_ctl = byteorder_ntohs(hdr->off_ctl);
+
+    /* Window scaling is only used if both SYNs carry the option, forget previous results */
+    if (off_ctl & MSK_SYN) {
+        tcb->status &= ~STATUS_WND_SCALE;
+        tcb->snd_wnd_scale = 0;
+        tcb->rcv_wnd_scale = 0;
+    }
+
     /* Extract Offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(off_ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -60,6 +69,22 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (option->length != TCP_OPTION_LENGTH_WS) {
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                /* The option is ignored in segments without SYN */
+                if (off_ctl & MSK_SYN) {
+                    tcb->status |= STATUS_WND_SCALE;
+                    tcb->snd_wnd_scale = (option->value[0] < TCP_WS_SHIFT_MAX) ?
+                                         option->value[0] : TCP_WS_SHIFT_MAX;
+                    tcb->rcv_wnd_scale = GNRC_TCP_WND_SCALE;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. WS=%"PRIu8"\n",
+                      option->value[0]);
+                break;
+
             default:
                 DEBUG("gnrc_tcp_option.c : _option_parse() : Unknown option found.\
                       KIND=%"PRIu8", LENGTH=%"PRIu8"\n", option->kind, option->length);
@@ -46,6 +46,56 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Checks if the Window Scale Option is added to a segment
+ *
+ * @param [in] tcb   This connections transmission control block
+ * @param [in] ctl   Control bits of the segment
+ *
+ * @return   true if the option must be added, false otherwise
+ */
+static inline bool _add_ws_option(const gnrc_tcp_tcb_t *tcb, const uint16_t ctl)
+{
+    return (ctl & MSK_SYN) && (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE));
+}
+
+/**
+ * @brief Calculates the current RTO and checks its bounds
+ *
+ * @param [in,out] tcb   This connections transmission control block
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there is no measurement yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief (Re-)starts the retransmission timer of the oldest unacknowledged segment
+ *
+ * @param [in,out] tcb   This connections transmission control block
+ */
+static void _start_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform Boundrychecks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to tcb */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
 {
     tcp_hdr_t tcp_hdr_out;
@@ -140,14 +190,25 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
+    /* The window in SYNs is never scaled (see RFC 7323) */
+    if (ctl & MSK_SYN) {
+        tcp_hdr.window = byteorder_htons((tcb->rcv_wnd < UINT16_MAX) ? tcb->rcv_wnd : UINT16_MAX);
+    }
+    else {
+        tcp_hdr.window = byteorder_htons(tcb->rcv_wnd >> tcb->rcv_wnd_scale);
+    }
+
     /* Calculate option field size. */
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
     }
+    /* Add WS option to SYNs, but to a SYN+ACK only if the peer offered it */
+    if (_add_ws_option(tcb, ctl)) {
+        offset += 1;
+    }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -172,8 +233,14 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            /* Add WS option if it was accounted for above */
+            if (_add_ws_option(tcb, ctl)) {
+                network_uint32_t ws_option = byteorder_htonl(_option_build_ws(GNRC_TCP_WND_SCALE));
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
             }
-            /* Increase opt_ptr and decrease opt_ptr, if other options are added */
             /* NOTE: Add Additional Options here */
         }
         *(out_pkt) = tcp_snp;
@@ -217,21 +284,49 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number and measure time, if no other
+     * segment is timed already */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
+    /* Segments in flight during a retransmission are not timed (Karns Algorithm) */
     else {
         tcb->retries += 1;
+        tcb->status &= ~STATUS_RTT_PENDING;
     }
 
-    /* Pass packet down the network stack */
-    gnrc_netapi_send(gnrc_tcp_pid, out_pkt);
+    /* Pass packet down the network stack once the FSM is unlocked */
+    if (tcb->out_cnt >= GNRC_TCP_OUT_SEGMENTS) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_send() : Too many packets to send\n");
+        gnrc_pktbuf_release(out_pkt);
+        return -ENOMEM;
+    }
+    tcb->pkt_out[tcb->out_cnt++] = out_pkt;
     return 0;
 }
 
+void _pkt_dispatch(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_TCP_DIRECT
+    /* Pass packet to the network layer in the callers context */
+    if (!gnrc_netapi_dispatch_send(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_dispatch() : network layer not found\n");
+        gnrc_pktbuf_release(pkt);
+    }
+#else
+    /* Pass packet to the network layer via TCPs thread */
+    if (gnrc_netapi_send(gnrc_tcp_pid, pkt) < 1) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_dispatch() : TCP thread is busy\n");
+        gnrc_pktbuf_release(pkt);
+    }
+#endif
+}
+
 int _pkt_chk_seq_num(const gnrc_tcp_tcb_t *tcb, const uint32_t seq_num, const uint32_t seg_len)
 {
     uint32_t l_edge = tcb->rcv_nxt;
@@ -308,9 +403,15 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
+    /* Only the oldest packet in the retransmit queue is retransmitted */
+    if (retransmit && (tcb->retransmit_cnt == 0 || tcb->pkt_retransmit[0] != pkt)) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not the oldest in queue\n");
+        return -EINVAL;
+    }
+
+    /* Check if retransmit queue is full */
+    if (!retransmit && tcb->retransmit_cnt >= GNRC_TCP_SND_SEGMENTS) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
         return -ENOMEM;
     }
 
@@ -324,19 +425,17 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
     /* RTO Adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* Append pkt. The timer is already running, if older packets are unacknowledged */
+        tcb->pkt_retransmit[tcb->retransmit_cnt++] = pkt;
+        if (tcb->retransmit_cnt > 1) {
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -349,51 +448,53 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
-
-    /* Perform Boundrychecks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to tcb */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    _start_retransmit_timer(tcb);
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     uint32_t seg = 0;
+    uint8_t acked = 0;
     gnrc_pktsnip_t *snp = NULL;
     tcp_hdr_t *hdr;
 
     /* Retransmission Queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->retransmit_cnt == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
+    /* Release all packets that were acknowledged completely, they are ordered by seq. number */
+    while (acked < tcb->retransmit_cnt) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[acked];
 
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+        hdr = (tcp_hdr_t *) snp->data;
+        seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(pkt) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->retransmit_cnt -= acked;
+    memmove(tcb->pkt_retransmit, tcb->pkt_retransmit + acked,
+            tcb->retransmit_cnt * sizeof(tcb->pkt_retransmit[0]));
+    tcb->retries = 0;
+    xtimer_remove(&(tcb->tim_tout));
 
-        /* Measure Round Trip Time */
+    /* Measure Round Trip Time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use sample only if ther was no timeroverflow and no retransmission (Karns Alogrithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_PENDING;
+
+        /* Use sample only if ther was no timeroverflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -408,6 +509,12 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Restart the timer for the remaining packets (see RFC 6298, 5.3) */
+    if (tcb->retransmit_cnt > 0) {
+        _calc_rto(tcb);
+        _start_retransmit_timer(tcb);
+    }
     return 0;
 }
 
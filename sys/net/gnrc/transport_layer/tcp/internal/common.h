@@ -46,6 +46,8 @@ extern "C" {
  */
 #define STATUS_PASSIVE        (1 << 0)
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
+#define STATUS_WND_SCALE      (1 << 2)
+#define STATUS_RTT_PENDING    (1 << 3)
 /** @} */
 
 /**
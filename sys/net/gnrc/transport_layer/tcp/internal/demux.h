@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       RIOT's tcp implementation for the gnrc stack
+ *
+ * @{
+ *
+ * @file
+ * @brief       Demultiplexing of received segments to connections
+ *
+ * Connections with a known peer are kept in a hash table with
+ * GNRC_TCP_DEMUX_BUCKETS buckets, keyed by local port, peer port and peer address.
+ * Listening connections are only in the list of active connections.
+ *
+ * All functions must be called with _list_tcb_lock locked.
+ */
+
+#ifndef GNRC_TCP_INTERNAL_DEMUX_H
+#define GNRC_TCP_INTERNAL_DEMUX_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Adds a connection to the hash table, if it was not added before
+ *
+ * @param[in] tcb   Transmission control block with local port, peer port and peer address set.
+ */
+void _demux_add(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Removes a connection from the hash table, if it was added before
+ *
+ * @note Must be called before the local port, peer port or peer address of @p tcb change.
+ *
+ * @param[in] tcb   Transmission control block to remove.
+ */
+void _demux_remove(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Looks up the connection a segment belongs to
+ *
+ * @param[in] local_port   Destination port of the segment.
+ * @param[in] peer_port    Source port of the segment.
+ * @param[in] peer_addr    Source address of the segment.
+ *
+ * @return   The matching transmission control block.
+ * @return   NULL if there is no connection to the segments sender.
+ */
+gnrc_tcp_tcb_t *_demux_lookup(uint16_t local_port, uint16_t peer_port,
+                              const uint8_t *peer_addr);
+
+/**
+ * @brief Looks up a listening connection for a SYN
+ *
+ * @param[in] local_port   Destination port of the SYN.
+ * @param[in] local_addr   Destination address of the SYN.
+ *
+ * @return   A transmission control block in state LISTEN, bound to @p local_addr or
+ *           to any address.
+ * @return   NULL if no connection listens on @p local_port.
+ */
+gnrc_tcp_tcb_t *_demux_lookup_listener(uint16_t local_port, const uint8_t *local_addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_INTERNAL_DEMUX_H */
+/** @} */
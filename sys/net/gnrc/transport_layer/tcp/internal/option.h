@@ -44,6 +44,19 @@ inline static uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper Function to build the Window Scale Option, preceded by a NOP for alignment
+ *
+ * @param[in]  shift   shift count to announce
+ *
+ * @return   Valid Window Scale Option.
+ */
+inline static uint32_t _option_build_ws(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) | ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
 /**
  * @brief Helper Function to build the combined option and control flag field
  *
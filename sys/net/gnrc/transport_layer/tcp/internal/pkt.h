@@ -66,6 +66,9 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
 /**
  * @brief Sends a packet to the peer
  *
+ * Must be called with the FSM locked. The packet is queued in @p tcb and passed down the
+ * network stack by _fsm() after unlocking the FSM.
+ *
  * @param[in,out] tcb          This connections Transmission control block.
  * @param[in]     out_pkt      pointer to paket to send
  * @param[in]     seq_con      sequence number consumption of the paket to send
@@ -73,10 +76,20 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
  *
  * @return   Zero on success.
  * @return   -EINVAL if out_pkt was NULL
+ * @return   -ENOMEM if GNRC_TCP_OUT_SEGMENTS packets are queued already
  */
 int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_con,
               const bool retransmit);
 
+/**
+ * @brief Passes a packet down to the network layer
+ *
+ * With the gnrc_tcp_direct module in the context of the caller, via TCPs thread otherwise.
+ *
+ * @param[in] pkt   paket to pass down, must start with the network layer header
+ */
+void _pkt_dispatch(gnrc_pktsnip_t *pkt);
+
 /**
  * @brief Checks sequence number
  *
@@ -110,18 +123,22 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a paket to the retransmission mechanism
  *
+ * Up to GNRC_TCP_SND_SEGMENTS pakets are queued in the order they were sent. The
+ * retransmission timer always belongs to the oldest one of them.
+ *
  * @param[in,out] tcb      This connections Transmission control block.
  * @param[in] pkt          paket to add to the retransmission mechanism
  * @param[in] retransmit   Flag used to indicate that pkt is a retransmit.
+ *                         Only the oldest paket in the queue can be retransmitted.
  *
  * @return   Zero on success
  * @return   -ENOMEM if the retransmission queue is full
- * @return   -EINVAL if pkt is null
+ * @return   -EINVAL if pkt is null or a retransmitted pkt is not the oldest paket in the queue
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism
+ * @brief Acknowledges and removes packets from the retransmission mechanism
  *
  * @param[in,out] tcb   This connections Transmission control block.
  * @param[in] ack       Acknowldegment number used to acknowledge packets
@@ -145,7 +145,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM_VALID) &&
+        (_calc_csum(udp, ipv6, pkt) != 0xFFFF)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -277,6 +278,29 @@ int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     return 0;
 }
 
+int gnrc_udp_update_csum(gnrc_pktsnip_t *hdr, const uint8_t *old_buf,
+                         const uint8_t *new_buf, size_t len)
+{
+    udp_hdr_t *udp_hdr;
+    uint16_t csum;
+
+    if (hdr == NULL) {
+        return -EFAULT;
+    }
+    if (hdr->type != GNRC_NETTYPE_UDP) {
+        return -EBADMSG;
+    }
+    udp_hdr = hdr->data;
+    csum = byteorder_ntohs(udp_hdr->checksum);
+    if (csum == 0) {
+        return -ENOENT;
+    }
+    csum = inet_csum_update(csum, old_buf, new_buf, (uint16_t)len);
+    /* see _calc_csum(): zero is transmitted as 0xFFFF */
+    udp_hdr->checksum = byteorder_htons((csum == 0) ? 0xFFFF : csum);
+    return 0;
+}
+
 gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
                                    uint16_t dst)
 {
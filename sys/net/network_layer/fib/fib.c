@@ -36,6 +36,9 @@
 
 #include "net/fib.h"
 #include "net/fib/table.h"
+#ifdef MODULE_FIB_RADIX
+#include "fib_radix.h"
+#endif
 
 #ifdef MODULE_IPV6_ADDR
 #include "net/ipv6/addr.h"
@@ -65,6 +68,53 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_RADIX
+/**
+ * @brief lowers the time-point of the next expiry sweep if required
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the entry with the (updated) lifetime
+ */
+static void fib_schedule_expiry(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->lifetime < table->next_expiry) {
+        table->next_expiry = entry->lifetime;
+    }
+}
+
+/**
+ * @brief removes all entries with an expired lifetime, but only if the
+ *        earliest lifetime in the table has been reached
+ *
+ * @param[in] table     the FIB table to sweep
+ */
+static void fib_expire_entries(fib_table_t *table)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    if (now < table->next_expiry) {
+        return;
+    }
+
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) || (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime < now) {
+            fib_remove(table, entry);
+        }
+        else {
+            fib_schedule_expiry(table, entry);
+        }
+    }
+}
+#endif
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,6 +131,13 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
+#ifdef MODULE_FIB_RADIX
+    fib_expire_entries(table);
+
+    int ret = fib_radix_find(table, dst, dst_size, entry_arr);
+    *entry_arr_size = (ret < 0) ? 0 : 1;
+    return ret;
+#else
     uint64_t now = xtimer_now_usec64();
 
     size_t count = 0;
@@ -106,13 +163,16 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     for (size_t i = 0; i < table->size; ++i) {
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
+        /* autoinvalidate if the entry is used and its lifetime is not set to
+         * not expire; unused entries have a lifetime of 0 */
+        if ((table->data.entries[i].lifetime != 0) &&
+            (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE)) {
 
             /* check if the lifetime expired */
             if (table->data.entries[i].lifetime < now) {
                 /* remove this entry if its lifetime expired */
                 table->data.entries[i].lifetime = 0;
+                table->version++;
                 table->data.entries[i].global_flags = 0;
                 table->data.entries[i].next_hop_flags = 0;
                 table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
@@ -187,11 +247,13 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     *entry_arr_size = count;
     return ret;
+#endif
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -199,18 +261,24 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @param[in] lifetime       the lifetime in ms
  *
  * @return 0 if the entry has been updated
+ *         1 if the next hop did not change
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
     universal_address_container_t *container = universal_address_add(next_hop, next_hop_size);
+    int ret = 1;
 
     if (container == NULL) {
         return -ENOMEM;
     }
 
+    if (container != entry->next_hop) {
+        table->version++;
+        ret = 0;
+    }
     universal_address_rem(entry->next_hop);
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
@@ -221,8 +289,11 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
+#ifdef MODULE_FIB_RADIX
+    fib_schedule_expiry(table, entry);
+#endif
 
-    return 0;
+    return ret;
 }
 
 /**
@@ -260,6 +331,7 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
             if (table->data.entries[i].next_hop != NULL) {
                 /* everything worked fine */
                 table->data.entries[i].iface_id = iface_id;
+                table->version++;
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
@@ -267,6 +339,10 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+#ifdef MODULE_FIB_RADIX
+                fib_radix_insert(table, &table->data.entries[i]);
+                fib_schedule_expiry(table, &table->data.entries[i]);
+#endif
 
                 return 0;
             }
@@ -279,12 +355,18 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_RADIX
+    fib_radix_remove(table, entry);
+#endif
+    table->version++;
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -403,7 +485,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -433,7 +515,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -457,7 +539,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +559,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -587,6 +669,7 @@ void fib_init(fib_table_t *table)
     }
 
     table->notify_rp_pos = 0;
+    table->version++;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
         memset(table->data.source_routes->headers, 0,
@@ -596,6 +679,10 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_RADIX
+        fib_radix_init(table);
+        table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+#endif
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -621,6 +708,10 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_RADIX
+        fib_radix_init(table);
+        table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+#endif
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
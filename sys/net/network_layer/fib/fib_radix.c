@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_fib
+ * @{
+ *
+ * @file
+ * @brief       Radix trie index for the single hop entries of a FIB table
+ *
+ * @}
+ */
+
+#ifdef MODULE_FIB_RADIX
+
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include "assert.h"
+#include "net/fib.h"
+#include "fib_radix.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief returns the bit at position @p pos (MSB first) of @p key
+ */
+static inline unsigned _bit(const uint8_t *key, uint16_t pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief returns the position of the first distinct bit of @p a and @p b
+ *        within the first @p len bits, or @p len if they are equal
+ */
+static uint16_t _first_diff(const uint8_t *a, const uint8_t *b, uint16_t len)
+{
+    uint16_t pos = 0;
+
+    for (; (pos + 8) <= len; pos += 8) {
+        if (a[pos >> 3] != b[pos >> 3]) {
+            break;
+        }
+    }
+    for (; pos < len; pos++) {
+        if (_bit(a, pos) != _bit(b, pos)) {
+            break;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief returns the key of an arbitrary node. Glue nodes always have two
+ *        children, so descending the first child always ends at an entry.
+ */
+static uint8_t *_node_key(fib_radix_node_t *node)
+{
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+    return node->entry->global->address;
+}
+
+/**
+ * @brief determines the prefix length used to index @p entry
+ */
+static uint16_t _entry_len(fib_entry_t *entry)
+{
+    uint16_t bits = entry->global->address_size << 3;
+    size_t prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                    >> FIB_FLAG_NET_PREFIX_SHIFT;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < entry->global->address_size; ++i) {
+        if (entry->global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+
+    /* all `0` addresses are default routes matching any destination */
+    if (is_all_zeros_addr) {
+        return 0;
+    }
+    if ((prefix == 0) || (prefix > bits)) {
+        return bits;
+    }
+    return (uint16_t)prefix;
+}
+
+static fib_radix_node_t *_glue_alloc(fib_table_t *table)
+{
+    fib_radix_node_t *glue = table->radix_free;
+
+    /* there are always less glue nodes than entries in the trie */
+    assert(glue != NULL);
+    table->radix_free = glue->child[0];
+    memset(glue, 0, sizeof(fib_radix_node_t));
+    return glue;
+}
+
+static void _glue_free(fib_table_t *table, fib_radix_node_t *glue)
+{
+    glue->entry = NULL;
+    glue->child[0] = table->radix_free;
+    table->radix_free = glue;
+}
+
+/**
+ * @brief puts @p node at the position of @p old in the parent of @p old
+ */
+static void _replace(fib_table_t *table, fib_radix_node_t *old,
+                     fib_radix_node_t *node)
+{
+    node->parent = old->parent;
+    if (old->parent == NULL) {
+        table->radix_root = node;
+    }
+    else {
+        old->parent->child[old->parent->child[1] == old] = node;
+    }
+}
+
+/**
+ * @brief sets @p child as child of @p node for the branching bit @p dir
+ */
+static inline void _link(fib_radix_node_t *node, unsigned dir,
+                         fib_radix_node_t *child)
+{
+    node->child[dir] = child;
+    if (child != NULL) {
+        child->parent = node;
+    }
+}
+
+/**
+ * @brief moves the children of @p old to @p node
+ */
+static void _adopt(fib_radix_node_t *old, fib_radix_node_t *node)
+{
+    _link(node, 0, old->child[0]);
+    _link(node, 1, old->child[1]);
+}
+
+/**
+ * @brief checks if @p node is linked into the trie itself, i.e. it is not
+ *        only chained as duplicate to another entry node
+ */
+static inline bool _is_head(fib_table_t *table, fib_radix_node_t *node)
+{
+    return (node == table->radix_root) ||
+           ((node->parent != NULL) && ((node->parent->child[0] == node) ||
+                                       (node->parent->child[1] == node)));
+}
+
+void fib_radix_init(fib_table_t *table)
+{
+    table->radix_root = NULL;
+    table->radix_free = NULL;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        memset(table->data.entries[i].radix, 0,
+               sizeof(table->data.entries[i].radix));
+        _glue_free(table, &table->data.entries[i].radix[1]);
+    }
+}
+
+void fib_radix_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_radix_node_t *node = &entry->radix[0];
+    uint8_t *key = entry->global->address;
+
+    memset(node, 0, sizeof(fib_radix_node_t));
+    node->entry = entry;
+    node->len = _entry_len(entry);
+
+    if (table->radix_root == NULL) {
+        table->radix_root = node;
+        return;
+    }
+
+    /* follow the bits of the key as far as possible */
+    fib_radix_node_t *cur = table->radix_root;
+    while (cur->len < node->len) {
+        fib_radix_node_t *next = cur->child[_bit(key, cur->len)];
+        if (next == NULL) {
+            break;
+        }
+        cur = next;
+    }
+
+    uint8_t *cur_key = _node_key(cur);
+    uint16_t diff = _first_diff(cur_key, key,
+                                (cur->len < node->len) ? cur->len : node->len);
+
+    /* the new node belongs above all nodes longer than the common prefix */
+    while ((cur->parent != NULL) && (cur->parent->len >= diff)) {
+        cur = cur->parent;
+    }
+
+    if (cur->len == diff) {
+        if (diff < node->len) {
+            /* cur is a prefix of the new node and has a free slot for it */
+            _link(cur, _bit(key, diff), node);
+        }
+        else if (cur->entry == NULL) {
+            /* the new entry takes over the place of a glue node */
+            _replace(table, cur, node);
+            _adopt(cur, node);
+            _glue_free(table, cur);
+        }
+        else {
+            /* same prefix as an existing entry */
+            node->parent = cur;
+            node->dup = cur->dup;
+            cur->dup = node;
+        }
+    }
+    else if (diff == node->len) {
+        /* the new node is a prefix of cur */
+        _replace(table, cur, node);
+        _link(node, _bit(cur_key, diff), cur);
+    }
+    else {
+        /* both diverge, so we need a branching node */
+        fib_radix_node_t *glue = _glue_alloc(table);
+        glue->len = diff;
+        _replace(table, cur, glue);
+        _link(glue, _bit(key, diff), node);
+        _link(glue, _bit(cur_key, diff), cur);
+    }
+}
+
+void fib_radix_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_radix_node_t *node = &entry->radix[0];
+
+    if (node->entry != entry) {
+        /* not indexed */
+        return;
+    }
+
+    if (!_is_head(table, node)) {
+        /* unchain a duplicate, its parent points to the head of the chain */
+        fib_radix_node_t *prev = node->parent;
+        while (prev->dup != node) {
+            prev = prev->dup;
+        }
+        prev->dup = node->dup;
+    }
+    else if (node->dup != NULL) {
+        /* the next duplicate becomes the head */
+        fib_radix_node_t *head = node->dup;
+        _replace(table, node, head);
+        _adopt(node, head);
+        for (fib_radix_node_t *dup = head->dup; dup != NULL; dup = dup->dup) {
+            dup->parent = head;
+        }
+    }
+    else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        /* still required for branching */
+        fib_radix_node_t *glue = _glue_alloc(table);
+        glue->len = node->len;
+        _replace(table, node, glue);
+        _adopt(node, glue);
+    }
+    else if ((node->child[0] != NULL) || (node->child[1] != NULL)) {
+        fib_radix_node_t *child = node->child[node->child[0] == NULL];
+        _replace(table, node, child);
+    }
+    else if (node->parent == NULL) {
+        table->radix_root = NULL;
+    }
+    else {
+        fib_radix_node_t *parent = node->parent;
+        parent->child[parent->child[1] == node] = NULL;
+
+        /* a glue node with a single child is obsolete */
+        if (parent->entry == NULL) {
+            fib_radix_node_t *child = parent->child[parent->child[0] == NULL];
+            _replace(table, parent, child);
+            _glue_free(table, parent);
+        }
+    }
+
+    memset(node, 0, sizeof(fib_radix_node_t));
+}
+
+int fib_radix_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                   fib_entry_t **entry)
+{
+    uint16_t dst_len = dst_size << 3;
+    fib_entry_t *best = NULL;
+    fib_radix_node_t *cur = table->radix_root;
+
+    while ((cur != NULL) && (cur->len <= dst_len)) {
+        if (cur->entry != NULL) {
+            /* all entries below share this prefix */
+            if (_first_diff(cur->entry->global->address, dst,
+                            cur->len) != cur->len) {
+                break;
+            }
+
+            for (fib_radix_node_t *n = cur; n != NULL; n = n->dup) {
+                universal_address_container_t *global = n->entry->global;
+
+                if (global->address_size != dst_size) {
+                    continue;
+                }
+                if (memcmp(global->address, dst, dst_size) == 0) {
+                    /* we will not find a better one so we return */
+                    *entry = n->entry;
+                    return 1;
+                }
+                best = n->entry;
+            }
+        }
+
+        if (cur->len == dst_len) {
+            break;
+        }
+        cur = cur->child[_bit(dst, cur->len)];
+    }
+
+    if (best == NULL) {
+        return -EHOSTUNREACH;
+    }
+
+    DEBUG("[fib_radix_find] found prefix on interface %d\n", best->iface_id);
+    *entry = best;
+    return 0;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_FIB_RADIX */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_fib
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief       Radix trie index for the single hop entries of a FIB table
+ *
+ * @details     The trie is a path compressed binary trie over the
+ *              destination prefixes. Lookups only follow the bits of the
+ *              searched destination, so they run in O(prefix length)
+ *              regardless of the number of entries in the table.
+ *
+ *              All functions expect the caller to hold
+ *              fib_table_t::mtx_access.
+ */
+
+#ifndef FIB_RADIX_H
+#define FIB_RADIX_H
+
+#include "net/fib/table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief resets the trie of @p table and puts all spare glue nodes of its
+ *        entries in the free list
+ *
+ * @param[in] table     the FIB table to initialize the trie for
+ */
+void fib_radix_init(fib_table_t *table);
+
+/**
+ * @brief adds a filled entry of @p table to the trie
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the entry to index, fib_entry_t::global MUST be set
+ */
+void fib_radix_insert(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief removes an entry from the trie
+ *
+ * @param[in] table     the FIB table the entry belongs to
+ * @param[in] entry     the indexed entry to remove
+ */
+void fib_radix_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief searches the longest prefix match for the given destination
+ *
+ * @param[in] table     the FIB table to search in
+ * @param[in] dst       the destination address
+ * @param[in] dst_size  the destination address size
+ * @param[out] entry    the found entry
+ *
+ * @return 0 if we found a next-hop prefix
+ *         1 if we found the exact address next-hop
+ *         -EHOSTUNREACH if no fitting next-hop is available
+ */
+int fib_radix_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                   fib_entry_t **entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIB_RADIX_H */
+/** @} */
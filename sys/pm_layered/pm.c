@@ -22,6 +22,11 @@
 #include "periph/pm.h"
 #include "pm_layered.h"
 
+#if defined(MODULE_XTIMER_SLACK) && defined(PM_MIN_IDLE_US)
+#include "xtimer.h"
+#define PM_CHECK_IDLE
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -46,6 +51,13 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#ifdef PM_CHECK_IDLE
+/**
+ * @brief Minimum time to the next xtimer wakeup per mode
+ */
+static const uint32_t pm_min_idle[PM_NUM_MODES] = PM_MIN_IDLE_US;
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = (pm_blocker_t) pm_blocker;
@@ -59,6 +71,13 @@ void pm_set_lowest(void)
 
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
+#ifdef PM_CHECK_IDLE
+    /* skip modes that would take longer to enter and leave than we idle */
+    uint32_t idle = xtimer_usec_from_ticks(xtimer_time_to_wakeup());
+    while ((mode < PM_NUM_MODES) && (idle < pm_min_idle[mode])) {
+        mode++;
+    }
+#endif
     if (blocker.val_u32 == pm_blocker.val_u32) {
         DEBUG("pm: setting mode %u\n", mode);
         pm_set(mode);
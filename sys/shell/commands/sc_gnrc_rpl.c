@@ -210,6 +210,9 @@ int _stats(void)
     printf("DAO-ACK   #bytes: %10" PRIu32 " / %-10" PRIu32 "  %10" PRIu32 " / %-10" PRIu32 "\n",
            gnrc_rpl_netstats.dao_ack_rx_ucast_bytes, gnrc_rpl_netstats.dao_ack_tx_ucast_bytes,
            gnrc_rpl_netstats.dao_ack_rx_mcast_bytes, gnrc_rpl_netstats.dao_ack_tx_mcast_bytes);
+    printf("DAO #targets sent: %" PRIu32 ", #triggers aggregated: %" PRIu32
+           ", #triggers suppressed: %" PRIu32 "\n", gnrc_rpl_netstats.dao_tx_targets,
+           gnrc_rpl_netstats.dao_aggregated, gnrc_rpl_netstats.dao_suppressed);
     return 0;
 }
 #endif
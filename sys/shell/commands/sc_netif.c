@@ -125,6 +125,11 @@ static int _netif_stats(kernel_pid_t dev, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+        if (stats->rx_batch_count > 0) {
+            printf("            RX batches %u (largest: %u)\n",
+                   (unsigned) stats->rx_batch_count,
+                   (unsigned) stats->rx_batch_max);
+        }
         res = 0;
     }
     return res;
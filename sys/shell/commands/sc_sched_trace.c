@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell commands for the scheduler tracing module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched.h"
+#include "sched_trace.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* list of states copied from tcb.h */
+static const char *_reasons[] = {
+    [STATUS_STOPPED] = "stopped",
+    [STATUS_SLEEPING] = "sleeping",
+    [STATUS_MUTEX_BLOCKED] = "bl mutex",
+    [STATUS_RECEIVE_BLOCKED] = "bl rx",
+    [STATUS_SEND_BLOCKED] = "bl send",
+    [STATUS_REPLY_BLOCKED] = "bl reply",
+    [STATUS_FLAG_BLOCKED_ANY] = "bl anyfl",
+    [STATUS_FLAG_BLOCKED_ALL] = "bl allfl",
+    [STATUS_MBOX_BLOCKED] = "bl mbox",
+    [STATUS_RUNNING] = "running",
+    [STATUS_PENDING] = "preempted",
+};
+
+static void _print_stats(void)
+{
+    printf("\tpid | max latency [us] | run length histogram, bucket i: < 4^(i+1) ticks\n");
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_trace_stat_t *stat = &sched_trace_stats[i];
+
+        if (sched_threads[i] == NULL) {
+            continue;
+        }
+        printf("\t%3" PRIkernel_pid " | %16lu |", i,
+               (unsigned long)xtimer_usec_from_ticks(
+                   xtimer_ticks(stat->max_latency)));
+        for (unsigned b = 0; b < SCHED_TRACE_HIST_BUCKETS; b++) {
+            printf(" %5u", (unsigned)stat->hist[b]);
+        }
+        puts("");
+    }
+}
+
+static void _print_log(void)
+{
+    sched_trace_entry_t entries[SCHED_TRACE_SIZE];
+    unsigned num = sched_trace_read(entries, SCHED_TRACE_SIZE);
+
+    printf("\t      time [us] | from |   to | reason\n");
+    for (unsigned i = 0; i < num; i++) {
+        const char *reason = (entries[i].reason < (sizeof(_reasons) / sizeof(_reasons[0]))) ?
+                             _reasons[entries[i].reason] : NULL;
+
+        printf("\t%15lu | %4" PRIkernel_pid " | %4" PRIkernel_pid " | %s\n",
+               (unsigned long)xtimer_usec_from_ticks(
+                   xtimer_ticks(entries[i].time)),
+               entries[i].from, entries[i].to, reason ? reason : "-");
+    }
+}
+
+int _sched_trace_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        _print_stats();
+    }
+    else if (strcmp(argv[1], "log") == 0) {
+        _print_log();
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        sched_trace_reset();
+    }
+    else {
+        printf("usage: %s [log|reset]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <stdbool.h>
 #ifdef MODULE_FIB
 #include "net/fib.h"
 #ifdef MODULE_GNRC_IPV6
@@ -26,6 +27,9 @@
 #endif
 #endif
 #include "mutex.h"
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+#include "hashes.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -61,6 +65,132 @@ static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_M
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+/**
+ * @brief Number of slots of the open addressing hash index
+ *        (MUST be greater than UNIVERSAL_ADDRESS_MAX_ENTRIES)
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_SIZE
+#define UNIVERSAL_ADDRESS_HASH_SIZE (2 * UNIVERSAL_ADDRESS_MAX_ENTRIES)
+#endif
+
+/**
+ * @brief The hash index over all containers holding an address,
+ *        storing the position in universal_address_table + 1 (0 marks an empty slot)
+ */
+static uint16_t universal_address_index[UNIVERSAL_ADDRESS_HASH_SIZE];
+
+/**
+ * @brief Stack of the positions of all unused containers
+ */
+static uint16_t universal_address_free[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief Position of each unused container in universal_address_free
+ */
+static uint16_t universal_address_free_pos[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief number of unused containers on universal_address_free
+ */
+static size_t universal_address_free_num = 0;
+
+/**
+ * @brief indicates if the index and free stack reflect universal_address_table
+ */
+static bool universal_address_index_valid = false;
+
+static inline size_t _index_slot(const uint8_t *addr, size_t addr_size)
+{
+    return one_at_a_time_hash(addr, addr_size) % UNIVERSAL_ADDRESS_HASH_SIZE;
+}
+
+static inline uint16_t _table_pos(universal_address_container_t *entry)
+{
+    return (uint16_t)(entry - universal_address_table);
+}
+
+static void _index_add(universal_address_container_t *entry)
+{
+    size_t slot = _index_slot(entry->address, entry->address_size);
+
+    while (universal_address_index[slot] != 0) {
+        slot = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SIZE;
+    }
+    universal_address_index[slot] = _table_pos(entry) + 1;
+}
+
+static void _index_rem(universal_address_container_t *entry)
+{
+    size_t slot = _index_slot(entry->address, entry->address_size);
+    uint16_t val = _table_pos(entry) + 1;
+
+    while (universal_address_index[slot] != val) {
+        if (universal_address_index[slot] == 0) {
+            /* not indexed */
+            return;
+        }
+        slot = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SIZE;
+    }
+
+    /* shift back following entries of the probe sequence, so no tombstones
+     * are required */
+    universal_address_index[slot] = 0;
+    for (size_t next = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SIZE;
+         universal_address_index[next] != 0;
+         next = (next + 1) % UNIVERSAL_ADDRESS_HASH_SIZE) {
+        universal_address_container_t *moved =
+            &universal_address_table[universal_address_index[next] - 1];
+        size_t home = _index_slot(moved->address, moved->address_size);
+        bool reachable = (slot < next) ? ((slot < home) && (home <= next))
+                                       : ((slot < home) || (home <= next));
+        if (!reachable) {
+            universal_address_index[slot] = universal_address_index[next];
+            universal_address_index[next] = 0;
+            slot = next;
+        }
+    }
+}
+
+static void _free_push(universal_address_container_t *entry)
+{
+    uint16_t pos = _table_pos(entry);
+
+    universal_address_free_pos[pos] = universal_address_free_num;
+    universal_address_free[universal_address_free_num++] = pos;
+}
+
+static void _free_rem(universal_address_container_t *entry)
+{
+    uint16_t pos = _table_pos(entry);
+    uint16_t last = universal_address_free[--universal_address_free_num];
+
+    /* move the last element of the stack to the freed position */
+    universal_address_free[universal_address_free_pos[pos]] = last;
+    universal_address_free_pos[last] = universal_address_free_pos[pos];
+}
+
+/**
+ * @brief (re-)builds the hash index and the stack of unused containers
+ */
+static void _index_build(void)
+{
+    memset(universal_address_index, 0, sizeof(universal_address_index));
+    universal_address_free_num = 0;
+
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
+        if (universal_address_table[i].address_size != 0) {
+            _index_add(&universal_address_table[i]);
+        }
+        if (universal_address_table[i].use_count == 0) {
+            _free_push(&universal_address_table[i]);
+        }
+    }
+
+    universal_address_index_valid = true;
+}
+#endif
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,6 +202,18 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    for (size_t slot = _index_slot(addr, addr_size);
+         universal_address_index[slot] != 0;
+         slot = (slot + 1) % UNIVERSAL_ADDRESS_HASH_SIZE) {
+        universal_address_container_t *entry =
+            &universal_address_table[universal_address_index[slot] - 1];
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
+        }
+    }
+#else
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
         if (universal_address_table[i].address_size == addr_size) {
             if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
@@ -79,6 +221,7 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
             }
         }
     }
+#endif
 
     return NULL;
 }
@@ -91,6 +234,11 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    if (universal_address_free_num > 0) {
+        return &universal_address_table[universal_address_free[universal_address_free_num - 1]];
+    }
+#else
     if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
         for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
             if (universal_address_table[i].use_count == 0) {
@@ -98,6 +246,7 @@ static universal_address_container_t *universal_address_get_next_unused_entry(vo
             }
         }
     }
+#endif
 
     return NULL;
 }
@@ -105,6 +254,11 @@ static universal_address_container_t *universal_address_get_next_unused_entry(vo
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
 {
     mutex_lock(&mtx_access);
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    if (!universal_address_index_valid) {
+        _index_build();
+    }
+#endif
     universal_address_container_t *pEntry = universal_address_find_entry(addr, addr_size);
 
     if (pEntry == NULL) {
@@ -117,6 +271,13 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        /* the unused container gets a new address */
+        if (pEntry->address_size != 0) {
+            _index_rem(pEntry);
+        }
+#endif
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -129,11 +290,17 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        _index_add(pEntry);
+#endif
     }
 
     pEntry->use_count++;
 
     if (pEntry->use_count == 1) {
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        _free_rem(pEntry);
+#endif
         DEBUG("[universal_address_add] universal_address_table_filled: %d\n", \
               (int)universal_address_table_filled);
         universal_address_table_filled++;
@@ -155,6 +322,9 @@ void universal_address_rem(universal_address_container_t *entry)
 
             if (entry->use_count == 0) {
                 universal_address_table_filled--;
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+                _free_push(entry);
+#endif
             }
         }
         else {
@@ -234,7 +404,7 @@ int universal_address_compare(universal_address_container_t *entry,
     }
 
     /* get the total number of matching bits */
-    *addr_size_in_bits = (idx << 3) + j;
+    *addr_size_in_bits = (idx << 3) + (7 - j);
     ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
 
     mutex_unlock(&mtx_access);
@@ -300,6 +470,9 @@ void universal_address_init(void)
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
 
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    _index_build();
+#endif
     mutex_unlock(&mtx_access);
 }
 
@@ -312,6 +485,9 @@ void universal_address_reset(void)
     }
 
     universal_address_table_filled = 0;
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+    _index_build();
+#endif
     mutex_unlock(&mtx_access);
 }
 
@@ -41,11 +41,18 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+#ifdef MODULE_XTIMER_SLACK
+/* time the low-level timer was last set to */
+static uint32_t _next_wakeup = 0;
+#endif
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
+static uint32_t _list_wakeup(void);
 static uint32_t _time_left(uint32_t target, uint32_t reference);
 
 static void _timer_callback(void);
@@ -107,6 +114,9 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
         _xtimer_set(timer, (uint32_t) offset);
     }
     else {
+#ifdef MODULE_XTIMER_SLACK
+        timer->slack = 0;
+#endif
         int state = irq_disable();
         if (_is_set(timer)) {
             _remove(timer);
@@ -126,7 +136,7 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
     }
 }
 
-void _xtimer_set(xtimer_t *timer, uint32_t offset)
+static void _set(xtimer_t *timer, uint32_t offset)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -143,10 +153,33 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target);
     }
 }
 
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = 0;
+#endif
+    _set(timer, offset);
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    timer->slack = slack;
+    _set(timer, offset);
+}
+
+xtimer_ticks32_t xtimer_time_to_wakeup(void)
+{
+    xtimer_ticks32_t ticks;
+    ticks.ticks32 = _xtimer_lltimer_mask(_next_wakeup - _xtimer_lltimer_now());
+    return ticks;
+}
+#endif
+
 static void _periph_timer_callback(void *arg, int chan)
 {
     (void)arg;
@@ -165,10 +198,13 @@ static inline void _lltimer_set(uint32_t target)
         return;
     }
     DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
+#ifdef MODULE_XTIMER_SLACK
+    _next_wakeup = _xtimer_lltimer_mask(target);
+#endif
     timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
 }
 
-int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+static int _set_absolute(xtimer_t *timer, uint32_t target)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
@@ -207,10 +243,15 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
             DEBUG("timer_set_absolute(): timer will expire in this timer period.\n");
             _add_timer_to_list(&timer_list_head, timer);
 
+#ifdef MODULE_XTIMER_SLACK
+            /* any timer can end the window of the current list head */
+            _lltimer_set(_list_wakeup());
+#else
             if (timer_list_head == timer) {
                 DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
                 _lltimer_set(target - XTIMER_OVERHEAD);
             }
+#endif
         }
     }
 
@@ -219,6 +260,14 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = 0;
+#endif
+    return _set_absolute(timer, target);
+}
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -261,7 +310,7 @@ static void _remove(xtimer_t *timer)
         timer_list_head = timer->next;
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = _list_wakeup();
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -286,6 +335,46 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+#ifdef MODULE_XTIMER_SLACK
+/**
+ * @brief get the latest time a timer may fire, within the current timer period
+ */
+static uint32_t _latest(xtimer_t *timer)
+{
+    uint32_t latest = timer->target + timer->slack;
+
+    if ((latest < timer->target) || ((latest ^ timer->target) & XTIMER_MASK)) {
+        latest = timer->target | _xtimer_lltimer_mask(0xFFFFFFFF);
+    }
+    return latest;
+}
+#endif
+
+/**
+ * @brief get the low-level timer target for the current timer list
+ *
+ * With slack, the wakeup is delayed to the end of the earliest window of all
+ * timers in the list, so all timers due by then expire in one interrupt.
+ */
+static uint32_t _list_wakeup(void)
+{
+#ifdef MODULE_XTIMER_SLACK
+    uint32_t wakeup = _latest(timer_list_head);
+
+    /* the list is sorted, no later timer can end the window any earlier */
+    for (xtimer_t *t = timer_list_head->next; t && (t->target < wakeup);
+         t = t->next) {
+        uint32_t latest = _latest(t);
+        if (latest < wakeup) {
+            wakeup = latest;
+        }
+    }
+    return wakeup - XTIMER_OVERHEAD;
+#else
+    return timer_list_head->target - XTIMER_OVERHEAD;
+#endif
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -495,7 +584,7 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = _list_wakeup();
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF)) {
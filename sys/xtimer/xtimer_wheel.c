@@ -0,0 +1,591 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality based on hierarchical timing wheels
+ *
+ * This is a drop-in replacement for xtimer_core.c. Timers are hashed by
+ * their 64 bit target time into XTIMER_WHEEL_LEVELS wheels of
+ * XTIMER_WHEEL_SLOTS slots each. A slot of the innermost wheel covers
+ * 2^XTIMER_WHEEL_SHIFT ticks, a slot of every further wheel covers a whole
+ * rotation of the wheel below. Setting and removing a timer only touches
+ * the one slot the timer hashes to.
+ *
+ * When the wheels advance to a non-empty slot, its timers are redistributed
+ * to the wheels below ("cascaded"), until they end up in the sorted list of
+ * timers that are due within the current innermost slot. Cascading is done
+ * one innermost rotation ahead of time, so the low-level timer only needs to
+ * wake us up for cascading if no timer expires before anyway.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define _SLOT_MASK  (XTIMER_WHEEL_SLOTS - 1)
+#define _NO_EVENT   (UINT64_MAX)
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/* last low-level timer value seen by the handler, to detect overflows */
+static uint32_t _ll_last = 0;
+
+/* time the low-level timer is currently set to */
+static uint64_t _lltimer_target = 0;
+
+/* number of the innermost slot the wheels have advanced to */
+static uint64_t _wheel_now = 0;
+
+/* timers due up to the end of slot _wheel_now, sorted */
+static xtimer_t *timer_list_head = NULL;
+/* timers beyond the range of the outermost wheel, unsorted */
+static xtimer_t *far_list_head = NULL;
+
+static xtimer_t *_slots[XTIMER_WHEEL_LEVELS][XTIMER_WHEEL_SLOTS];
+static uint16_t _occupied[XTIMER_WHEEL_LEVELS];
+
+static void _shoot(xtimer_t *timer);
+static void _remove(xtimer_t *timer);
+static void _insert(xtimer_t *timer);
+static inline void _lltimer_set(uint32_t target);
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _target64(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _lltimer_set(0xFFFFFFFF);
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        _xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _remove(timer);
+        }
+
+        _xtimer_now_internal(&timer->target, &timer->long_target);
+        timer->target += offset;
+        timer->long_target += long_offset;
+        if (timer->target < offset) {
+            timer->long_target++;
+        }
+
+        _insert(timer);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
+          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        _xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = _xtimer_now() + offset;
+        _xtimer_set_absolute(timer, target);
+    }
+}
+
+#ifdef MODULE_XTIMER_SLACK
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    /* the wheel has no notion of slack, the timer fires at its target */
+    timer->slack = slack;
+    _xtimer_set(timer, offset);
+}
+
+xtimer_ticks32_t xtimer_time_to_wakeup(void)
+{
+    xtimer_ticks32_t ticks;
+    ticks.ticks32 = _xtimer_lltimer_mask((uint32_t)_lltimer_target -
+                                         _xtimer_lltimer_now());
+    return ticks;
+}
+#endif
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    if (_in_handler) {
+        return;
+    }
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = _xtimer_now();
+    int res = 0;
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    timer->next = NULL;
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    timer->target = target;
+    timer->long_target = _long_cnt;
+    if (target < now) {
+        timer->long_target++;
+    }
+
+    _insert(timer);
+
+    irq_restore(state);
+
+    return res;
+}
+
+static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    uint64_t target = _target64(timer);
+
+    while (*list_head && _target64(*list_head) <= target) {
+        list_head = &((*list_head)->next);
+    }
+
+    timer->next = *list_head;
+    *list_head = timer;
+}
+
+static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    while (*list_head) {
+        if (*list_head == timer) {
+            *list_head = timer->next;
+            return 1;
+        }
+        list_head = &((*list_head)->next);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief puts @p timer into the innermost wheel that covers its target,
+ *        or into the list of due timers
+ */
+static void _place(xtimer_t *timer)
+{
+    uint64_t slot = _target64(timer) >> XTIMER_WHEEL_SHIFT;
+    uint64_t now = _wheel_now;
+
+    if (slot <= now) {
+        _add_timer_to_list(&timer_list_head, timer);
+        return;
+    }
+
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        /* the slot is always ahead of the current slot of this wheel,
+         * otherwise the timer would have fitted into the wheel below */
+        if ((slot - now) < XTIMER_WHEEL_SLOTS) {
+            unsigned idx = slot & _SLOT_MASK;
+            timer->next = _slots[level][idx];
+            _slots[level][idx] = timer;
+            _occupied[level] |= (1 << idx);
+            return;
+        }
+        slot >>= XTIMER_WHEEL_BITS;
+        now >>= XTIMER_WHEEL_BITS;
+    }
+
+    timer->next = far_list_head;
+    far_list_head = timer;
+}
+
+static void _place_list(xtimer_t *list)
+{
+    while (list) {
+        xtimer_t *next = list->next;
+        _place(list);
+        list = next;
+    }
+}
+
+/**
+ * @brief redistributes the timers of all slots the wheels just advanced to
+ */
+static void _cascade(void)
+{
+    unsigned level = 0;
+
+    /* a wheel advances when all wheels below completed a rotation */
+    while (((level + 1) < XTIMER_WHEEL_LEVELS) &&
+           !(_wheel_now & ((1ULL << (XTIMER_WHEEL_BITS * (level + 1))) - 1))) {
+        level++;
+    }
+
+    if ((level == (XTIMER_WHEEL_LEVELS - 1)) && far_list_head) {
+        xtimer_t *list = far_list_head;
+        far_list_head = NULL;
+        _place_list(list);
+    }
+
+    for (int i = level; i >= 0; i--) {
+        unsigned idx = (_wheel_now >> (XTIMER_WHEEL_BITS * i)) & _SLOT_MASK;
+        xtimer_t *list = _slots[i][idx];
+
+        _slots[i][idx] = NULL;
+        _occupied[i] &= ~(1 << idx);
+        _place_list(list);
+    }
+}
+
+/**
+ * @brief returns the number of the innermost slot at which the wheels have
+ *        to cascade next, or _NO_EVENT if all wheels are empty
+ */
+static uint64_t _next_event(void)
+{
+    uint64_t next = _NO_EVENT;
+    uint64_t now = _wheel_now;
+
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        uint64_t event = _NO_EVENT;
+
+        if (_occupied[level]) {
+            unsigned idx = now & _SLOT_MASK;
+            uint32_t mask = _occupied[level];
+
+            /* rotate, so bit 0 is the current slot. It is always empty. */
+            mask = ((mask | (mask << XTIMER_WHEEL_SLOTS)) >> idx) & 0xffff;
+            event = (now + bitarithm_lsb(mask)) << (XTIMER_WHEEL_BITS * level);
+        }
+        if ((level == (XTIMER_WHEEL_LEVELS - 1)) && far_list_head) {
+            /* far timers are revisited whenever the outermost wheel moves */
+            event = (now + 1) << (XTIMER_WHEEL_BITS * level);
+        }
+        if (event < next) {
+            next = event;
+        }
+        now >>= XTIMER_WHEEL_BITS;
+    }
+
+    return next;
+}
+
+/**
+ * @brief returns the time at which the wheels need to cascade for @p event
+ */
+static inline uint64_t _event_wakeup(uint64_t event)
+{
+    if (event <= XTIMER_WHEEL_SLOTS) {
+        return 0;
+    }
+    return (event - XTIMER_WHEEL_SLOTS) << XTIMER_WHEEL_SHIFT;
+}
+
+/**
+ * @brief returns the time at which @p timer needs the low-level timer
+ */
+static inline uint64_t _timer_wakeup(xtimer_t *timer)
+{
+    uint64_t target = _target64(timer);
+
+    return (target > XTIMER_OVERHEAD) ? (target - XTIMER_OVERHEAD) : 0;
+}
+
+/**
+ * @brief advances the wheels to @p now, cascading all slots that are due
+ *        within the next rotation of the innermost wheel
+ */
+static void _advance(uint64_t now)
+{
+    uint64_t event;
+
+    while (((event = _next_event()) != _NO_EVENT) &&
+           (_event_wakeup(event) < (now + XTIMER_BACKOFF))) {
+        _wheel_now = event;
+        _cascade();
+    }
+
+    /* no slot needs cascading until then, so skip the empty ones */
+    if (_wheel_now < (now >> XTIMER_WHEEL_SHIFT)) {
+        _wheel_now = now >> XTIMER_WHEEL_SHIFT;
+    }
+}
+
+static inline uint64_t _period_start(void)
+{
+#if XTIMER_MASK
+    return ((uint64_t)_long_cnt << 32) | _xtimer_high_cnt;
+#else
+    return ((uint64_t)_long_cnt << 32);
+#endif
+}
+
+static inline uint64_t _period_end(void)
+{
+    return _period_start() + _xtimer_lltimer_mask(0xFFFFFFFF);
+}
+
+/**
+ * @brief returns the time the low-level timer has to be set to
+ */
+static uint64_t _next_wakeup(void)
+{
+    uint64_t next = _period_end();
+    uint64_t event = _next_event();
+
+    if (timer_list_head && (_timer_wakeup(timer_list_head) < next)) {
+        next = _timer_wakeup(timer_list_head);
+    }
+    if ((event != _NO_EVENT) && (_event_wakeup(event) < next)) {
+        next = _event_wakeup(event);
+    }
+
+    return next;
+}
+
+/**
+ * @brief sets the low-level timer to the next wakeup, unless it already is
+ */
+static void _update_lltimer(void)
+{
+    uint64_t next = _next_wakeup();
+
+    if (_in_handler || (next == _lltimer_target)) {
+        return;
+    }
+    _lltimer_target = next;
+    _lltimer_set((uint32_t)next);
+}
+
+static void _insert(xtimer_t *timer)
+{
+    uint64_t now = _xtimer_now64();
+
+    /* catch up first, so the timer is placed relative to the current time */
+    _advance(now);
+    _place(timer);
+    /* the new timer might need cascading right away */
+    _advance(now);
+    _update_lltimer();
+}
+
+static void _remove(xtimer_t *timer)
+{
+    uint64_t slot = _target64(timer) >> XTIMER_WHEEL_SHIFT;
+
+    if (timer_list_head == timer) {
+        timer_list_head = timer->next;
+        _update_lltimer();
+        return;
+    }
+    if (_remove_timer_from_list(&timer_list_head, timer)) {
+        return;
+    }
+
+    /* the timer can only be in the slot its target hashes to */
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        unsigned idx = slot & _SLOT_MASK;
+
+        if (_remove_timer_from_list(&_slots[level][idx], timer)) {
+            if (!_slots[level][idx]) {
+                _occupied[level] &= ~(1 << idx);
+            }
+            return;
+        }
+        slot >>= XTIMER_WHEEL_BITS;
+    }
+
+    _remove_timer_from_list(&far_list_head, timer);
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief returns the current time, advancing to the next short timer period
+ *        if the low-level timer overflowed since the last call
+ */
+static uint64_t _handler_now(void)
+{
+    uint32_t now = _xtimer_lltimer_now();
+
+    if (now < _ll_last) {
+        _next_period();
+    }
+    _ll_last = now;
+
+    return _period_start() + now;
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    _in_handler = 1;
+
+    while (1) {
+        uint64_t now = _handler_now();
+
+        _advance(now);
+
+        xtimer_t *timer = timer_list_head;
+        if (timer && (_timer_wakeup(timer) < (now + XTIMER_ISR_BACKOFF))) {
+            /* make sure we don't fire too early */
+            while (_handler_now() < _target64(timer));
+
+            timer_list_head = timer->next;
+
+            /* make sure timer is recognized as being already fired */
+            timer->target = 0;
+            timer->long_target = 0;
+
+            /* fire timer */
+            _shoot(timer);
+            continue;
+        }
+
+        if (_period_end() < (now + XTIMER_ISR_BACKOFF)) {
+            /* spin until next period, then advance */
+            while (_xtimer_lltimer_now() >= _ll_last);
+            continue;
+        }
+
+        break;
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _lltimer_target = _NO_EVENT;
+    _update_lltimer();
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Publish rate of emCute with and without in-flight window
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/af.h"
+#include "net/emcute.h"
+#include "net/ipv6/addr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef PUBS
+#define PUBS            (200)
+#endif
+
+#ifndef TOPICS
+#define TOPICS          (16)
+#endif
+
+#ifndef GW_DELAY
+#define GW_DELAY        (10U * US_PER_MS)
+#endif
+
+#define EMCUTE_PORT     (1883U)
+#define GW_PORT         (1885U)
+#define GW_QUEUE_SIZE   (EMCUTE_ASYNC_WINDOW + 1)
+#define STACKSIZE       (THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF)
+
+/* MQTT-SN message types answered by the gateway stand-in */
+#define CONNECT         (0x04)
+#define CONNACK         (0x05)
+#define REGISTER        (0x0a)
+#define REGACK          (0x0b)
+#define PUBLISH         (0x0c)
+#define PUBACK          (0x0d)
+#define PINGREQ         (0x16)
+#define PINGRESP        (0x17)
+#define DISCONNECT      (0x18)
+
+typedef struct {
+    uint32_t due;
+    size_t len;
+    uint8_t buf[7];
+} response_t;
+
+static char _emcute_stack[STACKSIZE];
+static char _gw_stack[STACKSIZE];
+static sock_udp_t _gw_sock;
+static sock_udp_ep_t _client;
+static response_t _queue[GW_QUEUE_SIZE];
+static unsigned _queue_head, _queue_numof;
+static unsigned _gw_pubs;
+static uint16_t _gw_topic_id;
+
+static emcute_topic_t _topics[2 * TOPICS];
+static char _topic_names[2 * TOPICS][16];
+
+static mutex_t _pubs_done = MUTEX_INIT_LOCKED;
+static volatile unsigned _pubs_acked;
+static volatile unsigned _pubs_failed;
+
+static void *_emcute_thread(void *arg)
+{
+    (void)arg;
+    emcute_run(EMCUTE_PORT, "riot");
+    return NULL;
+}
+
+/* queues a response that is sent after GW_DELAY, as over a multi-hop path */
+static void _gw_respond(const uint8_t *req, size_t req_len)
+{
+    response_t *resp;
+
+    if (_queue_numof == GW_QUEUE_SIZE) {
+        /* dropped, the client retransmits */
+        return;
+    }
+    resp = &_queue[(_queue_head + _queue_numof) % GW_QUEUE_SIZE];
+    resp->due = xtimer_now_usec() + GW_DELAY;
+    switch (req[1]) {
+        case CONNECT:
+            resp->len = 3;
+            resp->buf[1] = CONNACK;
+            resp->buf[2] = 0;
+            break;
+        case REGISTER:
+            /* topic ID, message ID and return code */
+            resp->len = 7;
+            resp->buf[1] = REGACK;
+            _gw_topic_id++;
+            resp->buf[2] = (uint8_t)(_gw_topic_id >> 8);
+            resp->buf[3] = (uint8_t)_gw_topic_id;
+            memcpy(&resp->buf[4], &req[4], 2);
+            resp->buf[6] = 0;
+            break;
+        case PUBLISH:
+            _gw_pubs++;
+            if (!(req[2] & EMCUTE_QOS_1) || (req_len < 7)) {
+                return;
+            }
+            /* topic ID, message ID and return code */
+            resp->len = 7;
+            resp->buf[1] = PUBACK;
+            memcpy(&resp->buf[2], &req[3], 4);
+            resp->buf[6] = 0;
+            break;
+        case PINGREQ:
+            resp->len = 2;
+            resp->buf[1] = PINGRESP;
+            break;
+        case DISCONNECT:
+            resp->len = 2;
+            resp->buf[1] = DISCONNECT;
+            break;
+        default:
+            return;
+    }
+    resp->buf[0] = (uint8_t)resp->len;
+    _queue_numof++;
+}
+
+static void *_gw_thread(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    uint8_t buf[EMCUTE_BUFSIZE];
+
+    (void)arg;
+    local.port = GW_PORT;
+    if (sock_udp_create(&_gw_sock, &local, NULL, 0) < 0) {
+        puts("gateway: unable to open UDP socket");
+        return NULL;
+    }
+    while (1) {
+        uint32_t timeout = SOCK_NO_TIMEOUT;
+
+        while (_queue_numof > 0) {
+            response_t *resp = &_queue[_queue_head];
+            int32_t wait = (int32_t)(resp->due - xtimer_now_usec());
+
+            if (wait > 0) {
+                timeout = (uint32_t)wait;
+                break;
+            }
+            sock_udp_send(&_gw_sock, resp->buf, resp->len, &_client);
+            _queue_head = (_queue_head + 1) % GW_QUEUE_SIZE;
+            _queue_numof--;
+        }
+        ssize_t res = sock_udp_recv(&_gw_sock, buf, sizeof(buf), timeout, &_client);
+        /* emCute only sends messages with a single length byte in this test */
+        if (res >= 2) {
+            _gw_respond(buf, (size_t)res);
+        }
+    }
+    return NULL;
+}
+
+static void _pub_done(emcute_topic_t *topic, int res, void *arg)
+{
+    (void)topic;
+    (void)arg;
+    if (res != EMCUTE_OK) {
+        _pubs_failed++;
+    }
+    if (++_pubs_acked == PUBS) {
+        mutex_unlock(&_pubs_done);
+    }
+}
+
+static void _print_rate(const char *name, unsigned numof, const char *unit, uint32_t time)
+{
+    printf("%s: %u in %" PRIu32 " us, %" PRIu32 " %s/s\n", name, numof, time,
+           (uint32_t)(((uint64_t)numof * US_PER_SEC) / time), unit);
+}
+
+int main(void)
+{
+    sock_udp_ep_t gw = { .family = AF_INET6, .port = GW_PORT };
+    const char data[] = "21.5";
+    uint32_t start;
+    int res;
+
+    printf("PUBS=%u, TOPICS=%u, GW_DELAY=%u, EMCUTE_ASYNC_WINDOW=%u\n", (unsigned)PUBS,
+           (unsigned)TOPICS, (unsigned)GW_DELAY, (unsigned)EMCUTE_ASYNC_WINDOW);
+    ipv6_addr_set_loopback((ipv6_addr_t *)&gw.addr.ipv6);
+    thread_create(_gw_stack, sizeof(_gw_stack), THREAD_PRIORITY_MAIN - 2, 0,
+                  _gw_thread, NULL, "gateway");
+    thread_create(_emcute_stack, sizeof(_emcute_stack), THREAD_PRIORITY_MAIN - 1, 0,
+                  _emcute_thread, NULL, "emcute");
+
+    if ((res = emcute_con(&gw, true, NULL, NULL, 0, 0)) != EMCUTE_OK) {
+        printf("unable to connect: %d\n", res);
+        return 1;
+    }
+    for (unsigned i = 0; i < (2 * TOPICS); i++) {
+        snprintf(_topic_names[i], sizeof(_topic_names[i]), "sensor/%u", i);
+        _topics[i].name = _topic_names[i];
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TOPICS; i++) {
+        if ((res = emcute_reg(&_topics[i])) != EMCUTE_OK) {
+            printf("unable to register topic %u: %d\n", i, res);
+            return 1;
+        }
+    }
+    _print_rate("emcute_reg       ", TOPICS, "topics", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    if ((res = emcute_reg_batch(&_topics[TOPICS], TOPICS)) != EMCUTE_OK) {
+        printf("unable to register topics: %d\n", res);
+        return 1;
+    }
+    _print_rate("emcute_reg_batch ", TOPICS, "topics", xtimer_now_usec() - start);
+    for (unsigned i = 0; i < (2 * TOPICS); i++) {
+        for (unsigned j = 0; j < i; j++) {
+            if (_topics[i].id == _topics[j].id) {
+                printf("topics %u and %u got the same ID\n", j, i);
+                return 1;
+            }
+        }
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < PUBS; i++) {
+        if ((res = emcute_pub(&_topics[i % TOPICS], data, sizeof(data),
+                              EMCUTE_QOS_1)) != EMCUTE_OK) {
+            printf("unable to publish: %d\n", res);
+            return 1;
+        }
+    }
+    _print_rate("emcute_pub       ", PUBS, "publishes", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < PUBS; i++) {
+        if ((res = emcute_pub_async(&_topics[TOPICS + (i % TOPICS)], data, sizeof(data),
+                                    EMCUTE_QOS_1, _pub_done, NULL)) != EMCUTE_OK) {
+            printf("unable to publish: %d\n", res);
+            return 1;
+        }
+    }
+    mutex_lock(&_pubs_done);
+    _print_rate("emcute_pub_async ", PUBS, "publishes", xtimer_now_usec() - start);
+
+    if (_pubs_failed > 0) {
+        printf("%u publishes failed\n", _pubs_failed);
+        return 1;
+    }
+    if ((res = emcute_discon()) != EMCUTE_OK) {
+        printf("unable to disconnect: %d\n", res);
+        return 1;
+    }
+    if (_gw_pubs != (2 * PUBS)) {
+        printf("gateway received %u publishes\n", _gw_pubs);
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the FIB unittests against the radix trie backend
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+
+#include "../unittests/tests-fib/tests-fib.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_fib();
+    TESTS_END();
+
+    return 0;
+}
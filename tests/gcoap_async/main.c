@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Request rate of gcoap and its PDU buffer pool
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define REQS    (1000U)
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+
+static const coap_resource_t _resources[] = {
+    { "/bench", COAP_GET, _handler },
+};
+
+static gcoap_listener_t _listener = {
+    (coap_resource_t *)&_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL
+};
+
+static mutex_t _slot = MUTEX_INIT_LOCKED;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static volatile unsigned _resps;
+static volatile unsigned _timeouts;
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu)
+{
+    (void)pdu;
+
+    if (req_state == GCOAP_MEMO_TIMEOUT) {
+        _timeouts++;
+    }
+    if (++_resps == REQS) {
+        mutex_unlock(&_done);
+    }
+    /* the gcoap thread has a higher priority, so the memo is free when the
+     * main thread runs again */
+    mutex_unlock(&_slot);
+}
+
+#ifdef MODULE_GCOAP_ASYNC
+/* Buffers are distinct, and freed buffers are handed out again */
+static void test_gcoap__pdu_buf_pool(void)
+{
+    uint8_t *bufs[GCOAP_PDU_BUF_NUMOF];
+
+    for (unsigned i = 0; i < GCOAP_PDU_BUF_NUMOF; i++) {
+        bufs[i] = gcoap_pdu_buf_alloc();
+        assert(bufs[i] != NULL);
+        for (unsigned j = 0; j < i; j++) {
+            assert(bufs[i] != bufs[j]);
+        }
+    }
+    assert(gcoap_pdu_buf_alloc() == NULL);
+
+    gcoap_pdu_buf_free(bufs[0]);
+    assert(bufs[0] == gcoap_pdu_buf_alloc());
+    for (unsigned i = 0; i < GCOAP_PDU_BUF_NUMOF; i++) {
+        gcoap_pdu_buf_free(bufs[i]);
+    }
+}
+#endif
+
+/*
+ * Requests to gcoap's own /bench resource over the loopback address, keeping
+ * as many requests in flight as there are memos. Every request is answered
+ * exactly once, and pooled buffers are back in the pool afterwards.
+ */
+static void test_gcoap__requests(void)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .netif = SOCK_ADDR_ANY_NETIF,
+                             .port = GCOAP_PORT };
+    uint8_t stack_buf[GCOAP_PDU_BUF_SIZE];
+    char path[] = "/bench";
+    uint32_t start, duration;
+    uint8_t open_reqs;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6[0]);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < REQS;) {
+        uint8_t *buf = &stack_buf[0];
+        coap_pkt_t pdu;
+        ssize_t len;
+
+#ifdef MODULE_GCOAP_ASYNC
+        /* requests alternate between pooled and own buffers */
+        if ((i & 1) && (buf = gcoap_pdu_buf_alloc()) == NULL) {
+            buf = &stack_buf[0];
+        }
+#endif
+        len = gcoap_request(&pdu, buf, GCOAP_PDU_BUF_SIZE, COAP_METHOD_GET, &path[0]);
+        assert(len > 0);
+        if (gcoap_req_send2(buf, len, &remote, _resp_handler) > 0) {
+            i++;
+            continue;
+        }
+        /* all memos in use, wait for a response */
+        mutex_lock(&_slot);
+    }
+    mutex_lock(&_done);
+    duration = xtimer_now_usec() - start;
+
+    assert(_resps == REQS);
+    assert(_timeouts == 0);
+    gcoap_op_state(&open_reqs);
+    assert(open_reqs == 0);
+#ifdef MODULE_GCOAP_ASYNC
+    uint8_t *bufs[GCOAP_PDU_BUF_NUMOF];
+
+    for (unsigned i = 0; i < GCOAP_PDU_BUF_NUMOF; i++) {
+        bufs[i] = gcoap_pdu_buf_alloc();
+        assert(bufs[i] != NULL);
+    }
+    for (unsigned i = 0; i < GCOAP_PDU_BUF_NUMOF; i++) {
+        gcoap_pdu_buf_free(bufs[i]);
+    }
+#endif
+    printf("%u requests with up to %u in flight in %lu us, %lu requests/s\n",
+           REQS, (unsigned)GCOAP_REQ_WAITING_MAX, (unsigned long)duration,
+           (unsigned long)(((uint64_t)REQS * US_PER_SEC) / duration));
+}
+
+int main(void)
+{
+    gcoap_register_listener(&_listener);
+
+#ifdef MODULE_GCOAP_ASYNC
+    CALL(test_gcoap__pdu_buf_pool());
+#endif
+    CALL(test_gcoap__requests());
+
+    puts("ALL TESTS SUCCESSFUL");
+    return 0;
+}
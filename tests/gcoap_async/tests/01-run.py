@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    # the buffer pool only exists in the event-driven mode
+    if os.environ.get('GCOAP_ASYNC', '1') == '1':
+        child.expect_exact(u"Calling test_gcoap__pdu_buf_pool()")
+    child.expect_exact(u"Calling test_gcoap__requests()")
+    child.expect(u"\d+ requests with up to \d+ in flight in \d+ us, \d+ requests/s")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive time of gnrc_udp with and without checksum offloading
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef PKTS
+#define PKTS            (1000)
+#endif
+
+#ifndef PAYLOAD
+#define PAYLOAD         (1024)
+#endif
+
+#define TEST_PORT       (0x2c94)
+#define TEST_NETIF      (31)
+#define MSG_QUEUE_SIZE  (8)
+
+static const ipv6_addr_t _src = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                          0x8c, 0xd1, 0x47, 0x07, 0xb7, 0x6f, 0x9b, 0x48 } };
+static const ipv6_addr_t _dst = { .u8 = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                                          0x93, 0xcf, 0x11, 0xe1, 0x72, 0x44, 0xab, 0x9e } };
+static uint8_t _udp[sizeof(udp_hdr_t) + PAYLOAD];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+/* builds the UDP datagram with a valid checksum once for all runs */
+static void _init_udp(void)
+{
+    udp_hdr_t *hdr = (udp_hdr_t *)_udp;
+    ipv6_hdr_t ipv6_hdr;
+    uint16_t csum;
+
+    for (unsigned i = sizeof(udp_hdr_t); i < sizeof(_udp); i++) {
+        _udp[i] = (uint8_t)i;
+    }
+    hdr->src_port = byteorder_htons(TEST_PORT + 1);
+    hdr->dst_port = byteorder_htons(TEST_PORT);
+    hdr->length = byteorder_htons(sizeof(_udp));
+    hdr->checksum.u16 = 0;
+    ipv6_hdr.src = _src;
+    ipv6_hdr.dst = _dst;
+    csum = inet_csum(0, _udp, sizeof(_udp));
+    csum = ipv6_hdr_inet_csum(csum, &ipv6_hdr, PROTNUM_UDP, sizeof(_udp));
+    hdr->checksum = byteorder_htons((csum == 0xffff) ? csum : ~csum);
+}
+
+/* passes a copy of the datagram to gnrc_udp as if received by a device */
+static bool _inject(uint8_t netif_flags, bool corrupt)
+{
+    gnrc_pktsnip_t *udp, *ipv6, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+
+    udp = gnrc_pktbuf_add(NULL, _udp, sizeof(_udp), GNRC_NETTYPE_UNDEF);
+    if (udp == NULL) {
+        return false;
+    }
+    if (corrupt) {
+        ((uint8_t *)udp->data)[sizeof(_udp) - 1] ^= 0xff;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &_src, &_dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons(sizeof(_udp));
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    /* received packets are in reverse order */
+    udp->next = ipv6;
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = TEST_NETIF;
+    ((gnrc_netif_hdr_t *)netif->data)->flags = netif_flags;
+    ipv6->next = netif;
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP,
+                                         GNRC_NETREG_DEMUX_CTX_ALL, udp) > 0);
+}
+
+/* returns true if gnrc_udp passed a packet on to this thread */
+static bool _delivered(void)
+{
+    msg_t msg;
+
+    /* UDP thread has a higher priority, so it is done with the packet */
+    if (msg_try_receive(&msg) < 0) {
+        return false;
+    }
+    gnrc_pktbuf_release(msg.content.ptr);
+    return (msg.type == GNRC_NETAPI_MSG_TYPE_RCV);
+}
+
+static uint32_t _run(uint8_t netif_flags)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < PKTS; i++) {
+        if (!_inject(netif_flags, false) || !_delivered()) {
+            printf("packet %u was not delivered\n", i);
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(TEST_PORT,
+                                                           sched_active_pid);
+    uint32_t sw, hw;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+    _init_udp();
+    printf("PKTS=%u, PAYLOAD=%u\n", (unsigned)PKTS, (unsigned)PAYLOAD);
+
+    /* a corrupted packet is only dropped if nobody verified it before */
+    if (!_inject(0, true) || _delivered()) {
+        puts("corrupted packet was not dropped");
+        return 1;
+    }
+    if (!_inject(GNRC_NETIF_HDR_FLAGS_CSUM_VALID, true) || !_delivered()) {
+        puts("packet with verified checksum was dropped");
+        return 1;
+    }
+
+    sw = _run(0);
+    hw = _run(GNRC_NETIF_HDR_FLAGS_CSUM_VALID);
+    if ((sw == 0) || (hw == 0)) {
+        return 1;
+    }
+    printf("checksum verified by gnrc_udp: %" PRIu32 " us (%" PRIu32 " ns/packet)\n",
+           sw, (uint32_t)(((uint64_t)sw * NS_PER_US) / PKTS));
+    printf("checksum verified by device:   %" PRIu32 " us (%" PRIu32 " ns/packet)\n",
+           hw, (uint32_t)(((uint64_t)hw * NS_PER_US) / PKTS));
+    if (!gnrc_pktbuf_is_empty()) {
+        puts("packet buffer not empty");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
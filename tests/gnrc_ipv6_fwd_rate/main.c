@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the IPv6 forwarding rate of a router
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/udp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8)
+#define FLOOD_PORT          (4242U)
+#define FLOOD_BACKOFF_US    (1000U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static uint32_t _tx_unicast(void)
+{
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    size_t numof = gnrc_netif_get(ifs);
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < numof; i++) {
+        sum += gnrc_ipv6_netif_get_stats(ifs[i])->tx_unicast_count;
+    }
+    return sum;
+}
+
+static int _fwdrate(int argc, char **argv)
+{
+    unsigned secs = (argc > 1) ? (unsigned)atoi(argv[1]) : 10;
+    uint32_t last = _tx_unicast();
+    uint32_t total = 0;
+
+    for (unsigned i = 0; i < secs; i++) {
+        xtimer_sleep(1);
+        uint32_t now = _tx_unicast();
+        printf("%lu packets/s\n", (unsigned long)(now - last));
+        total += now - last;
+        last = now;
+    }
+    if (secs) {
+        printf("average: %lu packets/s\n", (unsigned long)(total / secs));
+    }
+    return 0;
+}
+
+static int _flood(int argc, char **argv)
+{
+    ipv6_addr_t dst;
+    unsigned num, size;
+    unsigned sent = 0;
+
+    if (argc < 4) {
+        printf("usage: %s <addr> <num> <payload size>\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str(&dst, argv[1]) == NULL) {
+        puts("error: unable to parse address");
+        return 1;
+    }
+    num = (unsigned)atoi(argv[2]);
+    size = (unsigned)atoi(argv[3]);
+
+    uint32_t start = xtimer_now_usec();
+    while (sent < num) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size,
+                                              GNRC_NETTYPE_UNDEF);
+        if (pkt != NULL) {
+            memset(pkt->data, 0, size);
+            gnrc_pktsnip_t *udp = gnrc_udp_hdr_build(pkt, FLOOD_PORT, FLOOD_PORT);
+            pkt = (udp != NULL) ? udp : pkt;
+            if (udp != NULL) {
+                gnrc_pktsnip_t *ip = gnrc_ipv6_hdr_build(udp, NULL, &dst);
+                pkt = (ip != NULL) ? ip : pkt;
+                if ((ip != NULL) &&
+                    gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP,
+                                              GNRC_NETREG_DEMUX_CTX_ALL, ip)) {
+                    sent++;
+                    continue;
+                }
+            }
+            gnrc_pktbuf_release(pkt);
+        }
+        /* packet buffer is full, let the stack catch up */
+        xtimer_usleep(FLOOD_BACKOFF_US);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+    printf("sent %u packets in %lu us\n", sent, (unsigned long)time);
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "fwdrate", "print forwarded packets per second", _fwdrate },
+    { "flood", "send UDP packets as fast as possible", _flood },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    puts("IPv6 forwarding rate test, with flow cache");
+#else
+    puts("IPv6 forwarding rate test, without flow cache");
+#endif
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the time the IPv6 layer of a router needs to forward
+ *              packets between two interfaces for different FIB sizes
+ *
+ * Packets are handed to the IPv6 thread as if they were received on one
+ * interface and counted when they are sent over the other one, so no tap
+ * setup is needed. Build with GNRC_IPV6_FLOWCACHE=0 to compare against the
+ * forwarding path without the flow cache, tests/gnrc_ipv6_fwd_rate measures
+ * forwarding between real interfaces.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/fib.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define PACKETS         (1000U)
+#define FLOWS           (4U)
+#define PAYLOAD_SIZE    (32U)
+#define HOP_LIMIT       (64U)
+#define PREFIX_LEN      (64U)
+#define QUEUE_SIZE      (8U)
+
+#define SRC_ADDR        { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+#define DST_ADDR        { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } }
+#define NEXT_HOP_ADDR   { { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 } }
+
+static const unsigned route_levels[] = { 1, 4, GNRC_IPV6_FIB_TABLE_SIZE };
+static const uint8_t next_hop_l2addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static char _netif_stacks[2][THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_queues[2][QUEUE_SIZE];
+static kernel_pid_t _in_pid, _out_pid;
+static volatile unsigned _forwarded;
+static unsigned _expected;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+/* stands in for a network interface, counts and drops the forwarded packets */
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    msg_init_queue(arg, QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+
+                /* neighbor discovery may send as well */
+                if ((ipv6 != NULL) &&
+                    (((ipv6_hdr_t *)ipv6->data)->nh == PROTNUM_UDP) &&
+                    (++_forwarded == _expected)) {
+                    mutex_unlock(&_done);
+                }
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static kernel_pid_t _netif_create(unsigned num, const char *name)
+{
+    kernel_pid_t pid = thread_create(_netif_stacks[num], sizeof(_netif_stacks[num]),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST, _netif_thread,
+                                     _netif_queues[num], name);
+    ipv6_addr_t addr = IPV6_ADDR_UNSPECIFIED;
+
+    gnrc_ipv6_netif_add(pid);
+    ipv6_addr_set_link_local_prefix(&addr);
+    addr.u8[15] = 1;
+    gnrc_ipv6_netif_add_addr(pid, &addr, PREFIX_LEN,
+                             GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    return pid;
+}
+
+static int _add_route(unsigned num)
+{
+    ipv6_addr_t prefix = DST_ADDR;
+    ipv6_addr_t next_hop = NEXT_HOP_ADDR;
+
+    /* route 0 is the one to the destinations, the others only fill the FIB */
+    prefix.u8[4] = (uint8_t)(num >> 8);
+    prefix.u8[5] = (uint8_t)num + 2;
+    return fib_add_entry(&gnrc_ipv6_fib_table, _out_pid, prefix.u8,
+                         sizeof(ipv6_addr_t),
+                         (PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT),
+                         next_hop.u8, sizeof(ipv6_addr_t), 0,
+                         (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+/* hands a packet to the IPv6 thread as the interface _in_pid would */
+static int _inject(unsigned flow)
+{
+    ipv6_addr_t src = SRC_ADDR, dst = DST_ADDR;
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+    ipv6_hdr_t *hdr;
+
+    dst.u8[15] = (uint8_t)flow + 1;
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    memset(payload->data, 0, PAYLOAD_SIZE);
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &src, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -ENOMEM;
+    }
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(PAYLOAD_SIZE);
+    hdr->nh = PROTNUM_UDP;
+    hdr->hl = HOP_LIMIT;
+    LL_APPEND(payload, ipv6);
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -ENOMEM;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _in_pid;
+    LL_APPEND(payload, netif);
+    /* the IPv6 thread has a higher priority, so it forwards the packet
+     * right away */
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, payload) == 0) {
+        gnrc_pktbuf_release(payload);
+        return -ENOENT;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    ipv6_addr_t next_hop = NEXT_HOP_ADDR;
+    unsigned routes = 0;
+
+    _in_pid = _netif_create(0, "in");
+    _out_pid = _netif_create(1, "out");
+    gnrc_ipv6_nc_add(_out_pid, &next_hop, next_hop_l2addr,
+                     sizeof(next_hop_l2addr), GNRC_IPV6_NC_STATE_REACHABLE);
+
+    puts("Start.");
+
+    for (unsigned n = 0; n < sizeof(route_levels) / sizeof(route_levels[0]); ++n) {
+        uint32_t start, duration;
+
+        for (; routes < route_levels[n]; ++routes) {
+            if (_add_route(routes) != 0) {
+                printf("error: unable to add route %u\n", routes);
+                return 1;
+            }
+        }
+
+        _forwarded = 0;
+        _expected = PACKETS;
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < PACKETS; ++i) {
+            if (_inject(i % FLOWS) < 0) {
+                puts("error: unable to inject packet");
+                return 1;
+            }
+        }
+        mutex_lock(&_done);
+        duration = xtimer_now_usec() - start;
+
+        printf("+ %2u routes: forwarded %u packets in %lu us, %lu packets/s\n",
+               routes, PACKETS, (unsigned long)duration,
+               (unsigned long)(((uint64_t)PACKETS * US_PER_SEC) / duration));
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the lookup time of the neighbor cache for different
+ *            numbers of neighbors
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/ipv6/nc.h"
+#include "net/ipv6/addr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define LOOKUPS     (10000U)
+
+static const uint8_t l2_addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+
+static void _make_addr(ipv6_addr_t *addr, unsigned n)
+{
+    /* fe80::<n>, neighbors share the link-local prefix */
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u16[4].u16 = 0;
+    addr->u16[5].u16 = 0;
+    addr->u16[6].u16 = 0;
+    addr->u16[7] = byteorder_htons((uint16_t)n + 1);
+}
+
+int main(void)
+{
+    kernel_pid_t iface = thread_getpid();
+    ipv6_addr_t addr, miss;
+    unsigned num = 0;
+
+    gnrc_ipv6_nc_init();
+    /* no neighbor has a global address */
+    ipv6_addr_from_str(&miss, "2001:db8::1");
+
+    puts("Start.");
+
+    for (unsigned size = 8; size <= GNRC_IPV6_NC_SIZE; size *= 2) {
+        uint32_t start, hit, missed;
+
+        for (; num < size; ++num) {
+            _make_addr(&addr, num);
+            if (gnrc_ipv6_nc_add(iface, &addr, l2_addr, sizeof(l2_addr), 0) == NULL) {
+                printf("error: cannot add neighbor %u\n", num);
+                return 1;
+            }
+        }
+
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < LOOKUPS; ++i) {
+            _make_addr(&addr, (i * 7) % num);
+            if (gnrc_ipv6_nc_get(iface, &addr) == NULL) {
+                printf("error: cannot find neighbor %u\n", (i * 7) % num);
+                return 1;
+            }
+        }
+        hit = xtimer_now_usec() - start;
+
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < LOOKUPS; ++i) {
+            if (gnrc_ipv6_nc_get(iface, &miss) != NULL) {
+                puts("error: unknown neighbor found");
+                return 1;
+            }
+        }
+        missed = xtimer_now_usec() - start;
+
+        printf("+ %3u entries: %u lookups in %lu us (hit), %lu us (miss)\n",
+               num, LOOKUPS, (unsigned long)hit, (unsigned long)missed);
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the receive path of the GNRC Ethernet glue code
+ *
+ * The device emulates `netdev_tap`: it reports the maximum frame length when
+ * asked for the size of the next frame and then copies the frame into the
+ * given buffer. The in-place receive of gnrc_netdev_eth is compared against
+ * the former approach of splitting off the Ethernet header with
+ * gnrc_pktbuf_mark().
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev/eth.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define FRAMES      (1000U)
+
+static const unsigned frame_lens[] = { 64, 128, 512, sizeof(ethernet_hdr_t) + 1280 };
+
+static gnrc_netdev_t _gnrc_dev;
+static netdev_test_t _dev;
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static unsigned _frame_len;
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        /* like netdev_tap there is no way to know the size in advance */
+        return (len > 0) ? 0 : ETHERNET_FRAME_LEN;
+    }
+    if ((unsigned)len < _frame_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, _frame_len);
+    return _frame_len;
+}
+
+/* receive as gnrc_netdev_eth did before, with a marked Ethernet header */
+static gnrc_pktsnip_t *_recv_mark(gnrc_netdev_t *gnrc_netdev)
+{
+    netdev_t *dev = gnrc_netdev->dev;
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    gnrc_pktsnip_t *pkt, *eth_hdr, *netif_hdr;
+    ethernet_hdr_t *hdr;
+    int nread;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+    if (nread <= 0) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    gnrc_pktbuf_realloc_data(pkt, nread);
+    eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (eth_hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    hdr = eth_hdr->data;
+    pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
+    netif_hdr = gnrc_netif_hdr_build(hdr->src, ETHERNET_ADDR_LEN,
+                                     hdr->dst, ETHERNET_ADDR_LEN);
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+    LL_APPEND(pkt, netif_hdr);
+    return pkt;
+}
+
+static uint32_t _measure(gnrc_pktsnip_t *(*recv)(gnrc_netdev_t *))
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < FRAMES; i++) {
+        gnrc_pktsnip_t *pkt = recv(&_gnrc_dev);
+
+        if ((pkt == NULL) ||
+            (pkt->size != (_frame_len - sizeof(ethernet_hdr_t))) ||
+            (memcmp(pkt->data, _frame + sizeof(ethernet_hdr_t), pkt->size) != 0)) {
+            puts("error: unexpected packet");
+            return 0;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)_frame;
+
+    puts("Start.");
+
+    gnrc_pktbuf_init();
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_recv_cb(&_dev, _dev_recv);
+    gnrc_netdev_eth_init(&_gnrc_dev, (netdev_t *)&_dev);
+
+    for (unsigned i = 0; i < sizeof(_frame); i++) {
+        _frame[i] = (uint8_t)i;
+    }
+    hdr->type = byteorder_htons(ETHERTYPE_IPV6);
+
+    for (unsigned i = 0; i < sizeof(frame_lens) / sizeof(frame_lens[0]); i++) {
+        uint32_t in_place, mark;
+
+        _frame_len = frame_lens[i];
+        in_place = _measure(_gnrc_dev.recv);
+        mark = _measure(_recv_mark);
+        if ((in_place == 0) || (mark == 0)) {
+            return 1;
+        }
+        printf("+ %4u byte frames: %u in place in %lu us, with mark in %lu us\n",
+               _frame_len, FRAMES, (unsigned long)in_place, (unsigned long)mark);
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the lookup time of the GNRC network registry for
+ *            different numbers of registered demux contexts
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define FIRST_CTX   (1024U)
+#define MAX_ENTRIES (64U)
+#define LOOKUPS     (10000U)
+#define QUEUE_SIZE  (4U)
+
+static const unsigned fill_levels[] = { 1, 8, 32, MAX_ENTRIES };
+
+static gnrc_netreg_entry_t entries[MAX_ENTRIES];
+static msg_t queue[QUEUE_SIZE];
+
+int main(void)
+{
+    unsigned registered = 0;
+
+    /* only threads with a message queue may register */
+    msg_init_queue(queue, QUEUE_SIZE);
+    gnrc_netreg_init();
+
+    puts("Start.");
+
+    for (unsigned n = 0; n < sizeof(fill_levels) / sizeof(fill_levels[0]); ++n) {
+        uint32_t start, duration;
+
+        for (; registered < fill_levels[n]; ++registered) {
+            gnrc_netreg_entry_init_pid(&entries[registered],
+                                       FIRST_CTX + registered,
+                                       thread_getpid());
+            gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[registered]);
+        }
+
+        start = xtimer_now_usec();
+        for (unsigned i = 0; i < LOOKUPS; ++i) {
+            if (gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                   FIRST_CTX + (i % registered)) == NULL) {
+                printf("error: context %u not found\n", FIRST_CTX + (i % registered));
+                return 1;
+            }
+        }
+        duration = xtimer_now_usec() - start;
+
+        printf("+ %2u entries: %u lookups in %lu us\n",
+               registered, LOOKUPS, (unsigned long)duration);
+    }
+
+    puts("Done.");
+    return 0;
+}
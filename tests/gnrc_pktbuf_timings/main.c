@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the receive and release rate of the packet buffer and
+ *            how often it fails under bursty traffic
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#define SLOTS       (16U)
+#define ROUNDS      (2048U)
+#define REASS_SIZE  (1280U)
+
+/* receives a frame of a given length and splits off link layer and
+ * 6LoWPAN headers like the stack does */
+static gnrc_pktsnip_t *_recv_frame(size_t size)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+
+    if ((pkt == NULL) ||
+        (gnrc_pktbuf_mark(pkt, 9, GNRC_NETTYPE_UNDEF) == NULL) ||
+        (gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return pkt;
+}
+
+static int run_throughput(size_t size)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < ROUNDS; ++i) {
+        gnrc_pktsnip_t *pkt = _recv_frame(size);
+
+        if (pkt == NULL) {
+            printf("error: cannot receive frame %u\n", i);
+            return 1;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    printf("+ %3u byte frames: %u received and released in %lu us\n",
+           (unsigned)size, ROUNDS, (unsigned long)(xtimer_now_usec() - start));
+    return 0;
+}
+
+static void run_fragmentation(void)
+{
+    gnrc_pktsnip_t *slots[SLOTS] = { NULL };
+    uint32_t rnd = 0xfedcba98;
+    unsigned failed = 0;
+
+    /* bursty traffic: frames of varying length are released in random order
+     * while a full-MTU reassembly buffer is requested now and then */
+    for (unsigned i = 0; i < ROUNDS; ++i) {
+        unsigned slot;
+
+        rnd = (rnd * 1103515245) + 12345;
+        slot = (rnd >> 16) % SLOTS;
+        gnrc_pktbuf_release(slots[slot]);
+        slots[slot] = _recv_frame(24 + ((rnd >> 8) % 104));
+        if (slots[slot] == NULL) {
+            failed++;
+        }
+
+        if ((i % 8) == 0) {
+            gnrc_pktsnip_t *reass = gnrc_pktbuf_add(NULL, NULL, REASS_SIZE,
+                                                    GNRC_NETTYPE_UNDEF);
+            if (reass == NULL) {
+                failed++;
+            }
+            gnrc_pktbuf_release(reass);
+        }
+    }
+    for (unsigned i = 0; i < SLOTS; ++i) {
+        gnrc_pktbuf_release(slots[i]);
+    }
+    printf("+ bursty traffic: %u of %u allocations failed\n", failed,
+           ROUNDS + (ROUNDS / 8));
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    if ((run_throughput(32) != 0) || (run_throughput(127) != 0)) {
+        return 1;
+    }
+    run_fragmentation();
+
+    puts("Done.");
+    return 0;
+}
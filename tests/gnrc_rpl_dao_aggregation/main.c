@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the aggregation of DAO triggers in storing mode
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/icmpv6.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define _TEST_PREFIX        { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }
+#define _TEST_INSTANCE_ID   (GNRC_RPL_DEFAULT_INSTANCE)
+#define _TEST_ROOT          (0xff)  /**< last byte of the DODAG id */
+#define _TEST_ME            (0x01)
+#define _TEST_PARENT        (0x02)
+#define _TEST_CHILD1        (0x03)
+#define _TEST_CHILD2        (0x05)
+#define _TEST_TARGET1       (0x03)
+#define _TEST_TARGET2       (0x04)
+#define _TEST_TARGET3       (0x05)
+#define _TEST_PATH_LIFETIME (GNRC_RPL_DEFAULT_LIFETIME)
+/* a DAO is sent GNRC_RPL_DEFAULT_DAO_DELAY + GNRC_RPL_DAO_DELAY_JITTER seconds
+ * after it was triggered at the latest, plus a step of the lifetime timer */
+#define _TEST_DAO_TIMEOUT   ((GNRC_RPL_DEFAULT_DAO_DELAY + GNRC_RPL_DAO_DELAY_JITTER + \
+                              GNRC_RPL_LIFETIME_UPDATE_STEP) * US_PER_SEC)
+#define _TEST_POLL_INTERVAL (100U * US_PER_MS)
+
+#define _MSG_QUEUE_SIZE     (8U)
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_msg_queue[_MSG_QUEUE_SIZE];
+static kernel_pid_t _netif_pid = KERNEL_PID_UNDEF;
+static uint8_t _buf[128];
+static uint8_t _dao_seq;
+
+/* stands in for the network interface, drops every packet sent to it */
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_msg_queue, _MSG_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void _addr(ipv6_addr_t *addr, bool link_local, uint8_t last)
+{
+    static const ipv6_addr_t prefix = { .u8 = _TEST_PREFIX };
+
+    *addr = (link_local) ? ipv6_addr_link_local_prefix : prefix;
+    addr->u8[15] = last;
+}
+
+/* hands an RPL control message from src to gnrc_rpl as the IPv6 layer would */
+static void _inject(uint8_t last_src, uint8_t code, const void *data, size_t len)
+{
+    gnrc_pktsnip_t *icmpv6, *ipv6, *netif_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t src, dst;
+    int res;
+
+    _addr(&src, true, last_src);
+    _addr(&dst, true, _TEST_ME);
+    icmpv6 = gnrc_icmpv6_build(NULL, ICMPV6_RPL_CTRL, code,
+                               sizeof(icmpv6_hdr_t) + len);
+    assert(icmpv6 != NULL);
+    memcpy(((icmpv6_hdr_t *)icmpv6->data) + 1, data, len);
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &src, &dst);
+    assert(ipv6 != NULL);
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons((uint16_t)icmpv6->size);
+    ipv6_hdr->nh = PROTNUM_ICMPV6;
+    LL_APPEND(icmpv6, ipv6);
+    netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    assert(netif_hdr != NULL);
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _netif_pid;
+    LL_APPEND(icmpv6, netif_hdr);
+    /* gnrc_rpl has a higher priority, so the message is handled on return */
+    res = gnrc_netapi_dispatch_receive(GNRC_NETTYPE_ICMPV6, ICMPV6_RPL_CTRL,
+                                       icmpv6);
+    assert(res == 1);
+    (void)res;
+}
+
+static void _inject_dio(void)
+{
+    gnrc_rpl_dio_t dio;
+    gnrc_rpl_opt_dodag_conf_t conf;
+
+    memset(&dio, 0, sizeof(dio));
+    dio.instance_id = _TEST_INSTANCE_ID;
+    dio.version_number = GNRC_RPL_COUNTER_INIT;
+    dio.rank = byteorder_htons(GNRC_RPL_ROOT_RANK);
+    /* grounded flag and mode of operation */
+    dio.g_mop_prf = (GNRC_RPL_GROUNDED << 7) | (GNRC_RPL_DEFAULT_MOP << 3);
+    _addr(&dio.dodag_id, false, _TEST_ROOT);
+    memset(&conf, 0, sizeof(conf));
+    conf.type = GNRC_RPL_OPT_DODAG_CONF;
+    conf.length = GNRC_RPL_OPT_DODAG_CONF_LEN;
+    conf.dio_int_doubl = GNRC_RPL_DEFAULT_DIO_INTERVAL_DOUBLINGS;
+    conf.dio_int_min = GNRC_RPL_DEFAULT_DIO_INTERVAL_MIN;
+    conf.dio_redun = GNRC_RPL_DEFAULT_DIO_REDUNDANCY_CONSTANT;
+    conf.max_rank_inc = byteorder_htons(GNRC_RPL_DEFAULT_MAX_RANK_INCREASE);
+    conf.min_hop_rank_inc = byteorder_htons(GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE);
+    conf.ocp = byteorder_htons(GNRC_RPL_DEFAULT_OCP);
+    conf.default_lifetime = GNRC_RPL_DEFAULT_LIFETIME;
+    conf.lifetime_unit = byteorder_htons(GNRC_RPL_LIFETIME_UNIT);
+    memcpy(_buf, &dio, sizeof(dio));
+    memcpy(_buf + sizeof(dio), &conf, sizeof(conf));
+    _inject(_TEST_PARENT, GNRC_RPL_ICMPV6_CODE_DIO, _buf,
+            sizeof(dio) + sizeof(conf));
+}
+
+/* a DAO of a child with pad1 PAD1 options before the targets, all targets
+ * share one transit option */
+static void _inject_dao(uint8_t child, unsigned pad1, const uint8_t *targets,
+                        unsigned targets_numof, uint8_t path_lifetime)
+{
+    gnrc_rpl_dao_t dao;
+    gnrc_rpl_opt_target_t target;
+    gnrc_rpl_opt_transit_t transit;
+    size_t len = 0;
+
+    memset(&dao, 0, sizeof(dao));
+    dao.instance_id = _TEST_INSTANCE_ID;
+    dao.dao_sequence = _dao_seq++;
+    memcpy(_buf, &dao, sizeof(dao));
+    len += sizeof(dao);
+    memset(_buf + len, GNRC_RPL_OPT_PAD1, pad1);
+    len += pad1;
+    for (unsigned i = 0; i < targets_numof; i++) {
+        memset(&target, 0, sizeof(target));
+        target.type = GNRC_RPL_OPT_TARGET;
+        target.length = GNRC_RPL_OPT_TARGET_LEN;
+        target.prefix_length = IPV6_ADDR_BIT_LEN;
+        _addr(&target.target, false, targets[i]);
+        memcpy(_buf + len, &target, sizeof(target));
+        len += sizeof(target);
+    }
+    memset(&transit, 0, sizeof(transit));
+    transit.type = GNRC_RPL_OPT_TRANSIT;
+    transit.length = GNRC_RPL_OPT_TRANSIT_INFO_LEN;
+    transit.path_lifetime = path_lifetime;
+    memcpy(_buf + len, &transit, sizeof(transit));
+    len += sizeof(transit);
+    assert(len <= sizeof(_buf));
+    _inject(child, GNRC_RPL_ICMPV6_CODE_DAO, _buf, len);
+}
+
+static void _inject_dao_ack(void)
+{
+    gnrc_rpl_dao_ack_t dao_ack;
+
+    memset(&dao_ack, 0, sizeof(dao_ack));
+    dao_ack.instance_id = _TEST_INSTANCE_ID;
+    _inject(_TEST_PARENT, GNRC_RPL_ICMPV6_CODE_DAO_ACK, &dao_ack,
+            sizeof(dao_ack));
+}
+
+static uint32_t _daos_sent(void)
+{
+    return gnrc_rpl_netstats.dao_tx_ucast_count;
+}
+
+/* waits for the DAO to the parent and acknowledges it, returns the number of
+ * DAOs sent until the timeout */
+static uint32_t _wait_for_daos(uint32_t sent)
+{
+    uint32_t start = xtimer_now_usec();
+    uint32_t acked = sent;
+
+    while ((xtimer_now_usec() - start) < _TEST_DAO_TIMEOUT) {
+        if (_daos_sent() != acked) {
+            acked = _daos_sent();
+            _inject_dao_ack();
+        }
+        xtimer_usleep(_TEST_POLL_INTERVAL);
+    }
+    return _daos_sent() - sent;
+}
+
+/* checks if the FIB routes the target to the child */
+static bool _has_route(uint8_t target, uint8_t child)
+{
+    ipv6_addr_t dst, next_hop, expected;
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+    kernel_pid_t iface;
+
+    _addr(&dst, false, target);
+    _addr(&expected, true, child);
+    if (fib_get_next_hop(&gnrc_ipv6_fib_table, &iface, next_hop.u8,
+                         &next_hop_size, &next_hop_flags, dst.u8,
+                         sizeof(dst), 0) < 0) {
+        return false;
+    }
+    return ipv6_addr_equal(&next_hop, &expected);
+}
+
+static void test_dao_aggregation__join(void)
+{
+    gnrc_rpl_instance_t *inst;
+
+    _inject_dio();
+    inst = gnrc_rpl_instance_get(_TEST_INSTANCE_ID);
+    assert(inst != NULL);
+    assert(inst->dodag.parents != NULL);
+    assert(inst->dodag.node_status != GNRC_RPL_LEAF_NODE);
+    /* joining schedules the first DAO */
+    assert(_wait_for_daos(_daos_sent()) == 1);
+}
+
+static void test_dao_aggregation__new_route(void)
+{
+    static const uint8_t targets[] = { _TEST_TARGET1 };
+    uint32_t sent = _daos_sent();
+    uint32_t suppressed = gnrc_rpl_netstats.dao_suppressed;
+
+    _inject_dao(_TEST_CHILD1, 0, targets, sizeof(targets), _TEST_PATH_LIFETIME);
+    assert(_has_route(_TEST_TARGET1, _TEST_CHILD1));
+    assert(gnrc_rpl_netstats.dao_suppressed == suppressed);
+    assert(_wait_for_daos(sent) == 1);
+}
+
+static void test_dao_aggregation__refresh(void)
+{
+    static const uint8_t targets[] = { _TEST_TARGET1 };
+    uint32_t sent = _daos_sent();
+    uint32_t suppressed = gnrc_rpl_netstats.dao_suppressed;
+
+    _inject_dao(_TEST_CHILD1, 0, targets, sizeof(targets), _TEST_PATH_LIFETIME);
+    assert(_has_route(_TEST_TARGET1, _TEST_CHILD1));
+    assert(gnrc_rpl_netstats.dao_suppressed == (suppressed + 1));
+    assert(_wait_for_daos(sent) == 0);
+}
+
+static void test_dao_aggregation__merged(void)
+{
+    static const uint8_t targets1[] = { _TEST_TARGET1, _TEST_TARGET2 };
+    static const uint8_t targets2[] = { _TEST_TARGET3 };
+    uint32_t sent = _daos_sent();
+    uint32_t aggregated = gnrc_rpl_netstats.dao_aggregated;
+
+    /* a new target via a known child and a new child right after another */
+    _inject_dao(_TEST_CHILD1, 0, targets1, sizeof(targets1), _TEST_PATH_LIFETIME);
+    _inject_dao(_TEST_CHILD2, 0, targets2, sizeof(targets2), _TEST_PATH_LIFETIME);
+    assert(_has_route(_TEST_TARGET1, _TEST_CHILD1));
+    assert(_has_route(_TEST_TARGET2, _TEST_CHILD1));
+    assert(_has_route(_TEST_TARGET3, _TEST_CHILD2));
+    assert(gnrc_rpl_netstats.dao_aggregated == (aggregated + 1));
+    assert(_wait_for_daos(sent) == 1);
+}
+
+static void test_dao_aggregation__no_path(void)
+{
+    static const uint8_t targets[] = { _TEST_TARGET2 };
+    uint32_t sent = _daos_sent();
+    uint32_t suppressed = gnrc_rpl_netstats.dao_suppressed;
+
+    /* PAD1 options have no length field */
+    _inject_dao(_TEST_CHILD1, 3, targets, sizeof(targets), 0);
+    assert(gnrc_rpl_netstats.dao_suppressed == suppressed);
+    assert(_wait_for_daos(sent) == 1);
+    assert(!_has_route(_TEST_TARGET2, _TEST_CHILD1));
+    assert(_has_route(_TEST_TARGET1, _TEST_CHILD1));
+    assert(_has_route(_TEST_TARGET3, _TEST_CHILD2));
+}
+
+int main(void)
+{
+    ipv6_addr_t addr, *res;
+
+    _netif_pid = thread_create(_netif_stack, sizeof(_netif_stack),
+                               THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                               _netif_thread, NULL, "netif");
+    gnrc_ipv6_netif_add(_netif_pid);
+    _addr(&addr, true, _TEST_ME);
+    res = gnrc_ipv6_netif_add_addr(_netif_pid, &addr, 64,
+                                   GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    assert(res != NULL);
+    _addr(&addr, false, _TEST_ME);
+    res = gnrc_ipv6_netif_add_addr(_netif_pid, &addr, 64,
+                                   GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    assert(res != NULL);
+    (void)res;
+    gnrc_rpl_init(_netif_pid);
+    assert(gnrc_rpl_pid != KERNEL_PID_UNDEF);
+
+    CALL(test_dao_aggregation__join());
+    CALL(test_dao_aggregation__new_route());
+    CALL(test_dao_aggregation__refresh());
+    CALL(test_dao_aggregation__merged());
+    CALL(test_dao_aggregation__no_path());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+# every test waits for the DAO delay of gnrc_rpl
+TIMEOUT = 20
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_dao_aggregation__join()")
+    child.expect_exact(u"Calling test_dao_aggregation__new_route()", timeout=TIMEOUT)
+    child.expect_exact(u"Calling test_dao_aggregation__refresh()", timeout=TIMEOUT)
+    child.expect_exact(u"Calling test_dao_aggregation__merged()", timeout=TIMEOUT)
+    child.expect_exact(u"Calling test_dao_aggregation__no_path()", timeout=TIMEOUT)
+    child.expect_exact(u"ALL TESTS SUCCESSFUL", timeout=TIMEOUT)
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       DAO traffic after a global repair in a simulated storing mode DODAG
+ *
+ * The DAO timers of the nodes are handled by gnrc_rpl_delay_dao() and
+ * gnrc_rpl_long_delay_dao(), the DAOs and DAO-ACKs are counted in
+ * gnrc_rpl_netstats, as gnrc_rpl would do, and shown with `rpl stats`.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/icmpv6.h"
+#include "random.h"
+#include "shell.h"
+#include "shell_commands.h"
+
+#ifndef NODES
+#define NODES           (50)
+#endif
+
+#ifndef BRANCHES
+#define BRANCHES        (3)
+#endif
+
+#ifndef DURATION
+#define DURATION        (300)
+#endif
+
+#ifndef SEED
+#define SEED            (1)
+#endif
+
+#define TICKS           (DURATION / GNRC_RPL_LIFETIME_UPDATE_STEP)
+#define HOP_TICKS       (3)     /**< maximum ticks until a child hears the new version */
+
+typedef struct {
+    gnrc_rpl_dodag_t dodag;
+    unsigned join;              /**< tick the node joins the new DODAG version */
+    bool routes[NODES];         /**< targets in the FIB of the node */
+    bool dao_pending;           /**< DAO to the parent sent in the current tick */
+} node_t;
+
+static node_t _nodes[NODES];
+
+static unsigned _parent(unsigned node)
+{
+    return (node - 1) / BRANCHES;
+}
+
+/* gnrc_rpl_delay_dao() before DAOs were aggregated */
+static void _delay_dao_per_trigger(gnrc_rpl_dodag_t *dodag)
+{
+    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    dodag->dao_counter = 0;
+    dodag->dao_ack_received = false;
+}
+
+/* _dao_handle_send() of gnrc_rpl, the DAO itself is sent at the end of the tick */
+static void _dao_handle_send(node_t *node)
+{
+    gnrc_rpl_dodag_t *dodag = &node->dodag;
+
+    if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
+        dodag->dao_counter++;
+        node->dao_pending = true;
+        dodag->dao_time = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+    }
+    else if (dodag->dao_ack_received == false) {
+        gnrc_rpl_long_delay_dao(dodag);
+    }
+}
+
+/* counts a DAO like gnrc_rpl_send_DAO() and gnrc_rpl_recv_DAO() do: the
+ * targets from the FIB with one transit option and the address of the sender
+ * with another one */
+static void _count_dao(unsigned targets)
+{
+    uint32_t len = sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_t) +
+                   ((targets + 1) * sizeof(gnrc_rpl_opt_target_t)) +
+                   (((targets > 0) ? 2 : 1) * sizeof(gnrc_rpl_opt_transit_t));
+
+    gnrc_rpl_netstats.dao_tx_ucast_count++;
+    gnrc_rpl_netstats.dao_tx_ucast_bytes += len;
+    gnrc_rpl_netstats.dao_tx_targets += targets;
+    gnrc_rpl_netstats.dao_rx_ucast_count++;
+    gnrc_rpl_netstats.dao_rx_ucast_bytes += len;
+}
+
+static void _count_dao_ack(void)
+{
+    uint32_t len = sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dao_ack_t);
+
+    gnrc_rpl_netstats.dao_ack_tx_ucast_count++;
+    gnrc_rpl_netstats.dao_ack_tx_ucast_bytes += len;
+    gnrc_rpl_netstats.dao_ack_rx_ucast_count++;
+    gnrc_rpl_netstats.dao_ack_rx_ucast_bytes += len;
+}
+
+/* a DAO carries the routes of the sender and its own address */
+static void _recv_dao(unsigned child, bool aggregate)
+{
+    node_t *parent = &_nodes[_parent(child)];
+    bool changed = !parent->routes[child];
+    unsigned targets = 0;
+
+    parent->routes[child] = true;
+    for (unsigned i = 0; i < NODES; i++) {
+        if (_nodes[child].routes[i]) {
+            targets++;
+            changed |= !parent->routes[i];
+            parent->routes[i] = true;
+        }
+    }
+    _count_dao(targets);
+
+    _count_dao_ack();
+    _nodes[child].dodag.dao_ack_received = true;
+    gnrc_rpl_long_delay_dao(&_nodes[child].dodag);
+
+    if (!aggregate) {
+        _delay_dao_per_trigger(&parent->dodag);
+    }
+    else if (changed) {
+        gnrc_rpl_delay_dao(&parent->dodag);
+    }
+    else {
+        gnrc_rpl_netstats.dao_suppressed++;
+    }
+}
+
+static bool _converged(void)
+{
+    for (unsigned i = 1; i < NODES; i++) {
+        if (!_nodes[0].routes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _run(bool aggregate)
+{
+    unsigned converged = 0;
+    uint32_t converged_msgs = 0;
+
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(&gnrc_rpl_netstats, 0, sizeof(gnrc_rpl_netstats));
+    random_init(SEED);
+    for (unsigned i = 0; i < NODES; i++) {
+        /* nothing to send until the node joined the new DODAG version */
+        _nodes[i].dodag.dao_time = UINT8_MAX;
+        /* the version travels with the DIOs, which trickle sends at random times */
+        if (i > 0) {
+            _nodes[i].join = _nodes[_parent(i)].join + 1 + (random_uint32() % HOP_TICKS);
+        }
+    }
+
+    for (unsigned tick = 0; tick < TICKS; tick++) {
+        for (unsigned i = 1; i < NODES; i++) {
+            node_t *node = &_nodes[i];
+
+            /* the node changes its parent on the new version and schedules a DAO */
+            if (tick == node->join) {
+                if (aggregate) {
+                    gnrc_rpl_delay_dao(&node->dodag);
+                }
+                else {
+                    _delay_dao_per_trigger(&node->dodag);
+                }
+            }
+            /* _update_lifetime() of gnrc_rpl */
+            if (node->dodag.dao_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
+                if (node->dodag.dao_time != UINT8_MAX) {
+                    node->dodag.dao_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
+                }
+            }
+            else {
+                _dao_handle_send(node);
+            }
+        }
+        for (unsigned i = 1; i < NODES; i++) {
+            if (_nodes[i].dao_pending) {
+                _nodes[i].dao_pending = false;
+                _recv_dao(i, aggregate);
+            }
+        }
+        if ((converged == 0) && _converged()) {
+            converged = (tick + 1) * GNRC_RPL_LIFETIME_UPDATE_STEP;
+            converged_msgs = gnrc_rpl_netstats.dao_tx_ucast_count +
+                             gnrc_rpl_netstats.dao_ack_tx_ucast_count;
+        }
+    }
+
+    if (converged == 0) {
+        puts("root did not learn all routes");
+        return;
+    }
+    printf("root learned all routes after %u s and %lu messages\n", converged,
+           (unsigned long)converged_msgs);
+}
+
+static int _daosim(int argc, char **argv)
+{
+    if ((argc < 2) ||
+        ((strcmp(argv[1], "trigger") != 0) && (strcmp(argv[1], "aggregated") != 0))) {
+        printf("usage: %s <trigger|aggregated>\n", argv[0]);
+        return 1;
+    }
+    printf("NODES=%u, BRANCHES=%u, DURATION=%u, SEED=%u\n", (unsigned)NODES,
+           (unsigned)BRANCHES, (unsigned)DURATION, (unsigned)SEED);
+    _run(strcmp(argv[1], "aggregated") == 0);
+    puts("see `rpl stats` for the DAO traffic");
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "daosim", "simulate a global repair, with a DAO per trigger or "
+                "aggregated triggers", _daosim },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    puts("DAO aggregation simulation");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
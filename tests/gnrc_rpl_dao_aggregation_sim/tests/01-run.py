@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def _daos(child, variant):
+    child.sendline(u"daosim " + variant)
+    child.expect(r"root learned all routes after (\d+) s and (\d+) messages")
+    child.sendline(u"rpl stats")
+    child.expect(r"DAO     #packets:\s+(\d+) / (\d+)")
+    daos = int(child.match.group(2))
+    child.expect(r"DAO #targets sent: (\d+), #triggers aggregated: (\d+), "
+                 r"#triggers suppressed: (\d+)")
+    return daos, int(child.match.group(1))
+
+
+def testfunc(child):
+    child.expect_exact(u"DAO aggregation simulation")
+    daos, targets = _daos(child, u"trigger")
+    aggr_daos, aggr_targets = _daos(child, u"aggregated")
+    # aggregated triggers never cause more DAOs
+    assert aggr_daos <= daos
+    assert aggr_targets <= targets
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
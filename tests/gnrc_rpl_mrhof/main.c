@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the parent selection of gnrc_rpl with MRHOF
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/structs.h"
+#include "net/icmpv6.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "utlist.h"
+
+#define _TEST_PREFIX        { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }
+#define _TEST_OFFLINK       { 0x20, 0x01, 0x0d, 0xb9, 0x00, 0x00, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define _TEST_INSTANCE_ID   (GNRC_RPL_DEFAULT_INSTANCE)
+#define _TEST_ROOT          (0xff)  /**< last byte of the DODAG id */
+#define _TEST_ME            (0x01)
+#define _TEST_PARENT_A      (0x02)
+#define _TEST_PARENT_B      (0x03)
+#define _TEST_PARENT_C      (0x04)
+#define _TEST_RANK_AB       (2 * GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE)
+#define _TEST_RANK_C        (3 * GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE)
+
+#define _MSG_QUEUE_SIZE     (8U)
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_msg_queue[_MSG_QUEUE_SIZE];
+static kernel_pid_t _netif_pid = KERNEL_PID_UNDEF;
+static uint8_t _buf[64];
+
+/* stands in for the network interface, drops every packet sent to it */
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_msg_queue, _MSG_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void _addr(ipv6_addr_t *addr, bool link_local, uint8_t last)
+{
+    static const ipv6_addr_t prefix = { .u8 = _TEST_PREFIX };
+
+    *addr = (link_local) ? ipv6_addr_link_local_prefix : prefix;
+    addr->u8[15] = last;
+}
+
+static void _l2_addr(uint8_t *l2_addr, uint8_t last)
+{
+    l2_addr[0] = 0;
+    l2_addr[1] = last;
+}
+
+/* hands a DIO from src to gnrc_rpl as the IPv6 layer would */
+static void _inject_dio(uint8_t last_src, uint16_t rank)
+{
+    gnrc_pktsnip_t *icmpv6, *ipv6, *netif_hdr;
+    gnrc_rpl_dio_t dio;
+    gnrc_rpl_opt_dodag_conf_t conf;
+    ipv6_hdr_t *ipv6_hdr;
+    ipv6_addr_t src, dst;
+    uint8_t l2_src[2];
+    int res;
+
+    memset(&dio, 0, sizeof(dio));
+    dio.instance_id = _TEST_INSTANCE_ID;
+    dio.version_number = GNRC_RPL_COUNTER_INIT;
+    dio.rank = byteorder_htons(rank);
+    /* grounded flag and mode of operation */
+    dio.g_mop_prf = (GNRC_RPL_GROUNDED << 7) | (GNRC_RPL_DEFAULT_MOP << 3);
+    _addr(&dio.dodag_id, false, _TEST_ROOT);
+    memset(&conf, 0, sizeof(conf));
+    conf.type = GNRC_RPL_OPT_DODAG_CONF;
+    conf.length = GNRC_RPL_OPT_DODAG_CONF_LEN;
+    conf.dio_int_doubl = GNRC_RPL_DEFAULT_DIO_INTERVAL_DOUBLINGS;
+    conf.dio_int_min = GNRC_RPL_DEFAULT_DIO_INTERVAL_MIN;
+    conf.dio_redun = GNRC_RPL_DEFAULT_DIO_REDUNDANCY_CONSTANT;
+    conf.max_rank_inc = byteorder_htons(GNRC_RPL_DEFAULT_MAX_RANK_INCREASE);
+    conf.min_hop_rank_inc = byteorder_htons(GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE);
+    conf.ocp = byteorder_htons(GNRC_RPL_DEFAULT_OCP);
+    conf.default_lifetime = GNRC_RPL_DEFAULT_LIFETIME;
+    conf.lifetime_unit = byteorder_htons(GNRC_RPL_LIFETIME_UNIT);
+    memcpy(_buf, &dio, sizeof(dio));
+    memcpy(_buf + sizeof(dio), &conf, sizeof(conf));
+
+    _addr(&src, true, last_src);
+    _addr(&dst, true, _TEST_ME);
+    icmpv6 = gnrc_icmpv6_build(NULL, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DIO,
+                               sizeof(icmpv6_hdr_t) + sizeof(dio) + sizeof(conf));
+    assert(icmpv6 != NULL);
+    memcpy(((icmpv6_hdr_t *)icmpv6->data) + 1, _buf, sizeof(dio) + sizeof(conf));
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &src, &dst);
+    assert(ipv6 != NULL);
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons((uint16_t)icmpv6->size);
+    ipv6_hdr->nh = PROTNUM_ICMPV6;
+    LL_APPEND(icmpv6, ipv6);
+    /* the link layer source is what the TX feedback is matched with */
+    _l2_addr(l2_src, last_src);
+    netif_hdr = gnrc_netif_hdr_build(l2_src, sizeof(l2_src), NULL, 0);
+    assert(netif_hdr != NULL);
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _netif_pid;
+    LL_APPEND(icmpv6, netif_hdr);
+    /* gnrc_rpl has a higher priority, so the message is handled on return */
+    res = gnrc_netapi_dispatch_receive(GNRC_NETTYPE_ICMPV6, ICMPV6_RPL_CTRL,
+                                       icmpv6);
+    assert(res == 1);
+    (void)res;
+}
+
+/* reports frames to a parent as gnrc_netdev does with the TX feedback,
+ * gnrc_rpl has a higher priority and re-sorts the parents on return */
+static void _send_frames(uint8_t last, unsigned frames, bool acked)
+{
+    uint8_t l2_addr[2];
+
+    _l2_addr(l2_addr, last);
+    for (unsigned i = 0; i < frames; i++) {
+        gnrc_rpl_parent_etx_update(_netif_pid, l2_addr, sizeof(l2_addr), acked);
+    }
+}
+
+static gnrc_rpl_dodag_t *_dodag(void)
+{
+    gnrc_rpl_instance_t *inst = gnrc_rpl_instance_get(_TEST_INSTANCE_ID);
+
+    assert(inst != NULL);
+    return &inst->dodag;
+}
+
+static gnrc_rpl_parent_t *_parent(uint8_t last)
+{
+    gnrc_rpl_parent_t *parent;
+    ipv6_addr_t addr;
+
+    _addr(&addr, true, last);
+    LL_FOREACH(_dodag()->parents, parent) {
+        if (ipv6_addr_equal(&parent->addr, &addr)) {
+            return parent;
+        }
+    }
+    return NULL;
+}
+
+/* checks that the parents are in this order, the preferred one first */
+static bool _parents_are(uint8_t first, uint8_t second, uint8_t third)
+{
+    gnrc_rpl_parent_t *parent = _dodag()->parents;
+    const uint8_t expected[] = { first, second, third };
+
+    for (unsigned i = 0; i < sizeof(expected); i++) {
+        if ((parent == NULL) || (parent->addr.u8[15] != expected[i])) {
+            return false;
+        }
+        parent = parent->next;
+    }
+    return (parent == NULL);
+}
+
+/* checks if the FIB routes off-link destinations to the parent */
+static bool _has_default_route(uint8_t last)
+{
+    static const ipv6_addr_t dst = { .u8 = _TEST_OFFLINK };
+    ipv6_addr_t next_hop, expected;
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+    kernel_pid_t iface;
+
+    _addr(&expected, true, last);
+    if (fib_get_next_hop(&gnrc_ipv6_fib_table, &iface, next_hop.u8,
+                         &next_hop_size, &next_hop_flags, (uint8_t *)dst.u8,
+                         sizeof(dst), 0) < 0) {
+        return false;
+    }
+    return ipv6_addr_equal(&next_hop, &expected);
+}
+
+static void test_mrhof__join(void)
+{
+    gnrc_rpl_dodag_t *dodag;
+
+    _inject_dio(_TEST_PARENT_A, _TEST_RANK_AB);
+    dodag = _dodag();
+    assert(dodag->instance->of->ocp == GNRC_RPL_DEFAULT_OCP);
+    assert(_parent(_TEST_PARENT_A) != NULL);
+    assert(_parent(_TEST_PARENT_A)->l2_addr_len == 2);
+    assert(_parent(_TEST_PARENT_A)->etx == GNRC_RPL_ETX_INIT);
+    /* parent rank plus the rank increase of the initial ETX */
+    assert(dodag->my_rank == (_TEST_RANK_AB + (2 * GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE)));
+    assert(_has_default_route(_TEST_PARENT_A));
+}
+
+static void test_mrhof__parent_order(void)
+{
+    /* the parents behind the preferred one are kept in order of their path cost */
+    _inject_dio(_TEST_PARENT_C, _TEST_RANK_C);
+    _inject_dio(_TEST_PARENT_B, _TEST_RANK_AB);
+    assert(_parents_are(_TEST_PARENT_A, _TEST_PARENT_B, _TEST_PARENT_C));
+}
+
+static void test_mrhof__hysteresis(void)
+{
+    uint16_t rank = _dodag()->my_rank;
+
+    /* one sample of GNRC_RPL_ETX_MAX_TRIES lost frames */
+    _send_frames(_TEST_PARENT_A, GNRC_RPL_ETX_MAX_TRIES, false);
+    assert(_parent(_TEST_PARENT_A)->etx ==
+           ((GNRC_RPL_ETX_INIT * (GNRC_RPL_ETX_WEIGHT - 1)) +
+            (GNRC_RPL_ETX_MAX_TRIES * GNRC_RPL_ETX_DIVISOR)) / GNRC_RPL_ETX_WEIGHT);
+    /* B is better now, but not by the switch threshold */
+    assert(_parents_are(_TEST_PARENT_A, _TEST_PARENT_B, _TEST_PARENT_C));
+    assert(_dodag()->my_rank == rank);
+    assert(_has_default_route(_TEST_PARENT_A));
+}
+
+static void test_mrhof__switch(void)
+{
+    uint16_t rank = _dodag()->my_rank;
+
+    _send_frames(_TEST_PARENT_B, 32, true);
+    assert(_parent(_TEST_PARENT_B)->etx < (GNRC_RPL_ETX_DIVISOR + 4));
+    /* the parents were re-sorted without another DIO */
+    assert(_parents_are(_TEST_PARENT_B, _TEST_PARENT_A, _TEST_PARENT_C));
+    assert(_has_default_route(_TEST_PARENT_B));
+    /* the path cost moved by less than the threshold */
+    assert(_dodag()->my_rank == rank);
+}
+
+static void test_mrhof__bad_link(void)
+{
+    /* lose enough frames to B to exceed GNRC_RPL_MRHOF_MAX_LINK_METRIC */
+    _send_frames(_TEST_PARENT_B, 5 * GNRC_RPL_ETX_MAX_TRIES, false);
+    assert(_parent(_TEST_PARENT_B)->etx > (4 * GNRC_RPL_ETX_DIVISOR));
+    assert(_parents_are(_TEST_PARENT_A, _TEST_PARENT_C, _TEST_PARENT_B));
+    assert(_has_default_route(_TEST_PARENT_A));
+}
+
+int main(void)
+{
+    ipv6_addr_t addr, *res;
+
+    _netif_pid = thread_create(_netif_stack, sizeof(_netif_stack),
+                               THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                               _netif_thread, NULL, "netif");
+    gnrc_ipv6_netif_add(_netif_pid);
+    _addr(&addr, true, _TEST_ME);
+    res = gnrc_ipv6_netif_add_addr(_netif_pid, &addr, 64,
+                                   GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    assert(res != NULL);
+    _addr(&addr, false, _TEST_ME);
+    res = gnrc_ipv6_netif_add_addr(_netif_pid, &addr, 64,
+                                   GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    assert(res != NULL);
+    (void)res;
+    gnrc_rpl_init(_netif_pid);
+    assert(gnrc_rpl_pid != KERNEL_PID_UNDEF);
+
+    CALL(test_mrhof__join());
+    CALL(test_mrhof__parent_order());
+    CALL(test_mrhof__hysteresis());
+    CALL(test_mrhof__switch());
+    CALL(test_mrhof__bad_link());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
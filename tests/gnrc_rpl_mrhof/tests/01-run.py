@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_mrhof__join()")
+    child.expect_exact(u"Calling test_mrhof__parent_order()")
+    child.expect_exact(u"Calling test_mrhof__hysteresis()")
+    child.expect_exact(u"Calling test_mrhof__switch()")
+    child.expect_exact(u"Calling test_mrhof__bad_link()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Parent selection of OF0 and MRHOF in a simulated DODAG
+ *
+ * Every node is an instance of gnrc_rpl with its own interface PID, the
+ * parents are handled by the functions gnrc_rpl uses for received DIOs and
+ * for the TX feedback of the devices.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/dodag.h"
+#include "net/gnrc/rpl/of_manager.h"
+#include "net/gnrc/rpl/structs.h"
+#include "random.h"
+#include "thread.h"
+#include "trickle.h"
+
+#ifndef NODES
+#define NODES           (20)
+#endif
+
+#ifndef ROUNDS
+#define ROUNDS          (300)
+#endif
+
+#ifndef SEED
+#define SEED            (1)
+#endif
+
+#define RANGE           (3)     /**< farthest neighbor on each side */
+#define TRIES           (3)     /**< link layer transmissions per frame */
+#define NO_PARENT       (0xff)
+
+#define DODAG_ID        { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+
+typedef struct {
+    unsigned sent;
+    unsigned delivered;
+    unsigned transmissions;
+    unsigned parent_changes;
+    unsigned rank_changes;
+} stats_t;
+
+/* delivery ratio in percent of the link over a distance */
+static const uint8_t _prr[RANGE + 1] = { 100, 90, 55, 25 };
+static gnrc_rpl_instance_t *_nodes[NODES];
+
+static unsigned _dist(unsigned a, unsigned b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+static bool _in_range(unsigned a, unsigned b)
+{
+    return (a != b) && (b < NODES) && (_dist(a, b) <= RANGE);
+}
+
+static bool _received(unsigned a, unsigned b)
+{
+    return (random_uint32() % 100) < _prr[_dist(a, b)];
+}
+
+static kernel_pid_t _iface(unsigned node)
+{
+    return (kernel_pid_t)(node + 1);
+}
+
+/* the parents of a node are told apart by their DODAG, so the neighbors can
+ * have the same addresses for all nodes */
+static void _nbr_addr(unsigned nbr, ipv6_addr_t *addr, uint8_t *l2)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    memset(&addr->u8[8], 0, 8);
+    addr->u8[15] = (uint8_t)nbr;
+    l2[0] = 0;
+    l2[1] = (uint8_t)nbr;
+}
+
+static unsigned _preferred(gnrc_rpl_dodag_t *dodag)
+{
+    return (dodag->parents == NULL) ? NO_PARENT : dodag->parents->addr.u8[15];
+}
+
+static void _init(uint16_t ocp)
+{
+    ipv6_addr_t dodag_id = DODAG_ID;
+
+    for (unsigned i = 0; i < NODES; i++) {
+        _nodes[i] = NULL;
+    }
+    /* the root, the other nodes join with the first DIO they receive */
+    gnrc_rpl_instance_add(0, &_nodes[0]);
+    _nodes[0]->of = gnrc_rpl_get_of_for_ocp(ocp);
+    _nodes[0]->mop = GNRC_RPL_MOP_NO_DOWNWARD_ROUTES;
+    gnrc_rpl_dodag_init(_nodes[0], &dodag_id, _iface(0), NULL);
+    _nodes[0]->dodag.node_status = GNRC_RPL_ROOT_NODE;
+    _nodes[0]->dodag.my_rank = GNRC_RPL_ROOT_RANK;
+}
+
+static void _cleanup(void)
+{
+    for (unsigned i = 0; i < NODES; i++) {
+        if (_nodes[i] != NULL) {
+            gnrc_rpl_instance_remove(_nodes[i]);
+        }
+    }
+}
+
+/* counts the DAOs and DIO resets caused by a change of the parents */
+static void _count(gnrc_rpl_dodag_t *dodag, unsigned old_preferred,
+                   uint16_t old_rank, stats_t *stats)
+{
+    unsigned preferred = _preferred(dodag);
+    uint16_t min_hop_rank_inc = dodag->instance->min_hop_rank_inc;
+
+    if ((preferred != NO_PARENT) && (preferred != old_preferred)) {
+        stats->parent_changes++;
+    }
+    if (DAGRANK(dodag->my_rank, min_hop_rank_inc) != DAGRANK(old_rank, min_hop_rank_inc)) {
+        stats->rank_changes++;
+    }
+}
+
+/* handles a DIO like gnrc_rpl_recv_DIO() does */
+static void _recv_dio(unsigned node, unsigned nbr, uint16_t rank, uint16_t ocp,
+                      stats_t *stats)
+{
+    gnrc_rpl_instance_t *inst = _nodes[node];
+    gnrc_rpl_parent_t *parent = NULL;
+    ipv6_addr_t addr;
+    uint8_t l2[2];
+    unsigned old_preferred;
+    uint16_t old_rank;
+
+    if (inst == NULL) {
+        ipv6_addr_t dodag_id = DODAG_ID;
+
+        if (rank == GNRC_RPL_INFINITE_RANK) {
+            return;
+        }
+        gnrc_rpl_instance_add(node, &inst);
+        inst->of = gnrc_rpl_get_of_for_ocp(ocp);
+        inst->mop = GNRC_RPL_MOP_NO_DOWNWARD_ROUTES;
+        gnrc_rpl_dodag_init(inst, &dodag_id, _iface(node), NULL);
+        /* the trickle messages go to this thread and are dropped */
+        trickle_start(thread_getpid(), &inst->dodag.trickle,
+                      GNRC_RPL_MSG_TYPE_TRICKLE_INTERVAL,
+                      GNRC_RPL_MSG_TYPE_TRICKLE_CALLBACK,
+                      (1 << inst->dodag.dio_min), inst->dodag.dio_interval_doubl,
+                      inst->dodag.dio_redun);
+        _nodes[node] = inst;
+    }
+    old_preferred = _preferred(&inst->dodag);
+    old_rank = inst->dodag.my_rank;
+    _nbr_addr(nbr, &addr, l2);
+    if (!gnrc_rpl_parent_add_by_addr(&inst->dodag, &addr, &parent) && (parent == NULL)) {
+        return;
+    }
+    parent->rank = rank;
+    gnrc_rpl_parent_set_l2_addr(_iface(node), &addr, l2, sizeof(l2));
+    gnrc_rpl_parent_update(&inst->dodag, parent);
+    _count(&inst->dodag, old_preferred, old_rank, stats);
+}
+
+static void _dio_round(uint16_t ocp, stats_t *stats)
+{
+    for (unsigned i = 1; i < NODES; i++) {
+        for (unsigned j = 0; j < NODES; j++) {
+            /* nodes that left the DODAG still announce the infinite rank */
+            if (_in_range(i, j) && (_nodes[j] != NULL) && _received(j, i)) {
+                _recv_dio(i, j, _nodes[j]->dodag.my_rank, ocp, stats);
+            }
+        }
+    }
+}
+
+/* sends a frame with link layer retransmissions, the TX feedback goes to
+ * gnrc_rpl like gnrc_netdev would report it */
+static bool _send_frame(unsigned node, stats_t *stats)
+{
+    gnrc_rpl_dodag_t *dodag = &_nodes[node]->dodag;
+    gnrc_rpl_parent_t *parent = dodag->parents;
+    unsigned nbr = _preferred(dodag);
+    unsigned old_preferred = nbr;
+    uint16_t old_rank = dodag->my_rank;
+    ipv6_addr_t addr;
+    uint8_t l2[2];
+    bool acked = false;
+
+    _nbr_addr(nbr, &addr, l2);
+    for (unsigned i = 0; (i < TRIES) && !acked; i++) {
+        acked = _received(node, nbr);
+        stats->transmissions++;
+        gnrc_rpl_parent_etx_update(_iface(node), l2, sizeof(l2), acked);
+    }
+    /* what the RPL thread does on GNRC_RPL_MSG_TYPE_PARENT_ETX */
+    gnrc_rpl_parent_etx_changed(parent);
+    _count(dodag, old_preferred, old_rank, stats);
+    return acked;
+}
+
+static void _data_round(stats_t *stats)
+{
+    for (unsigned i = 1; i < NODES; i++) {
+        unsigned hop = i;
+
+        if ((_nodes[i] == NULL) || (_nodes[i]->dodag.parents == NULL)) {
+            continue;
+        }
+        stats->sent++;
+        for (unsigned hops = 0; (hop != 0) && (hops < NODES); hops++) {
+            unsigned next = _preferred(&_nodes[hop]->dodag);
+
+            if ((next == NO_PARENT) || !_send_frame(hop, stats)) {
+                break;
+            }
+            hop = next;
+        }
+        if (hop == 0) {
+            stats->delivered++;
+        }
+    }
+}
+
+static void _run(const char *name, uint16_t ocp)
+{
+    gnrc_rpl_of_t *of = gnrc_rpl_get_of_for_ocp(ocp);
+    stats_t stats;
+
+    if ((of == NULL) || (of->ocp != ocp)) {
+        printf("%s: objective function not available\n", name);
+        return;
+    }
+    memset(&stats, 0, sizeof(stats));
+    random_init(SEED);
+    _init(ocp);
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        _dio_round(ocp, &stats);
+        _data_round(&stats);
+    }
+    _cleanup();
+    if (stats.sent == 0) {
+        printf("%s: no node joined\n", name);
+        return;
+    }
+    printf("%s: %u/%u packets delivered (%u.%u %%), %u parent changes (DAOs), "
+           "%u rank changes (DIO resets), %u.%02u transmissions/packet\n", name,
+           stats.delivered, stats.sent, (stats.delivered * 100) / stats.sent,
+           ((stats.delivered * 1000) / stats.sent) % 10, stats.parent_changes,
+           stats.rank_changes, stats.transmissions / stats.sent,
+           ((stats.transmissions * 100) / stats.sent) % 100);
+}
+
+int main(void)
+{
+    gnrc_rpl_of_manager_init();
+    printf("NODES=%u, ROUNDS=%u, SEED=%u\n", (unsigned)NODES, (unsigned)ROUNDS,
+           (unsigned)SEED);
+    _run("OF0  ", 0);
+    _run("MRHOF", 1);
+    puts("Done.");
+    return 0;
+}
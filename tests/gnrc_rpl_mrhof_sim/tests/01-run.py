@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"OF0  : \d+/\d+ packets delivered")
+    child.expect(r"MRHOF: \d+/\d+ packets delivered")
+    child.expect_exact(u"Done.")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Checks the reassembly of fragmented datagrams by 6LoWPAN
+ *
+ * The fragments are handed to gnrc_sixlowpan_frag_handle_pkt() as if they
+ * were received by the 6LoWPAN thread. The reassembled datagrams are received
+ * by registering for IPv6 and compared byte by byte with the ones that were
+ * fragmented. Their first byte is no valid IP version, so the IPv6 thread
+ * drops its copy right away.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define DATAGRAM_SIZE   (232U)
+#define FRAG_SIZE       (64U)
+#define DATAGRAMS_NUMOF (RBUF_SIZE + 1)
+#define QUEUE_SIZE      (8U)
+/* RBUF_TIMEOUT of the reassembly buffer */
+#define GC_TIMEOUT      (3U * US_PER_SEC)
+/* time the garbage collection may take longer than GC_TIMEOUT */
+#define GC_MARGIN       (100U * US_PER_MS)
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+typedef struct {
+    uint8_t src;                    /* last byte of the source address */
+    uint16_t tag;
+    uint16_t size;
+    uint8_t data[DATAGRAM_SIZE];
+} _datagram_t;
+
+static uint8_t _dst_l2addr[] = { 0x02, 0x01 };
+/* they share source, tag or size, but no two of them are the same datagram */
+static const _datagram_t _params[DATAGRAMS_NUMOF] = {
+    { .src = 2, .tag = 1, .size = DATAGRAM_SIZE },
+    { .src = 2, .tag = 2, .size = DATAGRAM_SIZE },
+    { .src = 3, .tag = 1, .size = DATAGRAM_SIZE },
+    { .src = 2, .tag = 1, .size = DATAGRAM_SIZE - 8 },
+    { .src = 4, .tag = 1, .size = DATAGRAM_SIZE - 8 },
+};
+
+static _datagram_t _datagrams[DATAGRAMS_NUMOF];
+static uint8_t _garbage[DATAGRAM_SIZE];
+static msg_t _main_queue[QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_reg;
+
+static unsigned _frags_numof(const _datagram_t *dg)
+{
+    return (dg->size + FRAG_SIZE - 1) / FRAG_SIZE;
+}
+
+/* hands the len bytes of data at offset to 6LoWPAN as a fragment of dg */
+static void _recv_data(const _datagram_t *dg, const uint8_t *data,
+                       unsigned offset, size_t len)
+{
+    uint8_t src_l2addr[] = { 0x02, dg->src };
+    /* data of the first fragment follow the dispatch of the uncompressed
+     * IPv6 header */
+    size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1)
+                                   : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_n_t *frag;
+
+    netif = gnrc_netif_hdr_build(src_l2addr, sizeof(src_l2addr),
+                                 _dst_l2addr, sizeof(_dst_l2addr));
+    assert(netif != NULL);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = thread_getpid();
+    pkt = gnrc_pktbuf_add(netif, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    assert(pkt != NULL);
+    frag = pkt->data;
+    frag->disp_size = byteorder_htons(dg->size);
+    frag->tag = byteorder_htons(dg->tag);
+    if (offset == 0) {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        ((uint8_t *)pkt->data)[hdr_len - 1] = SIXLOWPAN_UNCOMP;
+    }
+    else {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        frag->offset = offset / 8;
+    }
+    memcpy(((uint8_t *)pkt->data) + hdr_len, data + offset, len);
+    gnrc_sixlowpan_frag_handle_pkt(pkt);
+}
+
+/* hands fragment num of dg to 6LoWPAN */
+static void _recv(const _datagram_t *dg, unsigned num)
+{
+    unsigned offset = num * FRAG_SIZE;
+    size_t len = dg->size - offset;
+
+    _recv_data(dg, dg->data, offset, (len < FRAG_SIZE) ? len : FRAG_SIZE);
+}
+
+/* returns the next datagram reassembled so far, garbage collection messages
+ * before it are handled like the 6LoWPAN thread would */
+static gnrc_pktsnip_t *_delivered(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            return msg.content.ptr;
+        }
+        assert(msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF);
+        gnrc_sixlowpan_frag_gc_rbuf();
+    }
+    return NULL;
+}
+
+/* handles the garbage collection messages for duration microseconds */
+static void _wait(uint32_t duration)
+{
+    uint32_t end = xtimer_now_usec() + duration;
+    msg_t msg;
+
+    while ((int32_t)(end - xtimer_now_usec()) > 0) {
+        if (xtimer_msg_receive_timeout(&msg, end - xtimer_now_usec()) < 0) {
+            break;
+        }
+        assert(msg.type == GNRC_SIXLOWPAN_MSG_FRAG_GC_RBUF);
+        gnrc_sixlowpan_frag_gc_rbuf();
+    }
+}
+
+static void _expect_none(void)
+{
+    /* a reassembled datagram is dispatched before handle_pkt returns */
+    assert(_delivered() == NULL);
+}
+
+static void _expect(const _datagram_t *dg)
+{
+    gnrc_pktsnip_t *pkt = _delivered();
+    gnrc_netif_hdr_t *netif_hdr;
+
+    assert(pkt != NULL);
+    assert(pkt->type == GNRC_NETTYPE_IPV6);
+    assert(pkt->size == dg->size);
+    assert(memcmp(pkt->data, dg->data, dg->size) == 0);
+    assert((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_NETIF));
+    netif_hdr = pkt->next->data;
+    assert(netif_hdr->src_l2addr_len == 2);
+    assert(gnrc_netif_hdr_get_src_addr(netif_hdr)[1] == dg->src);
+    gnrc_pktbuf_release(pkt);
+    /* every datagram is delivered once */
+    _expect_none();
+}
+
+static void test_rbuf__in_order(void)
+{
+    const _datagram_t *dg = &_datagrams[0];
+
+    for (unsigned i = 0; i < _frags_numof(dg); i++) {
+        _expect_none();
+        _recv(dg, i);
+    }
+    _expect(dg);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__out_of_order(void)
+{
+    static const unsigned order[] = { 3, 1, 0, 2 };
+    const _datagram_t *dg = &_datagrams[0];
+
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        _expect_none();
+        _recv(dg, order[i]);
+    }
+    _expect(dg);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__duplicate(void)
+{
+    /* the size of the first five fragments exceeds the datagram size */
+    static const unsigned order[] = { 0, 1, 1, 2, 0, 3 };
+    const _datagram_t *dg = &_datagrams[0];
+
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        _expect_none();
+        _recv(dg, order[i]);
+    }
+    _expect(dg);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__overlap(void)
+{
+    const _datagram_t *dg = &_datagrams[0];
+
+    _recv(dg, 0);
+    _recv(dg, 1);
+    /* overlaps both fragments, so the datagram is discarded and reassembled
+     * anew starting with this fragment */
+    _recv_data(dg, _garbage, FRAG_SIZE - 8, FRAG_SIZE);
+    _recv(dg, 2);
+    _recv(dg, 3);
+    _expect_none();
+    /* overlaps the garbage partially */
+    _recv(dg, 1);
+    /* only covers received parts, but starts at another offset */
+    _recv_data(dg, _garbage, FRAG_SIZE + 8, FRAG_SIZE - 8);
+    _recv(dg, 0);
+    _recv(dg, 2);
+    _recv(dg, 3);
+    _expect_none();
+    _recv(dg, 1);
+    _recv(dg, 0);
+    _recv(dg, 2);
+    _expect_none();
+    _recv(dg, 3);
+    _expect(dg);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__bucket_collisions(void)
+{
+    unsigned frags = _frags_numof(&_datagrams[0]);
+
+    /* the fragments of all datagrams that fit into the buffer interleaved,
+     * in reverse order */
+    for (unsigned i = 0; i < frags; i++) {
+        for (unsigned j = 0; j < RBUF_SIZE; j++) {
+            /* change the order of the datagrams every round */
+            const _datagram_t *dg = &_datagrams[(i & 1) ? (RBUF_SIZE - 1 - j) : j];
+
+            _recv(dg, frags - 1 - i);
+            if (i == (frags - 1)) {
+                _expect(dg);
+            }
+            else {
+                _expect_none();
+            }
+        }
+    }
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__full(void)
+{
+    const _datagram_t *dropped = &_datagrams[0];
+
+    /* the entry of the datagram received least recently makes room for
+     * the last one */
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        _recv(&_datagrams[i], 0);
+    }
+    for (unsigned i = 1; i < DATAGRAMS_NUMOF; i++) {
+        const _datagram_t *dg = &_datagrams[i];
+
+        for (unsigned j = 1; j < _frags_numof(dg); j++) {
+            _recv(dg, j);
+        }
+        _expect(dg);
+    }
+    for (unsigned j = 1; j < _frags_numof(dropped); j++) {
+        _recv(dropped, j);
+    }
+    _expect_none();
+    /* the incomplete datagram is left to the garbage collection */
+    assert(!gnrc_pktbuf_is_empty());
+    _wait(GC_TIMEOUT + GC_MARGIN);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf__gc_timer(void)
+{
+    const _datagram_t *refreshed = &_datagrams[0], *timed_out = &_datagrams[1];
+
+    _recv(refreshed, 0);
+    _recv(timed_out, 0);
+    xtimer_usleep(GC_TIMEOUT - US_PER_SEC);
+    _recv(refreshed, 1);
+    /* the timer set for the first fragments expires meanwhile, but only
+     * one of the entries timed out by then */
+    _wait(2 * US_PER_SEC);
+    for (unsigned i = 1; i < _frags_numof(timed_out); i++) {
+        _recv(timed_out, i);
+    }
+    _expect_none();
+    _recv(refreshed, 2);
+    _recv(refreshed, 3);
+    _expect(refreshed);
+    /* the timer was set again for the rest of the timed out datagram */
+    _wait(GC_TIMEOUT + GC_MARGIN);
+    assert(gnrc_pktbuf_is_empty());
+}
+
+int main(void)
+{
+    msg_init_queue(_main_queue, QUEUE_SIZE);
+    for (unsigned i = 0; i < DATAGRAMS_NUMOF; i++) {
+        _datagrams[i] = _params[i];
+        for (unsigned j = 0; j < _datagrams[i].size; j++) {
+            _datagrams[i].data[j] = (uint8_t)((j * 7) + i);
+        }
+    }
+    memset(_garbage, 0xff, sizeof(_garbage));
+    _ipv6_reg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    _ipv6_reg.target.pid = thread_getpid();
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+
+    CALL(test_rbuf__in_order());
+    CALL(test_rbuf__out_of_order());
+    CALL(test_rbuf__duplicate());
+    CALL(test_rbuf__overlap());
+    CALL(test_rbuf__bucket_collisions());
+    CALL(test_rbuf__full());
+    CALL(test_rbuf__gc_timer());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
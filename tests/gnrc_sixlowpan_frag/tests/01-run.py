@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_rbuf__in_order()")
+    child.expect_exact(u"Calling test_rbuf__out_of_order()")
+    child.expect_exact(u"Calling test_rbuf__duplicate()")
+    child.expect_exact(u"Calling test_rbuf__overlap()")
+    child.expect_exact(u"Calling test_rbuf__bucket_collisions()")
+    child.expect_exact(u"Calling test_rbuf__full()")
+    child.expect_exact(u"Calling test_rbuf__gc_timer()", timeout=10)
+    child.expect_exact(u"ALL TESTS SUCCESSFUL", timeout=10)
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
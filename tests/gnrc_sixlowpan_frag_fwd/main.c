@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Checks that a 6LoWPAN router forwards every fragment of a
+ *              datagram once, whatever order the fragments arrive in
+ *
+ * The fragments are handed to gnrc_sixlowpan_frag_handle_pkt() as if they
+ * were received by the 6LoWPAN thread. A route leads their destination to a
+ * dummy 6LoWPAN interface that records the fragments sent to it.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+
+#define DATAGRAM_SIZE   (232U)
+/* bytes of the uncompressed datagram in each fragment */
+#define FRAG_SIZE       (64U)
+#define FRAGS_NUMOF     ((DATAGRAM_SIZE + FRAG_SIZE - 1) / FRAG_SIZE)
+#define MAX_FRAG_SIZE   (102U)
+#define FRAMES_NUMOF    (2 * FRAGS_NUMOF)
+#define HOP_LIMIT       (64U)
+#define PREFIX_LEN      (64U)
+#define QUEUE_SIZE      (8U)
+
+#define SRC_ADDR        { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+#define DST_ADDR        { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+#define NEXT_HOP_ADDR   { { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03 } }
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+typedef struct {
+    size_t len;
+    uint8_t data[MAX_FRAG_SIZE];
+} _frame_t;
+
+static uint8_t _src_l2addr[] = { 0x02, 0x02 };
+static uint8_t _dst_l2addr[] = { 0x02, 0x01 };
+static uint8_t _next_hop_l2addr[] = { 0x02, 0x03 };
+
+static uint8_t _datagram[DATAGRAM_SIZE];
+/* IPHC header of the datagram with everything inline but the traffic class
+ * and flow label */
+static uint8_t _iphc[2 + 2 + 2 * sizeof(ipv6_addr_t)] = {
+    0x78, 0x00, PROTNUM_IPV6_NONXT, HOP_LIMIT
+};
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _netif_queue[QUEUE_SIZE];
+static msg_t _main_queue[QUEUE_SIZE];
+static _frame_t _frames[FRAMES_NUMOF];
+static unsigned _frames_numof;
+
+/* stands in for the 6LoWPAN interface to the next hop and records the
+ * fragments sent over it */
+static void *_netif_thread(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_netif_queue, QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+                /* neighbor discovery may send as well */
+                if ((pkt->next != NULL) &&
+                    (pkt->next->type == GNRC_NETTYPE_SIXLOWPAN) &&
+                    sixlowpan_frag_is(pkt->next->data)) {
+                    _frame_t *frame = &_frames[_frames_numof++];
+
+                    assert(_frames_numof <= FRAMES_NUMOF);
+                    frame->len = 0;
+                    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL;
+                         snip = snip->next) {
+                        assert((frame->len + snip->size) <= MAX_FRAG_SIZE);
+                        memcpy(frame->data + frame->len, snip->data, snip->size);
+                        frame->len += snip->size;
+                    }
+                }
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void _init(void)
+{
+    ipv6_hdr_t *hdr = (ipv6_hdr_t *)_datagram;
+    ipv6_addr_t src = SRC_ADDR, dst = DST_ADDR, next_hop = NEXT_HOP_ADDR;
+    kernel_pid_t pid;
+
+    for (unsigned i = sizeof(ipv6_hdr_t); i < DATAGRAM_SIZE; i++) {
+        _datagram[i] = (uint8_t)(i * 7);
+    }
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(DATAGRAM_SIZE - sizeof(ipv6_hdr_t));
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = HOP_LIMIT;
+    hdr->src = src;
+    hdr->dst = dst;
+    memcpy(&_iphc[4], &src, sizeof(src));
+    memcpy(&_iphc[4 + sizeof(src)], &dst, sizeof(dst));
+
+    pid = thread_create(_netif_stack, sizeof(_netif_stack),
+                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                        _netif_thread, NULL, "6lo netif");
+    gnrc_ipv6_netif_add(pid);
+    gnrc_sixlowpan_netif_add(pid, MAX_FRAG_SIZE);
+    gnrc_ipv6_nc_add(pid, &next_hop, _next_hop_l2addr,
+                     sizeof(_next_hop_l2addr), GNRC_IPV6_NC_STATE_REACHABLE);
+    fib_add_entry(&gnrc_ipv6_fib_table, pid, dst.u8, sizeof(ipv6_addr_t),
+                  (PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT),
+                  next_hop.u8, sizeof(ipv6_addr_t), 0,
+                  (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+/* hands fragment num of the datagram to 6LoWPAN as if it was received */
+static void _recv(uint16_t tag, unsigned num)
+{
+    unsigned offset = num * FRAG_SIZE;
+    size_t len = DATAGRAM_SIZE - offset, hdr_len = sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_frag_n_t *frag;
+
+    if (len > FRAG_SIZE) {
+        len = FRAG_SIZE;
+    }
+    if (num == 0) {
+        /* the IPv6 header is compressed */
+        hdr_len = sizeof(sixlowpan_frag_t) + sizeof(_iphc);
+        offset += sizeof(ipv6_hdr_t);
+        len -= sizeof(ipv6_hdr_t);
+    }
+    netif = gnrc_netif_hdr_build(_src_l2addr, sizeof(_src_l2addr),
+                                 _dst_l2addr, sizeof(_dst_l2addr));
+    assert(netif != NULL);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = thread_getpid();
+    pkt = gnrc_pktbuf_add(netif, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    assert(pkt != NULL);
+    frag = pkt->data;
+    frag->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    frag->tag = byteorder_htons(tag);
+    if (num == 0) {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        memcpy(((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t), _iphc,
+               sizeof(_iphc));
+    }
+    else {
+        frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        frag->offset = offset / 8;
+    }
+    memcpy(((uint8_t *)pkt->data) + hdr_len, _datagram + offset, len);
+    gnrc_sixlowpan_frag_handle_pkt(pkt);
+}
+
+/* checks that each fragment was forwarded once, the first one first */
+static void _check_forwarded(void)
+{
+    sixlowpan_frag_t *first = (sixlowpan_frag_t *)_frames[0].data;
+    const size_t first_payload = FRAG_SIZE - sizeof(ipv6_hdr_t);
+    unsigned forwarded = 1;
+
+    assert(_frames_numof == FRAGS_NUMOF);
+    assert((first->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+           SIXLOWPAN_FRAG_1_DISP);
+    assert((byteorder_ntohs(first->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK) ==
+           DATAGRAM_SIZE);
+    /* the header was compressed anew, but the payload stays the same */
+    assert(memcmp(_frames[0].data + _frames[0].len - first_payload,
+                  _datagram + sizeof(ipv6_hdr_t), first_payload) == 0);
+    for (unsigned i = 1; i < _frames_numof; i++) {
+        sixlowpan_frag_n_t *frag = (sixlowpan_frag_n_t *)_frames[i].data;
+        unsigned offset = frag->offset * 8U;
+        size_t len = _frames[i].len - sizeof(sixlowpan_frag_n_t);
+
+        assert((frag->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+               SIXLOWPAN_FRAG_N_DISP);
+        assert((byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK) ==
+               DATAGRAM_SIZE);
+        assert(frag->tag.u16 == first->tag.u16);
+        assert((offset % FRAG_SIZE) == 0);
+        assert(!(forwarded & (1U << (offset / FRAG_SIZE))));
+        forwarded |= (1U << (offset / FRAG_SIZE));
+        assert(memcmp(frag + 1, _datagram + offset, len) == 0);
+    }
+    assert(forwarded == ((1U << FRAGS_NUMOF) - 1));
+    _frames_numof = 0;
+    /* nothing was left in the reassembly buffer */
+    assert(gnrc_pktbuf_is_empty());
+}
+
+static void test_fwd__in_order(void)
+{
+    for (unsigned i = 0; i < FRAGS_NUMOF; i++) {
+        _recv(1, i);
+    }
+    _check_forwarded();
+}
+
+static void test_fwd__out_of_order(void)
+{
+    /* the adjacent fragments before the first one are forwarded with it,
+     * but still as two fragments */
+    static const unsigned order[] = { 2, 1, 0, 3 };
+
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        _recv(2, order[i]);
+    }
+    _check_forwarded();
+}
+
+static void test_fwd__duplicate(void)
+{
+    /* the size of the first five fragments exceeds the datagram size */
+    static const unsigned order[] = { 0, 1, 1, 2, 0, 3 };
+
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        _recv(3, order[i]);
+    }
+    _check_forwarded();
+}
+
+int main(void)
+{
+    /* for the garbage collection of the reassembly buffer */
+    msg_init_queue(_main_queue, QUEUE_SIZE);
+    _init();
+
+    CALL(test_fwd__in_order());
+    CALL(test_fwd__out_of_order());
+    CALL(test_fwd__duplicate());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
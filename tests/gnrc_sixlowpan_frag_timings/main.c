@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the fragmentation of 1280 byte datagrams by 6LoWPAN
+ *
+ * The datagrams are sent uncompressed to a dummy interface that drops all
+ * fragments. The fast interface runs at a higher priority than 6LoWPAN and
+ * takes every fragment right away, the busy one runs at a lower priority, so
+ * its message queue fills up like the one of an interface that waits for the
+ * medium.
+ * Datagrams held by nobody but 6LoWPAN are fragmented by moving their snips
+ * into the fragments, datagrams that are also held by the application are
+ * fragmented by copying. The packet buffer statistics after each run show
+ * the peak usage.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/ipv6/hdr.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define DATAGRAMS       (100U)
+#define DATAGRAM_SIZE   (1280U)
+#define DATAGRAM_TIMEOUT (100U * US_PER_MS)
+#define MAX_FRAG_SIZE   (102U)
+#define IF_QUEUE_SIZE   (8U)
+#define MAIN_QUEUE_SIZE (4U)
+#define MSG_TYPE_DONE   (0x5e11)
+
+static char _if_stacks[2][THREAD_STACKSIZE_DEFAULT];
+static msg_t _if_queues[2][IF_QUEUE_SIZE];
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static kernel_pid_t _main_pid;
+static unsigned _frags;
+static size_t _bytes;
+
+/* checks if frag is the last fragment of its datagram */
+static bool _is_last(gnrc_pktsnip_t *frag)
+{
+    sixlowpan_frag_n_t *hdr = frag->data;
+    size_t datagram_size = byteorder_ntohs(hdr->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+
+    if ((hdr->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) != SIXLOWPAN_FRAG_N_DISP) {
+        return false;
+    }
+    return ((hdr->offset * 8U) + gnrc_pkt_len(frag) - sizeof(*hdr)) >= datagram_size;
+}
+
+static void *_if_thread(void *arg)
+{
+    msg_t msg, reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK,
+                         .content = { .value = -ENOTSUP } };
+
+    msg_init_queue(arg, IF_QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                msg_t done = { .type = MSG_TYPE_DONE };
+
+                _frags++;
+                _bytes += gnrc_pkt_len(pkt->next);
+                if (_is_last(pkt->next)) {
+                    msg_try_send(&done, _main_pid);
+                }
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_build_datagram(kernel_pid_t if_pid)
+{
+    static const uint8_t l2addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                      0xfe, 0x00, 0x00, 0x01 };
+    ipv6_addr_t src = { .u8 = { 0xfe, 0x80, [15] = 0x02 } };
+    ipv6_addr_t dst = { .u8 = { 0xfe, 0x80, [15] = 0x01 } };
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, DATAGRAM_SIZE - sizeof(ipv6_hdr_t),
+                              GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memset(payload->data, 0xab, payload->size);
+    ipv6 = gnrc_ipv6_hdr_build(payload, &src, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ((ipv6_hdr_t *)ipv6->data)->len = byteorder_htons(payload->size);
+    ((ipv6_hdr_t *)ipv6->data)->nh = PROTNUM_IPV6_NONXT;
+    netif = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)l2addr, sizeof(l2addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = if_pid;
+    LL_PREPEND(ipv6, netif);
+    return ipv6;
+}
+
+static int _measure(const char *name, kernel_pid_t if_pid, bool shared)
+{
+    uint32_t start, time = 0;
+    unsigned complete = 0;
+
+    _frags = 0;
+    _bytes = 0;
+    for (unsigned i = 0; i < DATAGRAMS; i++) {
+        gnrc_pktsnip_t *pkt = _build_datagram(if_pid);
+        msg_t msg;
+
+        if (pkt == NULL) {
+            puts("error: packet buffer full");
+            return 1;
+        }
+        if (shared) {
+            gnrc_pktbuf_hold(pkt, 1);
+        }
+        start = xtimer_now_usec();
+        if (gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+            puts("error: 6LoWPAN not found");
+            return 1;
+        }
+        /* wait for the last fragment to arrive at the interface */
+        if (xtimer_msg_receive_timeout(&msg, DATAGRAM_TIMEOUT) >= 0) {
+            time += xtimer_now_usec() - start;
+            complete++;
+        }
+        if (shared) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    printf("+ %s: %u/%u datagrams in %u fragments (%u bytes) in %lu us\n",
+           name, complete, DATAGRAMS, _frags, (unsigned)_bytes,
+           (unsigned long)time);
+    gnrc_pktbuf_stats();
+    return 0;
+}
+
+int main(void)
+{
+    kernel_pid_t fast_if, busy_if;
+
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    _main_pid = thread_getpid();
+
+    puts("Start.");
+
+    fast_if = thread_create(_if_stacks[0], sizeof(_if_stacks[0]),
+                            GNRC_SIXLOWPAN_PRIO - 1, THREAD_CREATE_STACKTEST,
+                            _if_thread, _if_queues[0], "fast_if");
+    gnrc_sixlowpan_netif_add(fast_if, MAX_FRAG_SIZE);
+    busy_if = thread_create(_if_stacks[1], sizeof(_if_stacks[1]),
+                            GNRC_SIXLOWPAN_PRIO + 1, THREAD_CREATE_STACKTEST,
+                            _if_thread, _if_queues[1], "busy_if");
+    gnrc_sixlowpan_netif_add(busy_if, MAX_FRAG_SIZE);
+
+    /* the peak usage is never reset, so measure the smaller one first */
+    if (_measure("moved", fast_if, false) ||
+        _measure("copied", fast_if, true) ||
+        _measure("moved, busy interface", busy_if, false)) {
+        return 1;
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for the asynchronous sock API
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/udp.h"
+#include "net/inet_csum.h"
+#include "net/protnum.h"
+#include "net/sock/async.h"
+#include "net/sock/udp.h"
+#include "thread_flags.h"
+#include "utlist.h"
+
+#define _TEST_ADDR_LOCAL    { 0x7f, 0xc4, 0x11, 0x5a, 0xe6, 0x91, 0x8d, 0x5d, \
+                              0x8c, 0xd1, 0x47, 0x07, 0xb7, 0x6f, 0x9b, 0x48 }
+#define _TEST_ADDR_REMOTE   { 0xe8, 0xb3, 0xb2, 0xe6, 0x70, 0xd4, 0x55, 0xba, \
+                              0x93, 0xcf, 0x11, 0xe1, 0x72, 0x44, 0xab, 0x9e }
+#define _TEST_PORT_LOCAL    (0x2c94)
+#define _TEST_PORT_REMOTE   (0xa615)
+#define _TEST_NETIF         (31)
+
+#define _SOCK_NUMOF         (2U)
+
+static uint8_t _test_buffer[16];
+static sock_udp_t _socks[_SOCK_NUMOF];
+static sock_async_loop_t _loop;
+static unsigned _recvd[_SOCK_NUMOF];
+static unsigned _calls[_SOCK_NUMOF];
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < _SOCK_NUMOF; i++) {
+        sock_udp_close(&_socks[i]);
+        _recvd[i] = 0;
+        _calls[i] = 0;
+    }
+    /* drop a wakeup the tests did not wait for */
+    thread_flags_clear(SOCK_ASYNC_THREAD_FLAG);
+}
+
+static bool _inject_packet(uint16_t dst_port, void *data, size_t data_len)
+{
+    static const ipv6_addr_t src = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst = { .u8 = _TEST_ADDR_LOCAL };
+    gnrc_pktsnip_t *netif_hdr, *ipv6, *udp;
+    udp_hdr_t *udp_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+    uint16_t csum = 0;
+
+    udp = gnrc_pktbuf_add(NULL, NULL, sizeof(udp_hdr_t) + data_len,
+                          GNRC_NETTYPE_UNDEF);
+    if (udp == NULL) {
+        return false;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(_TEST_PORT_REMOTE);
+    udp_hdr->dst_port = byteorder_htons(dst_port);
+    udp_hdr->length = byteorder_htons((uint16_t)udp->size);
+    udp_hdr->checksum.u16 = 0;
+    memcpy(udp_hdr + 1, data, data_len);
+    csum = inet_csum(csum, (uint8_t *)udp->data, udp->size);
+    ipv6 = gnrc_ipv6_hdr_build(NULL, &src, &dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons((uint16_t)udp->size);
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    csum = ipv6_hdr_inet_csum(csum, ipv6_hdr, PROTNUM_UDP, (uint16_t)udp->size);
+    udp_hdr->checksum = byteorder_htons((csum == 0xffff) ? csum : ~csum);
+    LL_APPEND(udp, ipv6);
+    netif_hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif_hdr == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = _TEST_NETIF;
+    LL_APPEND(udp, netif_hdr);
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP,
+                                         GNRC_NETREG_DEMUX_CTX_ALL, udp) > 0);
+}
+
+static void _create_socks(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+
+    for (unsigned i = 0; i < _SOCK_NUMOF; i++) {
+        local.port = _TEST_PORT_LOCAL + i;
+        assert(0 == sock_udp_create(&_socks[i], &local, NULL,
+                                    SOCK_FLAGS_REUSE_EP));
+    }
+}
+
+static unsigned _idx(sock_udp_t *sock)
+{
+    assert((sock >= _socks) && (sock < &_socks[_SOCK_NUMOF]));
+    return (unsigned)(sock - _socks);
+}
+
+/* receives everything that is waiting */
+static void _drain(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    unsigned i = _idx(sock);
+
+    assert(flags & SOCK_ASYNC_MSG_RECV);
+    assert(arg == &_loop);
+    _calls[i]++;
+    while (sock_udp_recv(sock, _test_buffer, sizeof(_test_buffer), 0,
+                         NULL) > 0) {
+        _recvd[i]++;
+    }
+}
+
+/* receives only one message per call */
+static void _one(sock_udp_t *sock, sock_async_flags_t flags, void *arg)
+{
+    unsigned i = _idx(sock);
+
+    (void)flags;
+    (void)arg;
+    _calls[i]++;
+    if (sock_udp_recv(sock, _test_buffer, sizeof(_test_buffer), 0, NULL) > 0) {
+        _recvd[i]++;
+    }
+}
+
+static void test_sock_async__many_socks(void)
+{
+    _create_socks();
+    for (unsigned i = 0; i < _SOCK_NUMOF; i++) {
+        sock_udp_set_cb(&_socks[i], &_loop, _drain, &_loop);
+    }
+    assert(0 == sock_async_loop_dispatch(&_loop));
+    assert(_inject_packet(_TEST_PORT_LOCAL, "ABCD", sizeof("ABCD")));
+    assert(_inject_packet(_TEST_PORT_LOCAL, "EFGH", sizeof("EFGH")));
+    assert(_inject_packet(_TEST_PORT_LOCAL + 1, "IJKL", sizeof("IJKL")));
+    thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG);
+    assert(_SOCK_NUMOF == sock_async_loop_dispatch(&_loop));
+    assert((1 == _calls[0]) && (2 == _recvd[0]));
+    assert((1 == _calls[1]) && (1 == _recvd[1]));
+    assert(0 == sock_async_loop_dispatch(&_loop));
+    assert(gnrc_pktbuf_is_sane());
+}
+
+static void test_sock_async__data_before_cb(void)
+{
+    _create_socks();
+    assert(_inject_packet(_TEST_PORT_LOCAL + 1, "ABCD", sizeof("ABCD")));
+    assert(0 == sock_async_loop_dispatch(&_loop));
+    sock_udp_set_cb(&_socks[1], &_loop, _drain, &_loop);
+    assert(SOCK_ASYNC_THREAD_FLAG ==
+           thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG));
+    assert(1 == sock_async_loop_dispatch(&_loop));
+    assert((1 == _calls[1]) && (1 == _recvd[1]));
+}
+
+static void test_sock_async__undrained(void)
+{
+    _create_socks();
+    sock_udp_set_cb(&_socks[0], &_loop, _one, NULL);
+    sock_udp_set_cb(&_socks[1], &_loop, _one, NULL);
+    assert(_inject_packet(_TEST_PORT_LOCAL, "ABCD", sizeof("ABCD")));
+    assert(_inject_packet(_TEST_PORT_LOCAL, "EFGH", sizeof("EFGH")));
+    assert(_inject_packet(_TEST_PORT_LOCAL + 1, "IJKL", sizeof("IJKL")));
+    thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG);
+    /* every ready sock is called once per round */
+    assert(2 == sock_async_loop_dispatch(&_loop));
+    assert((1 == _recvd[0]) && (1 == _recvd[1]));
+    thread_flags_wait_any(SOCK_ASYNC_THREAD_FLAG);
+    assert(1 == sock_async_loop_dispatch(&_loop));
+    assert((2 == _calls[0]) && (2 == _recvd[0]));
+    assert(0 == sock_async_loop_dispatch(&_loop));
+}
+
+static void test_sock_async__close(void)
+{
+    _create_socks();
+    sock_udp_set_cb(&_socks[0], &_loop, _drain, &_loop);
+    assert(_inject_packet(_TEST_PORT_LOCAL, "ABCD", sizeof("ABCD")));
+    assert(sizeof("ABCD") == sock_udp_recv(&_socks[0], _test_buffer,
+                                           sizeof(_test_buffer), 0, NULL));
+    sock_udp_close(&_socks[0]);
+    assert(0 == sock_async_loop_dispatch(&_loop));
+    assert(0 == _calls[0]);
+}
+
+int main(void)
+{
+    sock_async_loop_init(&_loop);
+    CALL(test_sock_async__many_socks());
+    CALL(test_sock_async__data_before_cb());
+    CALL(test_sock_async__undrained());
+    CALL(test_sock_async__close());
+    assert(gnrc_pktbuf_is_sane());
+    assert(gnrc_pktbuf_is_empty());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
@@ -379,6 +379,67 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_many__non_blocking(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result[2];
+    sock_udp_msg_t msgs[3] = {
+        { .data = _test_buffer, .len = 8, .remote = &result[0] },
+        { .data = &_test_buffer[8], .len = 8, .remote = &result[1] },
+        { .data = &_test_buffer[16], .len = 8, .remote = NULL },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-EAGAIN == sock_udp_recv_many(&_sock, msgs, 3, 0));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    assert(2 == sock_udp_recv_many(&_sock, msgs, 3, 0));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(memcmp(msgs[0].data, "ABCD", sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == result[0].port);
+    assert(sizeof("EFG") == msgs[1].len);
+    assert(memcmp(msgs[1].data, "EFG", sizeof("EFG")) == 0);
+    assert(_TEST_PORT_REMOTE + 1 == result[1].port);
+    assert(AF_INET6 == result[1].family);
+    assert(memcmp(&result[1].addr, &src_addr, sizeof(result[1].addr)) == 0);
+    assert(_TEST_NETIF == result[1].netif);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_buf__non_blocking(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-EAGAIN == sock_udp_recv_buf(&_sock, &data, &ctx, 0, &result));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx, 0,
+                                               &result));
+    assert((data != NULL) && (ctx != NULL));
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    assert(!_check_net());  /* data is still held */
+    sock_udp_recv_buf_free(ctx);
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -651,6 +712,36 @@ static void test_sock_udp_send__no_sock(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_send_many__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                    .family = AF_INET6,
+                                    .port = _TEST_PORT_REMOTE + 1 };
+    const sock_udp_msg_t msgs[] = {
+        { .data = "ABCD", .len = sizeof("ABCD"), .remote = NULL },
+        { .data = "EFG", .len = sizeof("EFG"), .remote = &remote },
+        { .data = "HI", .len = sizeof("HI"), .remote = &remote },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(-ENOTCONN == sock_udp_send_many(&_sock, msgs, 3));
+    assert(2 == sock_udp_send_many(&_sock, &msgs[1], 2));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "EFG", sizeof("EFG"),
+                         _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "HI", sizeof("HI"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 int main(void)
 {
     _net_init();
@@ -680,6 +771,8 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_many__non_blocking());
+    CALL(test_sock_udp_recv_buf__non_blocking());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -697,6 +790,7 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_send_many__socketed());
 
     puts("ALL TESTS SUCCESSFUL");
 
@@ -12,6 +12,7 @@
 #include "net/af.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/tcp.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -61,6 +62,7 @@ void *cli_thread(void *arg)
     uint32_t cycles = 0;
     uint32_t cycles_ok = 0;
     uint32_t failed_payload_verifications = 0;
+    uint32_t start = 0;
 
     /* Transmission Control Block */
     gnrc_tcp_tcb_t tcb;
@@ -121,6 +123,9 @@ void *cli_thread(void *arg)
                 return 0;
         }
 
+        /* Measure the time needed to exchange data and close the connection */
+        start = xtimer_now_usec();
+
         /* Fill Buffer with a test pattern */
         for (size_t i = 0; i < sizeof(bufs[tid]); ++i){
             bufs[tid][i] = TEST_PATERN_CLI;
@@ -207,6 +212,14 @@ void *cli_thread(void *arg)
         /* Close Connection */
         gnrc_tcp_close(&tcb);
 
+        /* Print throughput of this cycle, both directions combined */
+        uint32_t duration = xtimer_now_usec() - start;
+        if (ret >= 0 && duration > 0) {
+            printf("TID=%d : %d bytes exchanged in %"PRIu32" us: %"PRIu32" bytes/s\n",
+                   tid, 2 * NBYTE, duration,
+                   (uint32_t) ((2ULL * NBYTE * US_PER_SEC) / duration));
+        }
+
         /* Gather Data */
         cycles += 1;
         if (ret >= 0) {
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Connection setup and segment rate of gnrc_tcp over loopback
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef CONNS
+#define CONNS           (4)
+#endif
+
+#ifndef CYCLES
+#define CYCLES          (20)
+#endif
+
+#ifndef NBYTE
+#define NBYTE           (2048)
+#endif
+
+#define BASE_PORT       (2000U)
+#define STACKSIZE       (THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF)
+#define SEGS_PER_CONN   ((NBYTE + GNRC_TCP_MSS - 1) / GNRC_TCP_MSS)
+
+static char _srv_stacks[CONNS][STACKSIZE];
+static char _cli_stacks[CONNS][STACKSIZE];
+static uint8_t _srv_bufs[CONNS][NBYTE];
+static uint8_t _cli_bufs[CONNS][NBYTE];
+static kernel_pid_t _main_pid;
+
+static void *_srv_thread(void *arg)
+{
+    unsigned tid = (unsigned)(uintptr_t)arg;
+    gnrc_tcp_tcb_t tcb;
+
+    while (1) {
+        gnrc_tcp_tcb_init(&tcb);
+        int res = gnrc_tcp_open_passive(&tcb, AF_INET6, NULL, BASE_PORT + tid);
+        if (res < 0) {
+            printf("server %u: open failed: %d\n", tid, res);
+            break;
+        }
+        for (size_t rcvd = 0; rcvd < NBYTE;) {
+            ssize_t n = gnrc_tcp_recv(&tcb, _srv_bufs[tid] + rcvd, NBYTE - rcvd,
+                                      GNRC_TCP_CONNECTION_TIMEOUT_DURATION);
+            if (n < 0) {
+                printf("server %u: recv failed: %d\n", tid, (int)n);
+                break;
+            }
+            rcvd += n;
+        }
+        gnrc_tcp_close(&tcb);
+    }
+    return NULL;
+}
+
+static void *_cli_thread(void *arg)
+{
+    unsigned tid = (unsigned)(uintptr_t)arg;
+    ipv6_addr_t addr = IPV6_ADDR_LOOPBACK;
+    gnrc_tcp_tcb_t tcb;
+    msg_t msg = { .content = { .value = 0 } };
+
+    for (unsigned cycle = 0; cycle < CYCLES;) {
+        int res;
+
+        gnrc_tcp_tcb_init(&tcb);
+        res = gnrc_tcp_open_active(&tcb, AF_INET6, (uint8_t *)&addr,
+                                   BASE_PORT + tid, 0);
+        if (res == -ECONNREFUSED) {
+            /* server did not listen again yet */
+            xtimer_usleep(US_PER_MS);
+            continue;
+        }
+        if (res < 0) {
+            printf("client %u: open failed: %d\n", tid, res);
+            break;
+        }
+        for (size_t sent = 0; sent < NBYTE;) {
+            ssize_t n = gnrc_tcp_send(&tcb, _cli_bufs[tid] + sent, NBYTE - sent, 0);
+            if (n < 0) {
+                printf("client %u: send failed: %d\n", tid, (int)n);
+                break;
+            }
+            sent += n;
+        }
+        gnrc_tcp_close(&tcb);
+        cycle++;
+        msg.content.value++;
+    }
+    msg_send(&msg, _main_pid);
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t start, duration;
+    unsigned conns = 0;
+    msg_t msg;
+
+    printf("CONNS=%u, CYCLES=%u, NBYTE=%u\n", (unsigned)CONNS, (unsigned)CYCLES,
+           (unsigned)NBYTE);
+    _main_pid = thread_getpid();
+    for (unsigned i = 0; i < CONNS; i++) {
+        thread_create(_srv_stacks[i], sizeof(_srv_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _srv_thread, (void *)(uintptr_t)i, "srv");
+    }
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < CONNS; i++) {
+        thread_create(_cli_stacks[i], sizeof(_cli_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _cli_thread, (void *)(uintptr_t)i, "cli");
+    }
+    for (unsigned i = 0; i < CONNS; i++) {
+        msg_receive(&msg);
+        conns += msg.content.value;
+    }
+    duration = xtimer_now_usec() - start;
+
+    printf("%u connections in %" PRIu32 " us\n", conns, duration);
+    printf("%" PRIu32 " connections/s\n",
+           (uint32_t)(((uint64_t)conns * US_PER_SEC) / duration));
+    printf("%" PRIu32 " data segments/s\n",
+           (uint32_t)(((uint64_t)conns * SEGS_PER_CONN * US_PER_SEC) / duration));
+    return 0;
+}
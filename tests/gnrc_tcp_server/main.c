@@ -12,6 +12,7 @@
 #include "net/af.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/tcp.h"
+#include "xtimer.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -67,6 +68,7 @@ void *srv_thread(void *arg)
     uint32_t cycles = 0;
     uint32_t cycles_ok = 0;
     uint32_t failed_payload_verifications = 0;
+    uint32_t start = 0;
 
     /* Transmission control block */
     gnrc_tcp_tcb_t tcb;
@@ -105,6 +107,9 @@ void *srv_thread(void *arg)
                 return 0;
         }
 
+        /* Measure the time needed to exchange data and close the connection */
+        start = xtimer_now_usec();
+
         /* Receive Data, stop if errors were found */
         for (size_t rcvd = 0; rcvd < sizeof(bufs[tid]) && ret >= 0; rcvd += ret) {
             ret = gnrc_tcp_recv(&tcb, (void *) (bufs[tid] + rcvd), sizeof(bufs[tid]) - rcvd,
@@ -191,6 +196,14 @@ void *srv_thread(void *arg)
         /* Close Connection */
         gnrc_tcp_close(&tcb);
 
+        /* Print throughput of this cycle, both directions combined */
+        uint32_t duration = xtimer_now_usec() - start;
+        if (ret >= 0 && duration > 0) {
+            printf("TID=%d : %d bytes exchanged in %"PRIu32" us: %"PRIu32" bytes/s\n",
+                   tid, 2 * NBYTE, duration,
+                   (uint32_t) ((2ULL * NBYTE * US_PER_SEC) / duration));
+        }
+
         /* Gather Data */
         cycles += 1;
         if (ret >= 0) {
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the time inet_csum() takes for IPv6 MTU sized buffers
+ *            at aligned and unaligned addresses
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#define BUF_LEN     (1280U)
+#define RUNS        (1000U)
+
+static uint8_t buf[BUF_LEN + 4] __attribute__((aligned(4)));
+
+static void run_test(unsigned offset)
+{
+    volatile uint16_t sum = 0;
+    uint32_t start, duration;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS; ++i) {
+        sum = inet_csum(sum, buf + offset, BUF_LEN);
+    }
+    duration = xtimer_now_usec() - start;
+
+    printf("+ offset %u: %u x %u bytes in %lu us\n",
+           offset, RUNS, BUF_LEN, (unsigned long)duration);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(buf); ++i) {
+        buf[i] = (uint8_t)((i * 7) ^ 0xa5);
+    }
+
+    puts("Start.");
+
+    for (unsigned offset = 0; offset < 4; ++offset) {
+        run_test(offset);
+    }
+
+    puts("Done.");
+    return 0;
+}
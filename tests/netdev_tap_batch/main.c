@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive throughput measurement for netdev_tap
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "shell.h"
+#include "xtimer.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/netstats.h"
+
+static int _get_stats(kernel_pid_t dev, netstats_t *copy)
+{
+    netstats_t *stats;
+
+    if (gnrc_netapi_get(dev, NETOPT_STATS, 0, &stats, sizeof(&stats)) < 0) {
+        puts("error: unable to get statistics");
+        return -1;
+    }
+    *copy = *stats;
+    return 0;
+}
+
+static int _rxrate(int argc, char **argv)
+{
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    netstats_t start, end;
+    unsigned secs = 10;
+
+    if (argc > 1) {
+        secs = (unsigned)atoi(argv[1]);
+    }
+    if ((secs == 0) || (gnrc_netif_get(ifs) == 0)) {
+        printf("usage: %s [<seconds>]\n", argv[0]);
+        return 1;
+    }
+
+    if (_get_stats(ifs[0], &start) < 0) {
+        return 1;
+    }
+    xtimer_sleep(secs);
+    if (_get_stats(ifs[0], &end) < 0) {
+        return 1;
+    }
+
+    uint32_t frames = end.rx_count - start.rx_count;
+
+    printf("RX frames/s: %u  bytes/s: %u\n",
+           (unsigned)(frames / secs),
+           (unsigned)((end.rx_bytes - start.rx_bytes) / secs));
+    uint32_t batches = end.rx_batch_count - start.rx_batch_count;
+
+    if (batches > 0) {
+        printf("RX frames per interrupt: %u.%02u (largest: %u)\n",
+               (unsigned)(frames / batches),
+               (unsigned)(((frames % batches) * 100) / batches),
+               (unsigned)end.rx_batch_max);
+    }
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "rxrate", "measure receive throughput of the first interface", _rxrate },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    puts("netdev_tap receive throughput test");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares ISR to thread event hand-off via msg_send_int()
+ *              and via spsc_chan
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "msg.h"
+#include "spsc_chan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define RUNTIME_US      (1U * US_PER_SEC)
+#define PERIOD_US       (100U)
+#define BURST           (16U)
+#define QUEUE_SIZE      (32U)
+#define CHAN_FLAG       (0x1)
+
+#define MSG_TYPE_EVENT  (0x0001)
+#define MSG_TYPE_STOP   (0x0002)
+
+enum {
+    MODE_MSG = 0,
+    MODE_CHAN,
+    MODE_CHAN_BATCH,
+};
+
+static const char *_mode_names[] = {
+    "msg_send_int()",
+    "spsc_chan_put()",
+    "spsc_chan_put_many()",
+};
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _msg_queue[QUEUE_SIZE];
+static msg_t _chan_queue[QUEUE_SIZE];
+static spsc_chan_t _chan;
+static kernel_pid_t _consumer_pid;
+static xtimer_t _timer;
+
+static unsigned _mode;
+static volatile bool _running;
+static volatile bool _done;
+static uint32_t _offered, _sent, _isr_time;
+static uint32_t _received;
+
+static void _produce(void *arg)
+{
+    (void)arg;
+    msg_t msgs[BURST];
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < BURST; i++) {
+        msgs[i].type = MSG_TYPE_EVENT;
+        msgs[i].content.value = i;
+    }
+
+    switch (_mode) {
+        case MODE_MSG:
+            for (unsigned i = 0; i < BURST; i++) {
+                if (msg_send_int(&msgs[i], _consumer_pid) == 1) {
+                    _sent++;
+                }
+            }
+            break;
+        case MODE_CHAN:
+            for (unsigned i = 0; i < BURST; i++) {
+                _sent += spsc_chan_put(&_chan, &msgs[i]);
+            }
+            break;
+        case MODE_CHAN_BATCH:
+            _sent += spsc_chan_put_many(&_chan, msgs, BURST);
+            break;
+    }
+
+    _isr_time += xtimer_now_usec() - start;
+    _offered += BURST;
+
+    if (_running) {
+        xtimer_set(&_timer, PERIOD_US);
+    }
+}
+
+static void *_consumer(void *arg)
+{
+    (void)arg;
+    msg_t msgs[BURST];
+    unsigned num;
+
+    if (_mode == MODE_MSG) {
+        msg_init_queue(_msg_queue, QUEUE_SIZE);
+    }
+    else {
+        spsc_chan_init(&_chan, _chan_queue, QUEUE_SIZE, CHAN_FLAG);
+    }
+
+    while (1) {
+        switch (_mode) {
+            case MODE_MSG:
+                msg_receive(&msgs[0]);
+                num = 1;
+                break;
+            case MODE_CHAN:
+                spsc_chan_get(&_chan, &msgs[0]);
+                num = 1;
+                break;
+            default:
+                while ((num = spsc_chan_get_many(&_chan, msgs, BURST)) == 0) {
+                    thread_flags_wait_any(CHAN_FLAG);
+                }
+                break;
+        }
+        for (unsigned i = 0; i < num; i++) {
+            if (msgs[i].type == MSG_TYPE_STOP) {
+                _done = true;
+                return NULL;
+            }
+            _received++;
+        }
+    }
+
+    return NULL;
+}
+
+static void _run(unsigned mode)
+{
+    msg_t stop = { .type = MSG_TYPE_STOP };
+
+    _mode = mode;
+    _offered = 0;
+    _sent = 0;
+    _isr_time = 0;
+    _received = 0;
+    _done = false;
+
+    /* the consumer preempts us and is set up once this returns */
+    _consumer_pid = thread_create(_stack, sizeof(_stack),
+                                  THREAD_PRIORITY_MAIN - 1,
+                                  THREAD_CREATE_STACKTEST,
+                                  _consumer, NULL, "consumer");
+
+    _running = true;
+    _timer.callback = _produce;
+    xtimer_set(&_timer, PERIOD_US);
+    xtimer_usleep(RUNTIME_US);
+    _running = false;
+    xtimer_usleep(PERIOD_US * 2);
+
+    if (mode == MODE_MSG) {
+        msg_send(&stop, _consumer_pid);
+    }
+    else {
+        /* the timer is stopped, so we are the only producer now */
+        while (!spsc_chan_put(&_chan, &stop)) {
+            thread_yield();
+        }
+    }
+    while (!_done) {
+        xtimer_usleep(PERIOD_US);
+    }
+
+    printf("%-22s %8lu events/s delivered, %6lu dropped, "
+           "%5lu ns ISR time per event\n", _mode_names[mode],
+           (unsigned long)(((uint64_t)_received * US_PER_SEC) / RUNTIME_US),
+           (unsigned long)(_offered - _sent),
+           (unsigned long)(((uint64_t)_isr_time * 1000) / _offered));
+}
+
+int main(void)
+{
+    printf("Posting %u events every %u us from ISR for %u us\n",
+           BURST, PERIOD_US, RUNTIME_US);
+
+    _run(MODE_MSG);
+    _run(MODE_CHAN);
+    _run(MODE_CHAN_BATCH);
+
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit.h"
+
+#include "spsc_chan.h"
+
+#include "tests-core.h"
+
+#define TEST_CHAN_SIZE  (4U)
+#define TEST_CHAN_FLAG  (0x1)
+
+static msg_t queue[TEST_CHAN_SIZE];
+static spsc_chan_t chan;
+
+static void set_up(void)
+{
+    spsc_chan_init(&chan, queue, TEST_CHAN_SIZE, TEST_CHAN_FLAG);
+    thread_flags_clear(TEST_CHAN_FLAG);
+}
+
+static void tear_down(void)
+{
+    thread_flags_clear(TEST_CHAN_FLAG);
+}
+
+static void test_spsc_chan_put_get(void)
+{
+    msg_t msg = { .type = 0x1234, .content = { .value = 42 } };
+    msg_t res;
+
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_try_get(&chan, &res));
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_put(&chan, &msg));
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_avail(&chan));
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_try_get(&chan, &res));
+    TEST_ASSERT_EQUAL_INT(0x1234, res.type);
+    TEST_ASSERT_EQUAL_INT(42, res.content.value);
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_avail(&chan));
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_try_get(&chan, &res));
+}
+
+static void test_spsc_chan_put_full(void)
+{
+    msg_t msg = { .type = 0 };
+
+    for (unsigned i = 0; i < TEST_CHAN_SIZE; i++) {
+        msg.content.value = i;
+        TEST_ASSERT_EQUAL_INT(1, spsc_chan_put(&chan, &msg));
+    }
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_put(&chan, &msg));
+    TEST_ASSERT_EQUAL_INT(TEST_CHAN_SIZE, spsc_chan_avail(&chan));
+
+    /* order is kept and the freed slot can be reused */
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_try_get(&chan, &msg));
+    TEST_ASSERT_EQUAL_INT(0, msg.content.value);
+    msg.content.value = TEST_CHAN_SIZE;
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_put(&chan, &msg));
+    for (unsigned i = 1; i <= TEST_CHAN_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, spsc_chan_try_get(&chan, &msg));
+        TEST_ASSERT_EQUAL_INT(i, msg.content.value);
+    }
+}
+
+static void test_spsc_chan_put_get_many(void)
+{
+    msg_t msgs[TEST_CHAN_SIZE + 2];
+    msg_t res[TEST_CHAN_SIZE + 2];
+
+    for (unsigned i = 0; i < (TEST_CHAN_SIZE + 2); i++) {
+        msgs[i].content.value = i;
+    }
+    /* wrap around the end of the queue */
+    TEST_ASSERT_EQUAL_INT(3, spsc_chan_put_many(&chan, msgs, 3));
+    TEST_ASSERT_EQUAL_INT(3, spsc_chan_get_many(&chan, res, 3));
+    TEST_ASSERT_EQUAL_INT(TEST_CHAN_SIZE,
+                          spsc_chan_put_many(&chan, msgs, TEST_CHAN_SIZE + 2));
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_put_many(&chan, msgs, 1));
+    TEST_ASSERT_EQUAL_INT(TEST_CHAN_SIZE,
+                          spsc_chan_get_many(&chan, res, TEST_CHAN_SIZE + 2));
+    for (unsigned i = 0; i < TEST_CHAN_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i, res[i].content.value);
+    }
+    TEST_ASSERT_EQUAL_INT(0, spsc_chan_get_many(&chan, res, 1));
+}
+
+static void test_spsc_chan_wakeup(void)
+{
+    msg_t msgs[2] = { { .type = 0 } };
+
+    /* putting into a drained channel wakes up the reader once */
+    TEST_ASSERT_EQUAL_INT(2, spsc_chan_put_many(&chan, msgs, 2));
+    TEST_ASSERT_EQUAL_INT(TEST_CHAN_FLAG, thread_flags_clear(TEST_CHAN_FLAG));
+
+    /* the reader has not caught up yet, so no need to wake it up */
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_put(&chan, msgs));
+    TEST_ASSERT_EQUAL_INT(0, thread_flags_clear(TEST_CHAN_FLAG));
+
+    TEST_ASSERT_EQUAL_INT(3, spsc_chan_get_many(&chan, msgs, 2) +
+                             spsc_chan_get_many(&chan, msgs, 2));
+    TEST_ASSERT_EQUAL_INT(1, spsc_chan_put(&chan, msgs));
+    TEST_ASSERT_EQUAL_INT(TEST_CHAN_FLAG, thread_flags_clear(TEST_CHAN_FLAG));
+}
+
+Test *tests_core_spsc_chan_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spsc_chan_put_get),
+        new_TestFixture(test_spsc_chan_put_full),
+        new_TestFixture(test_spsc_chan_put_get_many),
+        new_TestFixture(test_spsc_chan_wakeup),
+    };
+
+    EMB_UNIT_TESTCALLER(core_spsc_chan_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&core_spsc_chan_tests;
+}
@@ -20,6 +20,7 @@
 #include "universal_address.h"
 
 #define TEST_FIB_TABLE_SIZE (20)
+#define TEST_FIB_HOSTS_PER_PREFIX (8)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
@@ -978,6 +979,171 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief helper to add a prefix entry whose prefix length is derived from the
+* trailing `0` bits of the given destination
+*/
+static int _add_prefix(char *addr_dst, size_t addr_size, uint8_t nxt)
+{
+    char addr_nxt[addr_size];
+
+    memset(addr_nxt, nxt, addr_size);
+    uint32_t prefix_len = _get_prefix_bits_num(addr_dst, addr_size);
+    return fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst, addr_size,
+                         ((prefix_len << FIB_FLAG_NET_PREFIX_SHIFT) | 0x123),
+                         (uint8_t *)addr_nxt, addr_size, 0x23, 100000);
+}
+
+/*
+* @brief helper to get the first byte of the next-hop for the given address
+*/
+static int _lookup_prefix(char *addr_lookup, size_t addr_size)
+{
+    char addr_nxt[addr_size];
+    size_t nxt_size = addr_size;
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    int ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                               (uint8_t *)addr_nxt, &nxt_size, &next_hop_flags,
+                               (uint8_t *)addr_lookup, addr_size, 0x123);
+    return (ret == 0) ? addr_nxt[0] : ret;
+}
+
+/*
+* @brief testing the longest prefix match with nested prefixes while
+* entries are removed and added again
+*/
+static void test_fib_21_nested_prefixes(void)
+{
+    enum { addr_buf_size = 16 };
+    char addr[addr_buf_size];
+    char addr_lookup[addr_buf_size];
+
+    memset(addr_lookup, 0, addr_buf_size);
+    addr_lookup[0] = 0x20;
+    addr_lookup[1] = 0x01;
+    addr_lookup[2] = 0x0d;
+    addr_lookup[3] = (char)0xb8;
+    addr_lookup[15] = 0x01;
+
+    /* ::/0, 2000::/8, 2001:db8::/32 and the host address itself */
+    memset(addr, 0, addr_buf_size);
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 1));
+    addr[0] = 0x20;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 2));
+    memcpy(addr, addr_lookup, 4);
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 3));
+    memcpy(addr, addr_lookup, addr_buf_size);
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 4));
+    /* a diverging sibling 2001:db9::/32 */
+    memset(addr, 0, addr_buf_size);
+    memcpy(addr, addr_lookup, 4);
+    addr[3] = (char)0xb9;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 5));
+
+    TEST_ASSERT_EQUAL_INT(4, _lookup_prefix(addr_lookup, addr_buf_size));
+    addr_lookup[15] = 0x02;
+    TEST_ASSERT_EQUAL_INT(3, _lookup_prefix(addr_lookup, addr_buf_size));
+    addr_lookup[3] = (char)0xb9;
+    TEST_ASSERT_EQUAL_INT(5, _lookup_prefix(addr_lookup, addr_buf_size));
+    addr_lookup[1] = (char)0xff;
+    TEST_ASSERT_EQUAL_INT(2, _lookup_prefix(addr_lookup, addr_buf_size));
+    addr_lookup[0] = 0x40;
+    TEST_ASSERT_EQUAL_INT(1, _lookup_prefix(addr_lookup, addr_buf_size));
+
+    /* remove 2001:db8::/32 so the lookup falls back to 2000::/8 */
+    memset(addr, 0, addr_buf_size);
+    memcpy(addr, "\x20\x01\x0d\xb8", 4);
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr, addr_buf_size);
+    memcpy(addr_lookup, addr, addr_buf_size);
+    TEST_ASSERT_EQUAL_INT(2, _lookup_prefix(addr_lookup, addr_buf_size));
+
+    /* remove ::/0 and 2000::/8, only the host and 2001:db9::/32 remain */
+    memset(addr, 0, addr_buf_size);
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr, addr_buf_size);
+    addr[0] = 0x20;
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr, addr_buf_size);
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _lookup_prefix(addr_lookup, addr_buf_size));
+    addr_lookup[15] = 0x01;
+    TEST_ASSERT_EQUAL_INT(4, _lookup_prefix(addr_lookup, addr_buf_size));
+    TEST_ASSERT_EQUAL_INT(2, fib_get_num_used_entries(&test_fib_table));
+
+    /* add 2001:db8::/32 again */
+    memset(addr, 0, addr_buf_size);
+    memcpy(addr, addr_lookup, 4);
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, 6));
+    addr_lookup[15] = 0x02;
+    TEST_ASSERT_EQUAL_INT(6, _lookup_prefix(addr_lookup, addr_buf_size));
+
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing lookups of several hosts in each prefix of a full table
+*/
+static void test_fib_22_lookup_full_table(void)
+{
+    enum { addr_buf_size = 16 };
+    char addr[addr_buf_size];
+
+    /* fill the table with /64 prefixes differing in the 4th byte */
+    for (size_t i = 0; i < TEST_FIB_TABLE_SIZE; ++i) {
+        memset(addr, 0, addr_buf_size);
+        addr[0] = 0x20;
+        addr[3] = i + 1;
+        addr[7] = 0x01;
+        TEST_ASSERT_EQUAL_INT(0, _add_prefix(addr, addr_buf_size, i + 1));
+    }
+
+    for (unsigned n = 0; n < (TEST_FIB_TABLE_SIZE * TEST_FIB_HOSTS_PER_PREFIX); ++n) {
+        size_t i = n % TEST_FIB_TABLE_SIZE;
+        memset(addr, 0, addr_buf_size);
+        addr[0] = 0x20;
+        addr[3] = i + 1;
+        addr[7] = 0x01;
+        addr[15] = n;
+        TEST_ASSERT_EQUAL_INT(i + 1, _lookup_prefix(addr, addr_buf_size));
+    }
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing that refreshing an entry is told apart from changing it
+*/
+static void test_fib_23_refresh_entry(void)
+{
+    kernel_pid_t iface_id = 1;
+    char addr_dst[] = "Test address231";
+    char addr_nxt[] = "Test address232";
+    char addr_nxt2[] = "Test address233";
+    size_t add_buf_size = 16;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, iface_id,
+                                           (uint8_t *)addr_dst, add_buf_size - 1, 0,
+                                           (uint8_t *)addr_nxt, add_buf_size - 1, 0,
+                                           10000));
+    /* same next hop */
+    TEST_ASSERT_EQUAL_INT(1, fib_add_entry(&test_fib_table, iface_id,
+                                           (uint8_t *)addr_dst, add_buf_size - 1, 0,
+                                           (uint8_t *)addr_nxt, add_buf_size - 1, 0,
+                                           10000));
+    TEST_ASSERT_EQUAL_INT(1, fib_update_entry(&test_fib_table,
+                                              (uint8_t *)addr_dst, add_buf_size - 1,
+                                              (uint8_t *)addr_nxt, add_buf_size - 1, 0,
+                                              10000));
+    /* new next hop */
+    TEST_ASSERT_EQUAL_INT(0, fib_update_entry(&test_fib_table,
+                                              (uint8_t *)addr_dst, add_buf_size - 1,
+                                              (uint8_t *)addr_nxt2, add_buf_size - 1, 0,
+                                              10000));
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, iface_id,
+                                           (uint8_t *)addr_dst, add_buf_size - 1, 0,
+                                           (uint8_t *)addr_nxt, add_buf_size - 1, 0,
+                                           10000));
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1002,6 +1168,9 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_nested_prefixes),
+                        new_TestFixture(test_fib_22_lookup_full_table),
+                        new_TestFixture(test_fib_23_refresh_entry),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "tests-gnrc_ipv6_flowcache.h"
+
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+#include "net/fib.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/flowcache.h"
+
+#define TEST_FIB_TABLE_SIZE (4)
+#define TEST_IFACE          (5)
+#define TEST_LIFETIME       (100000)    /* in ms */
+#define TEST_PREFIX_LEN     (64U)
+
+#define TEST_DST1           { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+#define TEST_DST2           { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x02, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+#define TEST_NEXT_HOP       { { \
+            0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 \
+        } \
+    }
+
+static const uint8_t _l2addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+
+static void set_up(void)
+{
+    gnrc_ipv6_fib_table.data.entries = _entries;
+    gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
+    gnrc_ipv6_fib_table.size = TEST_FIB_TABLE_SIZE;
+    fib_init(&gnrc_ipv6_fib_table);
+    gnrc_ipv6_flowcache_flush();
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_flowcache_flush();
+    fib_deinit(&gnrc_ipv6_fib_table);
+}
+
+/* adds a route to the /64 prefix of dst */
+static void _add_route(ipv6_addr_t *dst)
+{
+    ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+    ipv6_addr_t next_hop = TEST_NEXT_HOP;
+
+    ipv6_addr_init_prefix(&prefix, dst, TEST_PREFIX_LEN);
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&gnrc_ipv6_fib_table, TEST_IFACE,
+                                           prefix.u8, sizeof(ipv6_addr_t),
+                                           (TEST_PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT),
+                                           next_hop.u8, sizeof(ipv6_addr_t), 0,
+                                           TEST_LIFETIME));
+}
+
+/* does the FIB lookup the IPv6 router does for packets not in the flow cache
+ * and adds the result to the cache */
+static void _forward_uncached(ipv6_addr_t *dst)
+{
+    ipv6_addr_t next_hop;
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+    kernel_pid_t iface;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&gnrc_ipv6_fib_table, &iface,
+                                              next_hop.u8, &next_hop_size,
+                                              &next_hop_flags, dst->u8,
+                                              sizeof(ipv6_addr_t), 0));
+    TEST_ASSERT_EQUAL_INT(TEST_IFACE, iface);
+    gnrc_ipv6_flowcache_add(dst, iface, _l2addr, sizeof(_l2addr));
+}
+
+static void test_ipv6_flowcache__hit_after_lookup(void)
+{
+    ipv6_addr_t dst1 = TEST_DST1, dst2 = TEST_DST2;
+    gnrc_ipv6_flowcache_t flow;
+
+    _add_route(&dst1);
+    _add_route(&dst2);
+    _forward_uncached(&dst1);
+    TEST_ASSERT(gnrc_ipv6_flowcache_get(&dst1, &flow));
+    TEST_ASSERT_EQUAL_INT(TEST_IFACE, flow.netif_hdr.if_pid);
+    TEST_ASSERT_EQUAL_INT(sizeof(_l2addr), flow.netif_hdr.dst_l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_l2addr, flow.dst_l2addr,
+                                    sizeof(_l2addr)));
+    /* a prefix lookup walks the whole table including its unused entries,
+     * which must not invalidate the flow */
+    _forward_uncached(&dst2);
+    TEST_ASSERT(gnrc_ipv6_flowcache_get(&dst1, &flow));
+    TEST_ASSERT(gnrc_ipv6_flowcache_get(&dst2, &flow));
+}
+
+static void test_ipv6_flowcache__miss_after_fib_change(void)
+{
+    ipv6_addr_t dst1 = TEST_DST1, dst2 = TEST_DST2;
+    gnrc_ipv6_flowcache_t flow;
+
+    _add_route(&dst1);
+    _forward_uncached(&dst1);
+    TEST_ASSERT(gnrc_ipv6_flowcache_get(&dst1, &flow));
+    _add_route(&dst2);
+    TEST_ASSERT(!gnrc_ipv6_flowcache_get(&dst1, &flow));
+    _forward_uncached(&dst1);
+    TEST_ASSERT(gnrc_ipv6_flowcache_get(&dst1, &flow));
+    fib_flush(&gnrc_ipv6_fib_table, TEST_IFACE);
+    TEST_ASSERT(!gnrc_ipv6_flowcache_get(&dst1, &flow));
+}
+
+static void test_ipv6_flowcache__flush(void)
+{
+    ipv6_addr_t dst1 = TEST_DST1;
+    gnrc_ipv6_flowcache_t flow;
+
+    _add_route(&dst1);
+    _forward_uncached(&dst1);
+    gnrc_ipv6_flowcache_flush();
+    TEST_ASSERT(!gnrc_ipv6_flowcache_get(&dst1, &flow));
+}
+
+Test *tests_gnrc_ipv6_flowcache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_flowcache__hit_after_lookup),
+        new_TestFixture(test_ipv6_flowcache__miss_after_fib_change),
+        new_TestFixture(test_ipv6_flowcache__flush),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_flowcache_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_ipv6_flowcache_tests;
+}
+#endif
+
+void tests_gnrc_ipv6_flowcache(void)
+{
+#ifdef MODULE_GNRC_IPV6_FLOWCACHE
+    TESTS_RUN(tests_gnrc_ipv6_flowcache_tests());
+#endif
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -21,6 +22,17 @@
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+#define TEST_INET_CSUM_BUF_LEN      (128U)
+
+static uint8_t _buf[TEST_INET_CSUM_BUF_LEN] __attribute__((aligned(4)));
+
+static void _fill_buf(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)((i * 7) ^ 0xa5);
+    }
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -165,6 +177,52 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* the same data at every alignment must give the same sum */
+    uint16_t expected;
+
+    _fill_buf();
+    expected = inet_csum(0, _buf, 67);
+    for (unsigned off = 1; off < 4; off++) {
+        memmove(_buf + off, _buf + off - 1, 67);
+        TEST_ASSERT_EQUAL_INT(expected, inet_csum(0, _buf + off, 67));
+    }
+}
+
+static void test_inet_csum__slice_unaligned(void)
+{
+    uint16_t sum;
+
+    _fill_buf();
+    /* an odd first slice leaves the second one at an odd address */
+    for (unsigned split = 1; split < 8; split++) {
+        sum = inet_csum_slice(0, _buf, split, 0);
+        sum = inet_csum_slice(sum, _buf + split, 61 - split, split);
+        TEST_ASSERT_EQUAL_INT(inet_csum(0, _buf, 61), sum);
+    }
+}
+
+static void test_inet_csum__update16_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+}
+
+static void test_inet_csum__update(void)
+{
+    uint8_t old[16];
+    uint16_t csum;
+
+    _fill_buf();
+    csum = ~inet_csum(0, _buf, 99);
+    /* e.g. a source address in the pseudo header is rewritten */
+    memcpy(old, _buf + 8, sizeof(old));
+    memset(_buf + 8, 0x42, sizeof(old));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, _buf, 99),
+                          inet_csum_update(csum, old, _buf + 8, sizeof(old)));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +234,10 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__slice_unaligned),
+        new_TestFixture(test_inet_csum__update16_rfc_example),
+        new_TestFixture(test_inet_csum__update),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
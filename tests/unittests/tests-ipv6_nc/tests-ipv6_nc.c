@@ -118,6 +118,45 @@ static void test_ipv6_nc_add__full(void)
                                       sizeof(TEST_STRING4), 0));
 }
 
+static void test_ipv6_nc_add__full_evict_lru_stale(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR, second = DEFAULT_TEST_IPV6_ADDR;
+    gnrc_ipv6_nc_t *entry;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4),
+                                              GNRC_IPV6_NC_STATE_STALE));
+        addr.u16[7].u16++;
+    }
+    second.u16[7].u16++;
+    /* use first entry, so the second one becomes the least recently used */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                                   sizeof(TEST_STRING4), 0)));
+    TEST_ASSERT(entry == gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+}
+
+static void test_ipv6_nc_add__full_no_evict_router(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4),
+                                              GNRC_IPV6_NC_STATE_STALE |
+                                              GNRC_IPV6_NC_IS_ROUTER));
+        addr.u16[7].u16++;
+    }
+
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                      sizeof(TEST_STRING4), 0));
+}
+
 static void test_ipv6_nc_add__success(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -440,6 +479,50 @@ static void test_ipv6_nc_get_l2_addr__reachable(void)
     TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING4), l2_addr_len);
 }
 
+static void test_ipv6_nc_get_by_l2_addr__empty(void)
+{
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get_by_l2_addr(KERNEL_PID_UNDEF, TEST_STRING4,
+                                                 sizeof(TEST_STRING4), NULL));
+}
+
+static void test_ipv6_nc_get_by_l2_addr__two_entries(void)
+{
+    ipv6_addr_t addr1 = DEFAULT_TEST_IPV6_ADDR, addr2 = OTHER_TEST_IPV6_ADDR;
+    gnrc_ipv6_nc_t *entry1, *entry2, *entry;
+
+    TEST_ASSERT_NOT_NULL((entry1 = gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr1, TEST_STRING4,
+                                                    sizeof(TEST_STRING4), 0)));
+    TEST_ASSERT_NOT_NULL((entry2 = gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr2, TEST_STRING4,
+                                                    sizeof(TEST_STRING4), 0)));
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_nc_get_by_l2_addr(DEFAULT_TEST_NETIF, TEST_STRING4,
+                                                              sizeof(TEST_STRING4), NULL)));
+    TEST_ASSERT((entry == entry1) || (entry == entry2));
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_nc_get_by_l2_addr(DEFAULT_TEST_NETIF, TEST_STRING4,
+                                                              sizeof(TEST_STRING4), entry)));
+    TEST_ASSERT((entry == entry1) || (entry == entry2));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get_by_l2_addr(DEFAULT_TEST_NETIF, TEST_STRING4,
+                                                 sizeof(TEST_STRING4), entry));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get_by_l2_addr(OTHER_TEST_NETIF, TEST_STRING4,
+                                                 sizeof(TEST_STRING4), NULL));
+}
+
+static void test_ipv6_nc_get_by_l2_addr__updated(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    gnrc_ipv6_nc_t *entry;
+
+    TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                                   sizeof(TEST_STRING4), 0)));
+    gnrc_ipv6_nc_set_l2_addr(entry, TEST_STRING8, GNRC_IPV6_NC_L2_ADDR_MAX);
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get_by_l2_addr(KERNEL_PID_UNDEF, TEST_STRING4,
+                                                 sizeof(TEST_STRING4), NULL));
+    TEST_ASSERT(entry == gnrc_ipv6_nc_get_by_l2_addr(KERNEL_PID_UNDEF, TEST_STRING8,
+                                                     GNRC_IPV6_NC_L2_ADDR_MAX, NULL));
+    gnrc_ipv6_nc_remove(DEFAULT_TEST_NETIF, &addr);
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get_by_l2_addr(KERNEL_PID_UNDEF, TEST_STRING8,
+                                                 GNRC_IPV6_NC_L2_ADDR_MAX, NULL));
+}
+
 Test *tests_ipv6_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -449,6 +532,8 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+        new_TestFixture(test_ipv6_nc_add__full_evict_lru_stale),
+        new_TestFixture(test_ipv6_nc_add__full_no_evict_router),
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -475,6 +560,9 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_get_l2_addr__NULL_entry),
         new_TestFixture(test_ipv6_nc_get_l2_addr__unreachable),
         new_TestFixture(test_ipv6_nc_get_l2_addr__reachable),
+        new_TestFixture(test_ipv6_nc_get_by_l2_addr__empty),
+        new_TestFixture(test_ipv6_nc_get_by_l2_addr__two_entries),
+        new_TestFixture(test_ipv6_nc_get_by_l2_addr__updated),
     };
 
     EMB_UNIT_TESTCALLER(ipv6_nc_tests, set_up, tear_down, fixtures);
@@ -26,6 +26,20 @@ static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+#define TEST_NETREG_MANY_NUMOF     (64U)
+
+static gnrc_netreg_entry_t many_entries[TEST_NETREG_MANY_NUMOF];
+
+static void _register_many(unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        gnrc_netreg_entry_init_pid(&many_entries[i], TEST_UINT16 + i,
+                                   TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &many_entries[i]));
+    }
+}
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +153,35 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__many_entries(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    _register_many(TEST_NETREG_MANY_NUMOF);
+    /* a second subscriber for the first context */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+
+    for (unsigned i = 0; i < TEST_NETREG_MANY_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                       TEST_UINT16 + i)));
+        TEST_ASSERT_EQUAL_INT(TEST_UINT16 + i, res->demux_ctx);
+        TEST_ASSERT_EQUAL_INT((i == 0) ? 2 : 1,
+                              gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                        TEST_UINT16 + TEST_NETREG_MANY_NUMOF));
+
+    /* both subscribers are delivered to and no other entry */
+    res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT16, res->demux_ctx);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many_entries[1]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + 1));
+    TEST_ASSERT_NOT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + 2));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +198,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__many_entries),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -25,6 +25,10 @@
 #include "unittests-constants.h"
 #include "tests-pktbuf.h"
 
+#define TEST_PKTBUF_STRESS_SLOTS    (16)
+#define TEST_PKTBUF_STRESS_ROUNDS   (2048)
+#define TEST_PKTBUF_STRESS_REASS    (1280)
+
 typedef struct __attribute__((packed)) {
     uint8_t u8;
     uint16_t u16;
@@ -243,6 +247,7 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
+#ifdef MODULE_GNRC_PKTBUF_STATIC
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -261,6 +266,7 @@ static void test_pktbuf_add__unaligned_in_aligned_hole(void)
     gnrc_pktbuf_release(pkt4);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
+#endif
 
 static void test_pktbuf_add__0_sized_release(void)
 {
@@ -647,6 +653,63 @@ static void test_pktbuf_realloc_data__success3(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_cut_head__size_greater_than_pkt_size(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                                          GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(EINVAL, gnrc_pktbuf_cut_head(pkt, sizeof(TEST_STRING8) + 1));
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING8), pkt->size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_cut_head__in_place(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING64, sizeof(TEST_STRING64),
+                                          GNRC_NETTYPE_TEST);
+    uint8_t *exp_data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    exp_data = ((uint8_t *)pkt->data) + 16;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_cut_head(pkt, 16));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(exp_data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING64) - 16, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64 + 16, pkt->data, pkt->size));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_cut_head__unaligned(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING64, sizeof(TEST_STRING64),
+                                          GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_cut_head(pkt, 3));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING64) - 3, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64 + 3, pkt->data, pkt->size));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_cut_head__all(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                          GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_cut_head(pkt, sizeof(TEST_STRING16)));
+    TEST_ASSERT_NULL(pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_hold__pkt_null(void)
 {
     gnrc_pktbuf_hold(NULL, 1);
@@ -812,6 +875,63 @@ static void test_pktbuf_get_iovec__null(void)
     TEST_ASSERT_EQUAL_INT(0, len);
 }
 
+/* receives a frame of a given length and splits off link layer and
+ * 6LoWPAN headers like the stack does */
+static gnrc_pktsnip_t *_recv_frame(size_t size)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+
+    if ((pkt == NULL) ||
+        (gnrc_pktbuf_mark(pkt, 9, GNRC_NETTYPE_UNDEF) == NULL) ||
+        (gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_TEST) == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return pkt;
+}
+
+static void test_pktbuf_stress__fragmentation(void)
+{
+    gnrc_pktsnip_t *slots[TEST_PKTBUF_STRESS_SLOTS] = { NULL };
+    uint32_t rnd = TEST_UINT32;
+    unsigned failed = 0;
+
+    /* bursty traffic: frames of varying length are released in random order
+     * while a full-MTU reassembly buffer is requested now and then */
+    for (unsigned i = 0; i < TEST_PKTBUF_STRESS_ROUNDS; i++) {
+        unsigned slot;
+
+        rnd = (rnd * 1103515245) + 12345;
+        slot = (rnd >> 16) % TEST_PKTBUF_STRESS_SLOTS;
+        gnrc_pktbuf_release(slots[slot]);
+        slots[slot] = _recv_frame(24 + ((rnd >> 8) % 104));
+        if (slots[slot] == NULL) {
+            failed++;
+        }
+
+        if ((i % 8) == 0) {
+            gnrc_pktsnip_t *reass = gnrc_pktbuf_add(NULL, NULL,
+                                                    TEST_PKTBUF_STRESS_REASS,
+                                                    GNRC_NETTYPE_UNDEF);
+            if (reass == NULL) {
+                failed++;
+            }
+            gnrc_pktbuf_release(reass);
+        }
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < TEST_PKTBUF_STRESS_SLOTS; i++) {
+        gnrc_pktbuf_release(slots[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    /* the frames never take more than a third of the buffer, so neither
+     * they nor the reassembly buffers may fail */
+    TEST_ASSERT_EQUAL_INT(0, failed);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+#endif
+}
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -826,7 +946,10 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__memfull),
         new_TestFixture(test_pktbuf_add__success),
         new_TestFixture(test_pktbuf_add__packed_struct),
+#ifdef MODULE_GNRC_PKTBUF_STATIC
+        /* checks the hole handling of the first-fit implementation */
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
+#endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_not_0),
@@ -846,6 +969,10 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_realloc_data__success),
         new_TestFixture(test_pktbuf_realloc_data__success2),
         new_TestFixture(test_pktbuf_realloc_data__success3),
+        new_TestFixture(test_pktbuf_cut_head__size_greater_than_pkt_size),
+        new_TestFixture(test_pktbuf_cut_head__in_place),
+        new_TestFixture(test_pktbuf_cut_head__unaligned),
+        new_TestFixture(test_pktbuf_cut_head__all),
         new_TestFixture(test_pktbuf_hold__pkt_null),
         new_TestFixture(test_pktbuf_hold__pkt_external),
         new_TestFixture(test_pktbuf_hold__success),
@@ -858,6 +985,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
+        new_TestFixture(test_pktbuf_stress__fragmentation),
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "universal_address.h"
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+#include "hashes.h"
+#endif
+
+#include "unittests-constants.h"
+#include "tests-universal_address.h"
+
+#define TEST_UA_ADDR_SIZE   (16U)
+#define TEST_UA_COLLIDING   (3U)
+
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+/* the default number of slots of the hash index */
+#define TEST_UA_HASH_SIZE   (2 * UNIVERSAL_ADDRESS_MAX_ENTRIES)
+#endif
+
+static uint8_t colliding[TEST_UA_COLLIDING][TEST_UA_ADDR_SIZE];
+
+/* 2001:db8::<n>, addresses that only differ in their last bytes */
+static void _make_addr(uint8_t *addr, unsigned n)
+{
+    memset(addr, 0, TEST_UA_ADDR_SIZE);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[14] = (uint8_t)(n >> 8);
+    addr[15] = (uint8_t)n;
+}
+
+/* finds addresses with the same home slot in the hash index */
+static void _make_colliding(void)
+{
+    unsigned found = 0;
+
+    for (unsigned n = 0; found < TEST_UA_COLLIDING; n++) {
+        _make_addr(colliding[found], n);
+#ifdef MODULE_UNIVERSAL_ADDRESS_HASH
+        if ((found > 0) &&
+            ((one_at_a_time_hash(colliding[found], TEST_UA_ADDR_SIZE) % TEST_UA_HASH_SIZE) !=
+             (one_at_a_time_hash(colliding[0], TEST_UA_ADDR_SIZE) % TEST_UA_HASH_SIZE))) {
+            continue;
+        }
+#endif
+        found++;
+    }
+}
+
+static void set_up(void)
+{
+    universal_address_init();
+    universal_address_reset();
+}
+
+static void test_universal_address_add__same_container(void)
+{
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    universal_address_container_t *entry;
+
+    _make_addr(addr, TEST_UINT8);
+    TEST_ASSERT_NOT_NULL((entry = universal_address_add(addr, sizeof(addr))));
+    TEST_ASSERT_EQUAL_INT(1, entry->use_count);
+    TEST_ASSERT(entry == universal_address_add(addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(2, entry->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__distinct_size(void)
+{
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    universal_address_container_t *entry;
+
+    _make_addr(addr, TEST_UINT8);
+    TEST_ASSERT_NOT_NULL((entry = universal_address_add(addr, sizeof(addr))));
+    TEST_ASSERT(entry != universal_address_add(addr, sizeof(addr) / 2));
+    TEST_ASSERT_EQUAL_INT(2, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__full(void)
+{
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    universal_address_container_t *first;
+
+    _make_addr(addr, 0);
+    TEST_ASSERT_NOT_NULL((first = universal_address_add(addr, sizeof(addr))));
+    for (unsigned i = 1; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; i++) {
+        _make_addr(addr, i);
+        TEST_ASSERT_NOT_NULL(universal_address_add(addr, sizeof(addr)));
+    }
+    _make_addr(addr, UNIVERSAL_ADDRESS_MAX_ENTRIES);
+    TEST_ASSERT_NULL(universal_address_add(addr, sizeof(addr)));
+
+    /* the released container takes the new address */
+    universal_address_rem(first);
+    TEST_ASSERT(first == universal_address_add(addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MAX_ENTRIES,
+                          universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_rem__refcount(void)
+{
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    universal_address_container_t *entry;
+
+    _make_addr(addr, TEST_UINT8);
+    TEST_ASSERT_NOT_NULL((entry = universal_address_add(addr, sizeof(addr))));
+    TEST_ASSERT(entry == universal_address_add(addr, sizeof(addr)));
+    universal_address_rem(entry);
+    TEST_ASSERT_EQUAL_INT(1, entry->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+
+    /* still in use, so a new address gets another container */
+    _make_addr(addr, TEST_UINT8 + 1);
+    TEST_ASSERT(entry != universal_address_add(addr, sizeof(addr)));
+
+    universal_address_rem(entry);
+    TEST_ASSERT_EQUAL_INT(0, entry->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+    /* an extra release is ignored */
+    universal_address_rem(entry);
+    TEST_ASSERT_EQUAL_INT(0, entry->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__released_address(void)
+{
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    universal_address_container_t *entry;
+
+    _make_addr(addr, TEST_UINT8);
+    TEST_ASSERT_NOT_NULL((entry = universal_address_add(addr, sizeof(addr))));
+    universal_address_rem(entry);
+    /* the address is still stored in the unused container */
+    TEST_ASSERT(entry == universal_address_add(addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(1, entry->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__collisions(void)
+{
+    universal_address_container_t *entries[TEST_UA_COLLIDING];
+
+    _make_colliding();
+    for (unsigned i = 0; i < TEST_UA_COLLIDING; i++) {
+        TEST_ASSERT_NOT_NULL((entries[i] = universal_address_add(colliding[i],
+                                                                 TEST_UA_ADDR_SIZE)));
+        for (unsigned j = 0; j < i; j++) {
+            TEST_ASSERT(entries[i] != entries[j]);
+        }
+    }
+    for (unsigned i = 0; i < TEST_UA_COLLIDING; i++) {
+        TEST_ASSERT(entries[i] == universal_address_add(colliding[i], TEST_UA_ADDR_SIZE));
+        TEST_ASSERT_EQUAL_INT(2, entries[i]->use_count);
+    }
+}
+
+static void test_universal_address_add__lookup_after_removal(void)
+{
+    universal_address_container_t *entries[TEST_UA_COLLIDING], *entry;
+    uint8_t addr[TEST_UA_ADDR_SIZE];
+    size_t addr_size = sizeof(addr);
+
+    _make_colliding();
+    for (unsigned i = 0; i < TEST_UA_COLLIDING; i++) {
+        TEST_ASSERT_NOT_NULL((entries[i] = universal_address_add(colliding[i],
+                                                                 TEST_UA_ADDR_SIZE)));
+    }
+    /* fill the table, so the next new address must reuse the container of
+     * the colliding address in the middle once it is released */
+    for (unsigned i = 0; universal_address_get_num_used_entries() < UNIVERSAL_ADDRESS_MAX_ENTRIES;
+         i++) {
+        _make_addr(addr, 0x1000 + i);
+        TEST_ASSERT_NOT_NULL(universal_address_add(addr, sizeof(addr)));
+    }
+    universal_address_rem(entries[1]);
+    _make_addr(addr, 0x2000);
+    TEST_ASSERT((entry = universal_address_add(addr, sizeof(addr))) == entries[1]);
+    TEST_ASSERT_NOT_NULL(universal_address_get_address(entry, addr, &addr_size));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(addr, entry->address, addr_size));
+
+    /* the other colliding addresses are still found in their containers */
+    TEST_ASSERT(entries[0] == universal_address_add(colliding[0], TEST_UA_ADDR_SIZE));
+    TEST_ASSERT(entries[2] == universal_address_add(colliding[2], TEST_UA_ADDR_SIZE));
+    /* the replaced one is gone, and there is no room left for it */
+    TEST_ASSERT_NULL(universal_address_add(colliding[1], TEST_UA_ADDR_SIZE));
+
+    /* once the last one is released too, both can be added again */
+    universal_address_rem(entries[2]);
+    universal_address_rem(entries[2]);
+    TEST_ASSERT(entries[2] == universal_address_add(colliding[1], TEST_UA_ADDR_SIZE));
+    TEST_ASSERT(entries[0] == universal_address_add(colliding[0], TEST_UA_ADDR_SIZE));
+    TEST_ASSERT_NULL(universal_address_add(colliding[2], TEST_UA_ADDR_SIZE));
+}
+
+Test *tests_universal_address_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_universal_address_add__same_container),
+        new_TestFixture(test_universal_address_add__distinct_size),
+        new_TestFixture(test_universal_address_add__full),
+        new_TestFixture(test_universal_address_rem__refcount),
+        new_TestFixture(test_universal_address_add__released_address),
+        new_TestFixture(test_universal_address_add__collisions),
+        new_TestFixture(test_universal_address_add__lookup_after_removal),
+    };
+
+    EMB_UNIT_TESTCALLER(universal_address_tests, set_up, NULL, fixtures);
+
+    return (Test *)&universal_address_tests;
+}
+
+void tests_universal_address(void)
+{
+    TESTS_RUN(tests_universal_address_tests());
+}
+/** @} */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure insert and lookup rates of the universal address
+ *            containers for different numbers of stored addresses
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "universal_address.h"
+#include "xtimer.h"
+
+#define ADDR_SIZE   (16U)
+#define LOOKUPS     (4096U)
+
+static const unsigned fill_levels[] = { 64, 256, 1024 };
+
+static void _make_addr(uint8_t *addr, unsigned n)
+{
+    /* 2001:db8::<n>, the typical case of addresses sharing a long prefix */
+    memset(addr, 0, ADDR_SIZE);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    addr[14] = (uint8_t)(n >> 8);
+    addr[15] = (uint8_t)n;
+}
+
+static int run_test(unsigned num)
+{
+    uint8_t addr[ADDR_SIZE];
+    uint32_t start, insert, lookup;
+
+    universal_address_init();
+    universal_address_reset();
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < num; ++i) {
+        _make_addr(addr, i);
+        if (universal_address_add(addr, ADDR_SIZE) == NULL) {
+            printf("error: cannot add address %u\n", i);
+            return 1;
+        }
+    }
+    insert = xtimer_now_usec() - start;
+
+    /* adding a known address only increments its use count, so this measures
+     * the lookup of the containers */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < LOOKUPS; ++i) {
+        _make_addr(addr, (i * 7) % num);
+        universal_address_container_t *entry = universal_address_add(addr, ADDR_SIZE);
+        if (entry == NULL) {
+            printf("error: cannot find address %u\n", (i * 7) % num);
+            return 1;
+        }
+        universal_address_rem(entry);
+    }
+    lookup = xtimer_now_usec() - start;
+
+    printf("+ %4u entries: %u inserts in %lu us, %u lookups in %lu us\n",
+           num, num, (unsigned long)insert, LOOKUPS, (unsigned long)lookup);
+    return 0;
+}
+
+int main(void)
+{
+    puts("Start.");
+
+    for (unsigned i = 0; i < sizeof(fill_levels) / sizeof(fill_levels[0]); ++i) {
+        if (run_test(fill_levels[i]) != 0) {
+            return 1;
+        }
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Counts xtimer wakeups of independent periodic tasks with and
+ *              without slack
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define RUNTIME_US      (5U * US_PER_SEC)
+#define SLACK_US        (20U * US_PER_MS)
+/* callbacks closer together than this were run from the same wakeup */
+#define SAME_WAKEUP_US  (200U)
+
+typedef struct {
+    xtimer_t timer;
+    uint32_t period;
+} task_t;
+
+/* periods of unrelated tasks, e.g. sensor sampling and protocol timers */
+static task_t _tasks[] = {
+    { .period = 100U * US_PER_MS },
+    { .period = 130U * US_PER_MS },
+    { .period = 170U * US_PER_MS },
+    { .period = 250U * US_PER_MS },
+    { .period = 330U * US_PER_MS },
+};
+
+#define TASK_NUMOF      (sizeof(_tasks) / sizeof(_tasks[0]))
+
+static uint32_t _slack;
+static volatile uint32_t _callbacks;
+static volatile uint32_t _wakeups;
+static uint32_t _last_callback;
+
+static void _cb(void *arg)
+{
+    task_t *task = arg;
+    uint32_t now = xtimer_now_usec();
+
+    if ((_callbacks == 0) || ((now - _last_callback) > SAME_WAKEUP_US)) {
+        _wakeups++;
+    }
+    _last_callback = now;
+    _callbacks++;
+
+    xtimer_set_slack(&task->timer, task->period, _slack);
+}
+
+static void _run(uint32_t slack)
+{
+    _slack = slack;
+    _callbacks = 0;
+    _wakeups = 0;
+
+    for (unsigned i = 0; i < TASK_NUMOF; i++) {
+        _tasks[i].timer.callback = _cb;
+        _tasks[i].timer.arg = &_tasks[i];
+        xtimer_set_slack(&_tasks[i].timer, _tasks[i].period, _slack);
+    }
+
+    xtimer_usleep(RUNTIME_US);
+
+    for (unsigned i = 0; i < TASK_NUMOF; i++) {
+        xtimer_remove(&_tasks[i].timer);
+    }
+
+    printf("slack %6lu us: %4lu callbacks/s, %4lu wakeups/s\n",
+           (unsigned long)slack,
+           (unsigned long)(_callbacks / (RUNTIME_US / US_PER_SEC)),
+           (unsigned long)(_wakeups / (RUNTIME_US / US_PER_SEC)));
+}
+
+int main(void)
+{
+    puts("xtimer slack test application");
+
+    _run(0);
+    _run(SLACK_US);
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Checks that timers spread over all wheels of xtimer_wheel
+ *              fire in order, can be removed while pending and can be set
+ *              from within timer callbacks
+ *
+ * Build with XTIMER_WHEEL=0 to run the same checks against the sorted list
+ * backend.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+
+#define TIMERS_NUMOF    (8U)
+#define LOG_SIZE        (2 * TIMERS_NUMOF)
+/* timers may be late by the interrupt latency, but never by a wheel slot
+ * or more */
+#define LATENESS_MAX    (10U * US_PER_MS)
+
+#define CALL(fn)            puts("Calling " # fn); fn
+
+typedef struct {
+    unsigned timer;
+    uint64_t target;
+    uint64_t fired_at;
+} _event_t;
+
+static xtimer_t _timers[TIMERS_NUMOF];
+static uint64_t _targets[TIMERS_NUMOF];
+static uint64_t _fired_at[TIMERS_NUMOF];
+static _event_t _log[LOG_SIZE];
+static volatile unsigned _fired;
+static unsigned _expected;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+/* offsets in increasing order land in increasingly outer wheels, the
+ * timers at 1.5 s and more have to cascade through several wheels */
+static const uint32_t _level_offsets[TIMERS_NUMOF] = {
+    3 * US_PER_SEC, 500, 40 * US_PER_MS, 12 * US_PER_SEC,
+    400 * US_PER_MS, 5 * US_PER_MS, 1500 * US_PER_MS, 70 * US_PER_MS,
+};
+
+/* the odd entries are removed, all of them would fire before the last of
+ * the even ones */
+static const uint32_t _remove_offsets[TIMERS_NUMOF] = {
+    4 * US_PER_SEC, 1 * US_PER_SEC, 40 * US_PER_MS, 3 * US_PER_SEC,
+    300 * US_PER_MS, 5 * US_PER_MS, 2 * US_PER_SEC, 20 * US_PER_MS,
+};
+
+static const uint32_t _chain_offsets[] = {
+    2 * US_PER_MS, 300 * US_PER_MS, 20 * US_PER_MS, 1100 * US_PER_MS,
+    1 * US_PER_MS, 50 * US_PER_MS,
+};
+static unsigned _chain_pos;
+
+static void _cb(void *arg)
+{
+    unsigned i = (unsigned)(uintptr_t)arg;
+    uint64_t now = xtimer_now_usec64();
+
+    _fired_at[i] = now;
+    if (_fired < LOG_SIZE) {
+        _log[_fired].timer = i;
+        _log[_fired].target = _targets[i];
+        _log[_fired].fired_at = now;
+    }
+    if (++_fired == _expected) {
+        mutex_unlock(&_done);
+    }
+}
+
+static void _remove_cb(void *arg)
+{
+    /* by now, both timers cascaded to the inner wheels */
+    xtimer_remove(&_timers[1]);
+    xtimer_remove(&_timers[4]);
+    _cb(arg);
+}
+
+static void _chain_cb(void *arg)
+{
+    _cb(arg);
+    if (_chain_pos == 1) {
+        _targets[6] = xtimer_now_usec64() + US_PER_SEC;
+        xtimer_set(&_timers[6], US_PER_SEC);
+    }
+    if (_chain_pos < (sizeof(_chain_offsets) / sizeof(_chain_offsets[0]))) {
+        _targets[0] = xtimer_now_usec64() + _chain_offsets[_chain_pos];
+        xtimer_set(&_timers[0], _chain_offsets[_chain_pos++]);
+    }
+}
+
+static void _setup(unsigned expected)
+{
+    memset(_timers, 0, sizeof(_timers));
+    memset(_fired_at, 0, sizeof(_fired_at));
+    _fired = 0;
+    _expected = expected;
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _timers[i].callback = _cb;
+        _timers[i].arg = (void *)(uintptr_t)i;
+    }
+}
+
+static void _set(unsigned i, uint32_t offset)
+{
+    /* the timer is set a little later, so it never fires before this */
+    _targets[i] = xtimer_now_usec64() + offset;
+    xtimer_set(&_timers[i], offset);
+}
+
+static void _check_log(void)
+{
+    assert(_fired <= LOG_SIZE);
+    for (unsigned k = 0; k < _fired; k++) {
+        assert(_log[k].fired_at >= _log[k].target);
+        assert((_log[k].fired_at - _log[k].target) < LATENESS_MAX);
+        if (k > 0) {
+            assert(_log[k - 1].target <= _log[k].target);
+        }
+    }
+}
+
+static void test_xtimer_wheel__levels(void)
+{
+    _setup(TIMERS_NUMOF);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _set(i, _level_offsets[i]);
+    }
+    mutex_lock(&_done);
+
+    assert(_fired == TIMERS_NUMOF);
+    _check_log();
+}
+
+static void test_xtimer_wheel__remove_pending(void)
+{
+    _setup(TIMERS_NUMOF / 2);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        _set(i, _remove_offsets[i]);
+    }
+    for (unsigned i = 1; i < TIMERS_NUMOF; i += 2) {
+        xtimer_remove(&_timers[i]);
+    }
+    /* removing again is a no-op */
+    xtimer_remove(&_timers[1]);
+    mutex_lock(&_done);
+
+    assert(_fired == TIMERS_NUMOF / 2);
+    _check_log();
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        assert((_fired_at[i] != 0) == !(i & 1));
+    }
+}
+
+static void test_xtimer_wheel__remove_cascaded(void)
+{
+    _setup(3);
+    _timers[3].callback = _remove_cb;
+    _set(0, 1000 * US_PER_MS);
+    _set(1, 1002 * US_PER_MS);
+    _set(2, 1100 * US_PER_MS);
+    _set(3, 995 * US_PER_MS);
+    _set(4, 1090 * US_PER_MS);
+    mutex_lock(&_done);
+
+    assert(_fired == 3);
+    _check_log();
+    assert(_log[0].timer == 3);
+    assert(_log[1].timer == 0);
+    assert(_log[2].timer == 2);
+    assert(_fired_at[1] == 0);
+    assert(_fired_at[4] == 0);
+}
+
+static void test_xtimer_wheel__set_from_callback(void)
+{
+    unsigned chain_len = sizeof(_chain_offsets) / sizeof(_chain_offsets[0]);
+
+    /* the chain, the timer set from its first callback and the one set
+     * here, which is due after the chain */
+    _setup(chain_len + 2);
+    _timers[0].callback = _chain_cb;
+    _chain_pos = 1;
+    _set(0, _chain_offsets[0]);
+    _set(7, 2 * US_PER_SEC);
+    mutex_lock(&_done);
+
+    assert(_fired == chain_len + 2);
+    _check_log();
+    assert(_log[_fired - 1].timer == 7);
+    assert(_fired_at[6] != 0);
+}
+
+int main(void)
+{
+    CALL(test_xtimer_wheel__levels());
+    CALL(test_xtimer_wheel__remove_pending());
+    CALL(test_xtimer_wheel__remove_cascaded());
+    CALL(test_xtimer_wheel__set_from_callback());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
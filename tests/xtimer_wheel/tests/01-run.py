@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 RIOT contributors
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_xtimer_wheel__levels()")
+    child.expect_exact(u"Calling test_xtimer_wheel__remove_pending()", timeout=30)
+    child.expect_exact(u"Calling test_xtimer_wheel__remove_cascaded()", timeout=10)
+    child.expect_exact(u"Calling test_xtimer_wheel__set_from_callback()", timeout=10)
+    child.expect_exact(u"ALL TESTS SUCCESSFUL", timeout=10)
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
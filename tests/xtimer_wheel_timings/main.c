@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2017 RIOT contributors
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures how xtimer_set() and xtimer_remove() scale with the
+ *              number of active timers
+ *
+ * Build with XTIMER_WHEEL=0 to compare against the sorted list backend.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#define TIMERS_MAX      (128U)
+#define ROUNDS          (8U)
+#define OFFSET_MIN      (10U * US_PER_MS)
+#define OFFSET_RANGE    (60U * US_PER_SEC)
+
+static xtimer_t _timers[TIMERS_MAX];
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired during measurement");
+}
+
+static void _measure(unsigned num, uint32_t *set_ticks, uint32_t *remove_ticks)
+{
+    uint32_t offsets[TIMERS_MAX];
+    uint32_t start;
+
+    *set_ticks = 0;
+    *remove_ticks = 0;
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        for (unsigned i = 0; i < num; i++) {
+            offsets[i] = OFFSET_MIN + random_uint32_range(0, OFFSET_RANGE);
+        }
+
+        start = _xtimer_now();
+        for (unsigned i = 0; i < num; i++) {
+            xtimer_set(&_timers[i], offsets[i]);
+        }
+        *set_ticks += _xtimer_now() - start;
+
+        /* remove in an order unrelated to the expiry order, 7 is coprime
+         * to the power of two num so every timer is removed exactly once */
+        start = _xtimer_now();
+        for (unsigned i = 0; i < num; i++) {
+            xtimer_remove(&_timers[(i * 7) % num]);
+        }
+        *remove_ticks += _xtimer_now() - start;
+    }
+}
+
+int main(void)
+{
+#ifdef MODULE_XTIMER_WHEEL
+    puts("xtimer timings, timing wheel backend");
+#else
+    puts("xtimer timings, sorted list backend");
+#endif
+
+    for (unsigned i = 0; i < TIMERS_MAX; i++) {
+        _timers[i].callback = _cb;
+    }
+
+    puts("timers  set [ticks/op]  remove [ticks/op]");
+    for (unsigned num = 1; num <= TIMERS_MAX; num *= 2) {
+        uint32_t set_ticks, remove_ticks;
+
+        _measure(num, &set_ticks, &remove_ticks);
+        printf("%6u  %15lu.%02lu  %15lu.%02lu\n", num,
+               (unsigned long)(set_ticks / (num * ROUNDS)),
+               (unsigned long)((set_ticks * 100 / (num * ROUNDS)) % 100),
+               (unsigned long)(remove_ticks / (num * ROUNDS)),
+               (unsigned long)((remove_ticks * 100 / (num * ROUNDS)) % 100));
+    }
+
+    puts("done");
+
+    return 0;
+}